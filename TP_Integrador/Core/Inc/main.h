@@ -74,6 +74,12 @@ void Error_Handler(void);
 
 /* USER CODE BEGIN Private defines */
 
+//Pines del display cuando se usa SSD1306_TRANSPORT_SPI (SPI2: SCK PB13, MOSI PB15, DMA1 Stream4)
+#define OLED_DC_Pin GPIO_PIN_1
+#define OLED_DC_GPIO_Port GPIOB
+#define OLED_CS_Pin GPIO_PIN_12
+#define OLED_CS_GPIO_Port GPIOB
+
 /* USER CODE END Private defines */
 
 #ifdef __cplusplus
@@ -27,6 +27,13 @@
 #include "../../Drivers/API/Inc/API_debounce.h"
 #include "../../Drivers/API/Inc/SSD1306.h"
 #include "../../Drivers/API/Inc/SSD1306_Port.h"
+#include "../../Drivers/API/Inc/SSD1306_View.h"
+#include "../../Drivers/API/Inc/SSD1306_Refresh.h"
+#include "../../Drivers/API/Inc/SSD1306_Hud.h"
+#include "../../Drivers/API/Inc/API_stack.h"
+#include "../../Drivers/API/Inc/API_cycles.h"
+#include "../../Drivers/API/Inc/API_filter.h"
+#include "../../Drivers/API/Inc/API_stats.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -45,6 +52,22 @@ typedef struct{
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 
+//Frecuencia del bus del display, para estimar su ocupacion en el limitador de refresco
+#if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+#define DISPLAY_BUS_HZ 5250000		//SPI2 en APB1 (42 MHz) con prescaler 8; el SSD1306 admite hasta 10 MHz
+#else
+#define DISPLAY_BUS_HZ (hi2c1.Init.ClockSpeed)
+#endif
+
+//Entrada de la tabla de tiempos de muestreo que selecciona el modo continuo del sensor
+#define MUESTREO_CONTINUO 0
+
+//Valor de display.Sampling que obliga a volver a imprimir el muestreo
+#define MUESTREO_SIN_MOSTRAR UINT32_MAX
+
+//Mediciones que se extraen del sensor por llamada para pasarlas por el filtro
+#define FILTRO_LOTE 8
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -55,17 +78,43 @@ typedef struct{
 /* Private variables ---------------------------------------------------------*/
 
 I2C_HandleTypeDef hi2c1;
+DMA_HandleTypeDef hdma_i2c1_tx;
 
 UART_HandleTypeDef huart4;
 UART_HandleTypeDef huart2;
+DMA_HandleTypeDef hdma_uart4_rx;
 
 /* USER CODE BEGIN PV */
 
+#if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+//Handle generado por CubeMX al habilitar SPI2 (solo transmision, DMA1 Stream4)
+extern SPI_HandleTypeDef hspi2;
+#endif
+
+//Bus I2C del display, display OLED y pantallas que se muestran en el mismo
+static SSD1306_Bus_t displayBus;
+static SSD1306_t oled;
+static SSD1306_View_t pantalla;
+
+//Limitador de refresco: el display se actualiza a lo sumo a SSD1306_REFRESH_DEFAULT_FPS, sin importar el muestreo
+static SSD1306_Refresh_t refresco;
+
+//Pantalla de diagnostico (pulsacion larga) y vueltas del lazo principal que muestra
+static SSD1306_Hud_t diagnostico;
+static uint32_t vueltas;
+
+//Filtro de las distancias: descarta las mediciones con error y suaviza el resto antes de mostrarlas
+static filter_t filtro;
+
+//Estadisticas de las ultimas distancias filtradas (maxima y minima del display y pagina de mediciones del diagnostico)
+static stats_t estadisticas;
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_USART2_UART_Init(void);
 static void MX_I2C1_Init(void);
 static void MX_UART4_Init(void);
@@ -98,7 +147,12 @@ int main(void)
 
 
   //Se definen los tiempos con lo que se puede tomar la medicion de distancia.
-  const uint32_t TIEMPOS[] = {50, 250, 500, 1000};
+  //El quinto modo muestra el grafico de distancia al tiempo de muestreo mas rapido y el
+  //ultimo pide cada medicion apenas llega la anterior (modo continuo).
+  const uint32_t TIEMPOS[] = {50, 250, 500, 1000, 50, MUESTREO_CONTINUO};
+  const SSD1306_Screen_t PANTALLAS[] = {SSD1306_SCREEN_MEASURE, SSD1306_SCREEN_MEASURE,
+                                        SSD1306_SCREEN_MEASURE, SSD1306_SCREEN_MEASURE, SSD1306_SCREEN_CHART,
+                                        SSD1306_SCREEN_MEASURE};
   uint8_t cantTiempos = sizeof(TIEMPOS) / sizeof(TIEMPOS[0]);
 
   //Varible utilizada para recorrer el array de tiempos de muestreo.
@@ -110,11 +164,11 @@ int main(void)
   //variable que contiene la informacion que se muestra en pantalla
   display_t display;
 
-  //Se configuran las variables con valores inciales, para que en la primera medicion se cconfiguren automaticamente.
+  //Se configuran las variables con valores inciales; maxima y minima salen de las estadisticas de las ultimas mediciones.
   display.Max=0;
-  display.Min=0xFFFF;
+  display.Min=0;
   display.New=0;
-  display.Sampling=0;
+  display.Sampling=MUESTREO_SIN_MOSTRAR;
   display.Calib=0xFF;
   display.Firmware=0xFF;
   display.Port=0xFF;
@@ -122,6 +176,9 @@ int main(void)
   //Variable auxiliar para tener nocion de la frecuencia de muestreo
   bool ledState = false;
 
+  //Indica que hay una medicion nueva que todavia no se dibujo en pantalla
+  bool nuevaMedicion = false;
+
   /* USER CODE END Init */
 
   /* Configure the system clock */
@@ -133,20 +190,42 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
   MX_I2C1_Init();
   MX_UART4_Init();
   /* USER CODE BEGIN 2 */
 
-  //Se inicializa el displey SSD1306
-  SSD1306_Init();
-
-  //Se limpia la pantalla
-  SSD1306_Clear();
+  //Se marca la pila libre para medir su uso maximo y se habilita el contador de ciclos
+  //con el que se mide la latencia del sensor
+  stackPaint();
+  cyclesInit();
+
+  //Se inicializa el displey SSD1306 (128x64, direccion 0x3C en el I2C1, o en SPI2 con pines D/C y CS)
+#if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+  SSD1306_Port_BusInit(&displayBus, &hspi2);
+  SSD1306_Port_SetPins(&displayBus, OLED_DC_GPIO_Port, OLED_DC_Pin, OLED_CS_GPIO_Port, OLED_CS_Pin);
+#else
+  SSD1306_Port_BusInit(&displayBus, &hi2c1);
+#endif
+  SSD1306_Init(&oled, &displayBus, SSD1306_ADDRESS, SSD1306_WIDTH, SSD1306_HEIGHT);
+
+  //Se envia de una vez la imagen en flash con las etiquetas de la pantalla (reemplaza al borrado)
+  SSD1306_ViewInit(&pantalla, &oled);
+  SSD1306_RefreshInit(&refresco, &oled, SSD1306_REFRESH_DEFAULT_FPS, SSD1306_REFRESH_DEFAULT_BUDGET, DISPLAY_BUS_HZ);
+  SSD1306_HudInit(&diagnostico, &oled);
 
   //Se incializa el anti rebote del pulsador
   debounceFSM_init();
 
+  //Se inicializa el filtro de las distancias con la configuracion por defecto
+  const filterConfig_t configFiltro = FILTER_CONFIG_DEFAULT;
+  filterInit(&filtro, &configFiltro);
+
+  //Se inicializan las estadisticas de las distancias con la ventana por defecto
+  const statsConfig_t configEstadisticas = STATS_CONFIG_DEFAULT;
+  statsInit(&estadisticas, &configEstadisticas);
+
   //Se incializa el sensor de distancia TFLC02
 
 //  TFLC02_Init();
@@ -166,8 +245,8 @@ int main(void)
   //Se solicita informacion del sensor
   TFLC02_Info();
 
-  //Delay minimo para esperar la respuesta del sensor
-  HAL_Delay(1);
+  //Delay minimo para esperar la respuesta del sensor (el pedido sale por interrupcion)
+  HAL_Delay(2);
 
   //Se procesa la trama recibida si es que se recibio
   if(TFLC02_FramePresent()){
@@ -177,7 +256,7 @@ int main(void)
   //Se solicita parametros por default del sensor
   TFLC02_DefaultSettings();
 
-  HAL_Delay(1);
+  HAL_Delay(2);
 
   if(TFLC02_FramePresent()){
 	TFLC02_Parse_Packet();
@@ -188,24 +267,23 @@ int main(void)
   display.Firmware = TFLC02_GetFirm();
   display.Port = TFLC02_GetPort();
 
-  //Se imprime la informacion inicial y etiquetas en display
-  SSD1306_PrintSetup(display.Port,display.Calib);
+  //Se imprime la informacion inicial sobre las etiquetas del display
+  SSD1306_PrintSetup(&pantalla,display.Port,display.Calib);
+  SSD1306_Flush(&oled);
 
 
   while (1)
   {
+	vueltas++;
+
 	//Se actualiza el estado del pulsador
 	debounceFSM_update();
 
-	//Se revisa el timer
-	if(delayRead(&delayMesure)){
+	//Se revisa el timer (en modo continuo los pedidos no dependen del timer)
+	bool pedido = !TFLC02_FreeRunActive() && delayRead(&delayMesure);
+	if(pedido){
 //		Se solicita la medicion de distancia
 		TFLC02_Mesure();
-
-		//Cambia el estado del led para mostrar al usuario la velocidad de muestreo
-		ledState = !ledState;
-		HAL_GPIO_WritePin(LD2_GPIO_Port, LD2_Pin, ledState ? GPIO_PIN_SET : GPIO_PIN_RESET);
-
 	}
 
 	//Se consulta si existe una trama para pocesar, de ser asi se procesa
@@ -213,31 +291,130 @@ int main(void)
 		TFLC02_Parse_Packet();
 	}
 
-	//Se consulta si existe nueva informacion del sensor
-	if(TFLC02_RspComplete()){
+	//En modo continuo se pide la medicion siguiente en la misma vuelta en que llego la respuesta
+	pedido |= TFLC02_FreeRunUpdate();
 
-		//Se obtiene la medicion obtenida
-		display.New = TFLC02_GetDistance();
-
-		//Se refresca las mediciones maximas y minimas
-		if(display.New > display.Max && (display.New != 0)) display.Max = display.New;
-		if((display.New < display.Min) && (display.New != 0)) display.Min = display.New;
-
-		//Se imprimen las distancias
-		SSD1306_PrintMesurement(display.New,display.Max,display.Min);
+	if(pedido){
+		//Cambia el estado del led para mostrar al usuario la velocidad de muestreo
+		ledState = !ledState;
+		HAL_GPIO_WritePin(LD2_GPIO_Port, LD2_Pin, ledState ? GPIO_PIN_SET : GPIO_PIN_RESET);
+	}
 
+	//Se pasan por el filtro todas las mediciones recibidas desde la vuelta anterior;
+	//las que tienen un codigo de error o estan fuera de rango no llegan al display
+	TFLC02_Sample_t muestras[FILTRO_LOTE];
+	uint16_t cantMuestras;
+	while((cantMuestras = TFLC02_ReadSamples(muestras, FILTRO_LOTE)) > 0){
+		for(uint16_t i = 0; i < cantMuestras; i++){
+			if(!filterUpdate(&filtro, muestras[i].distance, muestras[i].errorCode)) continue;
+
+			//Se obtiene la distancia filtrada y se refrescan la maxima y la minima de la ventana
+			display.New = filterValue(&filtro);
+			statsUpdate(&estadisticas, display.New);
+			display.Max = statsMax(&estadisticas);
+			display.Min = statsMin(&estadisticas);
+
+			//Las distancias se imprimen en el proximo cuadro, con el ultimo valor filtrado;
+			//el grafico dibuja en ese cuadro cada medicion encolada, no solo la ultima
+			//(con la pantalla de diagnostico visible no se encolan)
+			if(!SSD1306_HudVisible(&diagnostico)){
+				SSD1306_PushSample(&pantalla,display.New);
+			}
+			nuevaMedicion = true;
+			SSD1306_RefreshRequest(&refresco);
+		}
 	}
 
 //	Se consulta si el pulsador fue accionado, si es asi se cambia el valor de muestreo
-	if(readPushed()){
+//	(con la pantalla de diagnostico visible se pasa a su pagina siguiente)
+	bool pulsado = readPushed();
+	if(pulsado && SSD1306_HudVisible(&diagnostico)){
+		SSD1306_HudNextPage(&diagnostico);
+		SSD1306_RefreshRequest(&refresco);
+	}else if(pulsado){
 		indiceMesure = (indiceMesure + 1) % cantTiempos;
-		delayWrite(&delayMesure, TIEMPOS[indiceMesure]);
+		if(TIEMPOS[indiceMesure] == MUESTREO_CONTINUO){
+			TFLC02_FreeRunStart();
+		}else{
+			TFLC02_FreeRunStop();
+			delayWrite(&delayMesure, TIEMPOS[indiceMesure]);
+		}
+		display.Sampling = MUESTREO_SIN_MOSTRAR;
+
+		//El Kalman estima la velocidad en mm por medicion: al cambiar el muestreo se reinicia
+		filterReset(&filtro);
+
+		//Al cambiar de pantalla se redibuja todo su contenido
+		if(PANTALLAS[indiceMesure] != SSD1306_GetScreen(&pantalla)){
+			SSD1306_SetScreen(&pantalla,PANTALLAS[indiceMesure]);
+			SSD1306_PrintSetup(&pantalla,display.Port,display.Calib);
+			SSD1306_RefreshRequest(&refresco);
+		}
+	}
+
+	//Con una pulsacion larga se muestra u oculta la pantalla de diagnostico
+	if(readLongPushed()){
+		if(SSD1306_HudVisible(&diagnostico)){
+			SSD1306_HudHide(&diagnostico);
+			SSD1306_ViewRedraw(&pantalla);
+			SSD1306_PrintSetup(&pantalla,display.Port,display.Calib);
+			display.Sampling = MUESTREO_SIN_MOSTRAR;
+			nuevaMedicion = true;
+		}else{
+			SSD1306_HudShow(&diagnostico);
+		}
+		SSD1306_RefreshRequest(&refresco);
+	}
+
+	//Si la duracion del delay (en modo continuo, las muestras por segundo logradas) y la
+	//informacion de muestreo del display son difertentes se actualiza
+	uint32_t muestreo = TFLC02_FreeRunActive() ? TFLC02_FreeRunRate() : delayMesure.duration;
+	if(muestreo != display.Sampling && !SSD1306_HudVisible(&diagnostico)){
+		display.Sampling = muestreo;
+		if(TFLC02_FreeRunActive()){
+			SSD1306_PrintRate(&pantalla,display.Sampling);
+		}else{
+			SSD1306_PrintMuestreo(&pantalla,display.Sampling);
+		}
+		SSD1306_RefreshRequest(&refresco);
 	}
 
-	//Si la duracion del delay y la informacion de muestreo del display son difertentes se actualiza
-	if(delayMesure.duration != display.Sampling){
-		display.Sampling = delayMesure.duration;
-		SSD1306_PrintMuestreo(display.Sampling);
+	//Cuando toca un cuadro se dibujan las ultimas distancias y se envian al display
+	//solo las regiones del framebuffer que cambiaron
+	if(SSD1306_RefreshDue(&refresco)){
+		if(nuevaMedicion && !SSD1306_HudVisible(&diagnostico)){
+			SSD1306_PrintMesurement(&pantalla,display.New,display.Max,display.Min);
+			nuevaMedicion = false;
+		}
+		SSD1306_RefreshFlush(&refresco);
+	}
+
+	//Una vez por segundo se calculan las metricas de funcionamiento (se dibujan solo si estan visibles)
+	if(SSD1306_HudDue(&diagnostico)){
+		TFLC02_Stats_t sensor = TFLC02_GetStats();
+		SSD1306_RefreshStats_t cuadros = SSD1306_RefreshGetStats(&refresco);
+		statsSummary_t distancias = statsGetSummary(&estadisticas);
+		filterStats_t filtradas = filterGetStats(&filtro);
+		SSD1306_HudMetrics_t metricas = {
+			.samples = sensor.measurements,
+			.latencyUs = sensor.latencyUs,
+			.frames = cuadros.framesDrawn,
+			.busBusyPercent = cuadros.busBusyPercent,
+			.loops = vueltas,
+			.invalidFrames = sensor.invalidFrames,
+			.droppedFrames = sensor.droppedRequests,
+			.freeStack = stackFree(),
+			.windowSamples = distancias.count,
+			.meanTenths = distancias.meanTenths,
+			.stddevTenths = distancias.stddevTenths,
+			.minDistance = distancias.min,
+			.maxDistance = distancias.max,
+			.median = distancias.median,
+			.p95 = distancias.p95,
+			.rejectedSamples = filtradas.rejectedError + filtradas.rejectedRange,
+		};
+		SSD1306_HudUpdate(&diagnostico, &metricas);
+		if(SSD1306_HudVisible(&diagnostico)) SSD1306_RefreshRequest(&refresco);
 	}
 
 
@@ -398,6 +575,25 @@ static void MX_USART2_UART_Init(void)
 
 }
 
+/**
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void)
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA1_Stream2_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+  /* DMA1_Stream6_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
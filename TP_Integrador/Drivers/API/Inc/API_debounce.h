@@ -11,6 +11,17 @@
  #include <stdbool.h>
  #include <stdint.h>
  #include "API_delay.h"
+ 
+ /**
+  * @brief Inicializa la máquina de estados de antirebote.
+  */
+ void debounceFSM_init(void);
+ 
+ /**
+  * @brief Actualiza la máquina de estados de antirebote. Debe llamarse periódicamente.
+  */
+ void debounceFSM_update(void);
+ 
  /**
   * @brief Lee el estado actual del pulsador.
   *
@@ -28,11 +39,21 @@
  /**
   * @brief Indica si se ha detectado una nueva pulsación del botón.
   *
-  * Se activa una sola vez por cada nuevo evento de presión.
+  * Se activa una sola vez por cada pulsación corta, al soltar el botón.
   *
   * @return true si se detectó una nueva pulsación, false si no.
   */
  bool_t readPushed();
  
+ /**
+  * @brief Indica si se ha detectado una pulsación larga del botón.
+  *
+  * Se activa una sola vez cuando el botón se mantiene presionado el tiempo de una
+  * pulsación larga, sin esperar a que se suelte; esa pulsación no genera además una corta.
+  *
+  * @return true si se detectó una nueva pulsación larga, false si no.
+  */
+ bool_t readLongPushed();
+ 
  #endif /* API_INC_API_DEBOUNCE_H_ */
  
@@ -0,0 +1,154 @@
+/**
+ * @file API_filter.h
+ *
+ * @brief Cadena de filtros en punto fijo para las mediciones de distancia.
+ *
+ * Cada medición pasa, en orden, por las etapas habilitadas en la configuración:
+ * - compuerta: descarta las mediciones con un código de error del sensor o fuera de rango;
+ * - mediana de las últimas N mediciones, que elimina picos aislados;
+ * - promedio móvil exponencial (EMA) con coeficiente en Q15;
+ * - filtro de Kalman de posición y velocidad constante.
+ *
+ * Todo el estado está en filter_t, que provee el llamador: no se usa memoria
+ * dinámica ni punto flotante. El costo por medición está acotado: la mediana recorre
+ * a lo sumo FILTER_MEDIAN_MAX valores y el Kalman deja de actualizar la covarianza
+ * cuando sus ganancias convergen, que no dependen de las mediciones.
+ */
+
+ #ifndef API_API_FILTER_H_
+ #define API_API_FILTER_H_
+ 
+ #include <stdint.h>
+ #include <stdbool.h>
+ #include <assert.h>
+ 
+ /// @brief Mediciones de la mediana como máximo.
+ #define FILTER_MEDIAN_MAX       7
+ 
+ /// @brief Pasos seguidos con las ganancias estables (a lo sumo un LSB de cambio) tras los cuales el Kalman deja de actualizar la covarianza.
+ #define FILTER_KALMAN_STEADY    16
+ 
+ /// @brief Distancia máxima que admite la aritmética de la cadena [mm] (Q16 en 32 bits).
+ #define FILTER_DISTANCE_MAX     32767
+ 
+ /// @brief 1,0 en Q15: con este coeficiente el EMA queda deshabilitado.
+ #define FILTER_Q15_ONE          32768
+ 
+ /// @brief Convierte una constante a Q15 (se resuelve al compilar).
+ #define FILTER_Q15(x)           ((uint16_t)((x) * 32768.0 + 0.5))
+ 
+ /// @brief Convierte una constante a Q16 (se resuelve al compilar).
+ #define FILTER_Q16(x)           ((uint32_t)((x) * 65536.0 + 0.5))
+ 
+ /**
+  * @brief Configuración de la cadena.
+  */
+ typedef struct {
+     uint8_t errorMask;          /**< Bits del código de error del sensor que descartan la medición (0xFF: cualquier error). */
+     uint16_t minDistance;       /**< Distancia mínima aceptada [mm]; con 1 se descartan las lecturas en 0. */
+     uint16_t maxDistance;       /**< Distancia máxima aceptada [mm] (a lo sumo FILTER_DISTANCE_MAX). */
+     uint8_t medianSize;         /**< Mediciones de la mediana (impar, hasta FILTER_MEDIAN_MAX; 1 la deshabilita). */
+     uint16_t emaAlpha;          /**< Peso de la medición nueva en el EMA, en Q15 (FILTER_Q15_ONE lo deshabilita). */
+     bool kalman;                /**< Habilita el filtro de Kalman. */
+     uint32_t kalmanR;           /**< Varianza del ruido de medición [mm²] en Q16. */
+     uint32_t kalmanQ;           /**< Varianza de la aceleración [(mm/medición²)²] en Q16. */
+ } filterConfig_t;
+ 
+ /// @brief Configuración por defecto: cualquier error o lectura en 0 se descarta, mediana de 5 y Kalman.
+ #define FILTER_CONFIG_DEFAULT   { 0xFF, 1, FILTER_DISTANCE_MAX, 5, FILTER_Q15_ONE, true, FILTER_Q16(25.0), FILTER_Q16(0.05) }
+ 
+ /**
+  * @brief Contadores de la cadena.
+  */
+ typedef struct {
+     uint32_t accepted;          /**< Mediciones que pasaron la compuerta. */
+     uint32_t rejectedError;     /**< Mediciones descartadas por el código de error. */
+     uint32_t rejectedRange;     /**< Mediciones descartadas por estar fuera de rango. */
+ } filterStats_t;
+ 
+ /**
+  * @brief Estado de la cadena.
+  */
+ typedef struct {
+     filterConfig_t config;                      /**< Configuración. */
+     uint16_t window[FILTER_MEDIAN_MAX];         /**< Últimas mediciones en orden de llegada (circular). */
+     uint16_t sorted[FILTER_MEDIAN_MAX];         /**< Las mismas mediciones, ordenadas. */
+     uint8_t windowCount;                        /**< Mediciones en la ventana. */
+     uint8_t windowPos;                          /**< Posición de window donde va la próxima medición. */
+     bool started;                               /**< Ya hubo una medición aceptada (EMA y Kalman inicializados). */
+     int32_t ema;                                /**< Salida del EMA [mm] en Q16. */
+     int32_t position;                           /**< Posición estimada por el Kalman [mm] en Q16. */
+     int32_t velocity;                           /**< Velocidad estimada por el Kalman [mm/medición] en Q16. */
+     int64_t p00;                                /**< Covarianza del Kalman en Q16: varianza de la posición. */
+     int64_t p01;                                /**< Covarianza entre posición y velocidad. */
+     int64_t p11;                                /**< Varianza de la velocidad. */
+     int32_t k0;                                 /**< Ganancia del Kalman para la posición en Q15. */
+     int32_t k1;                                 /**< Ganancia del Kalman para la velocidad en Q15. */
+     uint8_t steady;                             /**< Pasos seguidos en que las ganancias cambiaron a lo sumo un LSB. */
+     bool converged;                             /**< Las ganancias dejaron de cambiar: la covarianza queda fija. */
+     uint16_t value;                             /**< Última salida [mm]. */
+     filterStats_t stats;                        /**< Contadores. */
+ } filter_t;
+ 
+ /**
+  * @brief Inicializa la cadena sin mediciones.
+  *
+  * @param[out] filter Puntero a la cadena.
+  * @param[in] config Configuración (se copia).
+  */
+ void filterInit(filter_t *filter, const filterConfig_t *config);
+ 
+ /**
+  * @brief Descarta las mediciones anteriores (ventana, EMA y Kalman), conservando la configuración y los contadores.
+  *
+  * @param[in,out] filter Puntero a la cadena.
+  * @note Conviene llamarla al cambiar el período de muestreo: la velocidad del Kalman
+  *       está en mm por medición.
+  */
+ void filterReset(filter_t *filter);
+ 
+ /**
+  * @brief Pasa una medición por la cadena.
+  *
+  * @param[in,out] filter Puntero a la cadena.
+  * @param[in] distance Distancia medida [mm].
+  * @param[in] errorCode Código de error del sensor (0: medición válida).
+  * @return true si la medición pasó la compuerta y la salida se actualizó; false si se
+  *         descartó y la salida no cambió.
+  */
+ bool filterUpdate(filter_t *filter, uint16_t distance, uint8_t errorCode);
+ 
+ /**
+  * @brief Devuelve la última salida de la cadena [mm] (0 antes de la primera medición aceptada).
+  *
+  * @param[in] filter Puntero a la cadena.
+  */
+ uint16_t filterValue(const filter_t *filter);
+ 
+ /**
+  * @brief Devuelve los contadores de la cadena.
+  *
+  * @param[in] filter Puntero a la cadena.
+  */
+ filterStats_t filterGetStats(const filter_t *filter);
+ 
+ #ifdef API_FILTER_BENCHMARK
+ 
+ /**
+  * @brief Ciclos de CPU de la cadena con cada vez más etapas habilitadas.
+  *
+  * Ciclos por medición = cycles / samples.
+  */
+ typedef struct {
+     uint32_t samples;           /**< Mediciones filtradas con cada configuración. */
+     uint32_t gateCycles;        /**< Ciclos totales solo con la compuerta. */
+     uint32_t medianCycles;      /**< Ciclos totales con compuerta y mediana de 5. */
+     uint32_t emaCycles;         /**< Ciclos totales con compuerta, mediana y EMA. */
+     uint32_t kalmanCycles;      /**< Ciclos totales con las cuatro etapas. */
+ } filterBenchmark_t;
+ 
+ void filterBenchmark(filterBenchmark_t *result, uint32_t samples);
+ 
+ #endif /* API_FILTER_BENCHMARK */
+ 
+ #endif /* API_API_FILTER_H_ */
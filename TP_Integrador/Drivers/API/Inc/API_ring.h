@@ -0,0 +1,86 @@
+/**
+ * @file API_ring.h
+ *
+ * @brief Buffer circular de bytes sin bloqueo para un productor y un consumidor.
+ *
+ * Pensado para pasar datos de una interrupción (productor) al lazo principal
+ * (consumidor) sin deshabilitar interrupciones. Cada índice lo escribe un solo lado:
+ * el productor publica los bytes escritos con un almacenamiento release de head y el
+ * consumidor libera los leídos con un almacenamiento release de tail; cada lado lee
+ * el índice del otro con acquire, por lo que nunca ve un byte antes de que esté escrito.
+ * Los índices avanzan libremente y la posición se obtiene con una máscara, por lo que
+ * el tamaño debe ser potencia de dos.
+ */
+
+ #ifndef API_API_RING_H_
+ #define API_API_RING_H_
+ 
+ #include <stdint.h>
+ #include <stdbool.h>
+ #include <stdatomic.h>
+ #include <assert.h>
+ 
+ /**
+  * @brief Buffer circular de un productor y un consumidor.
+  */
+ typedef struct {
+     uint8_t *buffer;            /**< Memoria del buffer (size bytes). */
+     uint32_t mask;              /**< size - 1. */
+     atomic_uint_fast32_t head;  /**< Bytes escritos desde el inicio (solo lo escribe el productor). */
+     atomic_uint_fast32_t tail;  /**< Bytes leídos desde el inicio (solo lo escribe el consumidor). */
+     atomic_uint_fast32_t overflows; /**< Bytes descartados por buffer lleno (solo lo escribe el productor). */
+ } ring_t;
+ 
+ /**
+  * @brief Inicializa un buffer circular vacío.
+  *
+  * @param[out] ring Puntero al buffer circular.
+  * @param[in] buffer Memoria del buffer.
+  * @param[in] size Tamaño de la memoria en bytes (potencia de dos).
+  * @note No debe haber productor ni consumidor activos durante la inicialización.
+  */
+ void ringInit(ring_t *ring, uint8_t *buffer, uint32_t size);
+ 
+ /**
+  * @brief Agrega un byte (lado productor).
+  *
+  * @param[in,out] ring Puntero al buffer circular.
+  * @param[in] byte Byte a agregar.
+  * @return true si se agregó, false si el buffer estaba lleno (se cuenta como desborde).
+  */
+ bool ringPut(ring_t *ring, uint8_t byte);
+ 
+ /**
+  * @brief Agrega varios bytes con una sola publicación (lado productor).
+  *
+  * @param[in,out] ring Puntero al buffer circular.
+  * @param[in] data Bytes a agregar.
+  * @param[in] length Cantidad de bytes.
+  * @return Bytes agregados; los que no entran se descartan y se cuentan como desborde.
+  */
+ uint32_t ringWrite(ring_t *ring, const uint8_t *data, uint32_t length);
+ 
+ /**
+  * @brief Extrae el byte más antiguo (lado consumidor).
+  *
+  * @param[in,out] ring Puntero al buffer circular.
+  * @param[out] byte Byte extraído.
+  * @return true si había un byte, false si el buffer estaba vacío.
+  */
+ bool ringGet(ring_t *ring, uint8_t *byte);
+ 
+ /**
+  * @brief Devuelve la cantidad de bytes disponibles para el consumidor.
+  *
+  * @param[in] ring Puntero al buffer circular.
+  */
+ uint32_t ringCount(ring_t *ring);
+ 
+ /**
+  * @brief Devuelve los bytes descartados por buffer lleno desde la inicialización.
+  *
+  * @param[in] ring Puntero al buffer circular.
+  */
+ uint32_t ringOverflows(const ring_t *ring);
+ 
+ #endif /* API_API_RING_H_ */
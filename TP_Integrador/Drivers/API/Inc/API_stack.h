@@ -0,0 +1,33 @@
+/**
+ * @file API_stack.h
+ * @brief Medición de la pila libre por marca de agua.
+ *
+ * Al arrancar se llena con un patrón la zona de pila reservada por el linker
+ * (_Min_Stack_Size bytes debajo de _estack) que todavía no se usó. La pila libre es
+ * la cantidad de bytes desde el límite de esa zona que conservan el patrón, es decir,
+ * los que la pila nunca alcanzó.
+ */
+
+ #ifndef API_INC_API_STACK_H_
+ #define API_INC_API_STACK_H_
+ 
+ #include <stdint.h>
+ 
+ /**
+  * @brief Llena con el patrón la zona reservada de pila que está por debajo de la pila en uso.
+  *
+  * Debe llamarse una sola vez, al comienzo de main().
+  */
+ void stackPaint(void);
+ 
+ /**
+  * @brief Devuelve los bytes de la zona reservada de pila que nunca se usaron.
+  *
+  * Recorre la zona desde su límite inferior hasta el primer byte modificado, por lo que
+  * su costo es proporcional a la pila libre (a lo sumo _Min_Stack_Size / 4 lecturas).
+  *
+  * @return Bytes libres; 0 si la pila llegó al límite de la zona reservada.
+  */
+ uint32_t stackFree(void);
+ 
+ #endif /* API_INC_API_STACK_H_ */
@@ -0,0 +1,171 @@
+/**
+ * @file API_stats.h
+ *
+ * @brief Estadísticas de las últimas N mediciones con memoria constante.
+ *
+ * Sobre una ventana deslizante de hasta STATS_WINDOW_MAX mediciones se mantienen:
+ * - media y varianza por el método de Welford, quitando la medición que sale de la ventana;
+ * - mínimo y máximo con dos colas monótonas (cada medición entra y sale una sola vez);
+ * - un histograma de STATS_BINS intervalos fijos, del que se obtienen los percentiles.
+ *
+ * Todo el estado está en stats_t, que provee el llamador, y su tamaño no depende de
+ * la ventana configurada. Agregar una medición cuesta O(1) amortizado: media, varianza
+ * e histograma se actualizan en tiempo constante y cada medición entra y sale de las
+ * colas una sola vez. Los percentiles recorren el histograma, por lo que conviene
+ * pedirlos al mostrarlos y no con cada medición.
+ */
+
+ #ifndef API_API_STATS_H_
+ #define API_API_STATS_H_
+ 
+ #include <stdint.h>
+ #include <stdbool.h>
+ #include <assert.h>
+ 
+ /// @brief Mediciones de la ventana como máximo.
+ #define STATS_WINDOW_MAX        128
+ 
+ /// @brief Intervalos del histograma.
+ #define STATS_BINS              64
+ 
+ /**
+  * @brief Configuración de las estadísticas.
+  */
+ typedef struct {
+     uint16_t window;            /**< Mediciones de la ventana (1 a STATS_WINDOW_MAX). */
+     uint16_t binOrigin;         /**< Comienzo del primer intervalo del histograma [mm]. */
+     uint16_t binWidth;          /**< Ancho de cada intervalo [mm]; las mediciones fuera del histograma cuentan en el primero o el último. */
+ } statsConfig_t;
+ 
+ /// @brief Configuración por defecto: ventana completa e histograma de 0 a 2048 mm (el alcance del TF-LC02) en intervalos de 32 mm.
+ #define STATS_CONFIG_DEFAULT    { STATS_WINDOW_MAX, 0, 32 }
+ 
+ /**
+  * @brief Resumen de la ventana.
+  */
+ typedef struct {
+     uint16_t count;             /**< Mediciones en la ventana. */
+     uint16_t min;               /**< Mínimo [mm]. */
+     uint16_t max;               /**< Máximo [mm]. */
+     uint32_t meanTenths;        /**< Media [décimas de mm]. */
+     uint32_t stddevTenths;      /**< Desvío estándar de la muestra [décimas de mm]. */
+     uint16_t median;            /**< Mediana aproximada por el histograma [mm]. */
+     uint16_t p95;               /**< Percentil 95 aproximado por el histograma [mm]. */
+ } statsSummary_t;
+ 
+ /**
+  * @brief Entrada de una cola monótona: una medición y su número de orden.
+  */
+ typedef struct {
+     uint16_t value;             /**< Medición [mm]. */
+     uint16_t seq;               /**< Número de orden de la medición (módulo 65536). */
+ } statsDequeEntry_t;
+ 
+ /**
+  * @brief Cola monótona de la ventana (circular).
+  */
+ typedef struct {
+     statsDequeEntry_t entries[STATS_WINDOW_MAX];    /**< Mediciones candidatas a extremo, de la más antigua a la más nueva. */
+     uint8_t head;                                   /**< Posición de la más antigua. */
+     uint8_t len;                                    /**< Entradas en la cola. */
+ } statsDeque_t;
+ 
+ /**
+  * @brief Estado de las estadísticas.
+  */
+ typedef struct {
+     statsConfig_t config;                       /**< Configuración. */
+     uint16_t window[STATS_WINDOW_MAX];          /**< Mediciones de la ventana en orden de llegada (circular). */
+     uint16_t count;                             /**< Mediciones en la ventana. */
+     uint16_t pos;                               /**< Posición de window donde va la próxima medición. */
+     uint16_t seq;                               /**< Número de orden de la próxima medición (módulo 65536). */
+     uint32_t sum;                               /**< Suma de las mediciones de la ventana [mm]. */
+     int64_t scaledM2;                           /**< count por la suma de los cuadrados de las diferencias con la media (M2) [mm²]. */
+     statsDeque_t minDeque;                      /**< Mediciones crecientes: la primera es el mínimo. */
+     statsDeque_t maxDeque;                      /**< Mediciones decrecientes: la primera es el máximo. */
+     uint16_t bins[STATS_BINS];                  /**< Mediciones de la ventana en cada intervalo. */
+ } stats_t;
+ 
+ /**
+  * @brief Inicializa las estadísticas sin mediciones.
+  *
+  * @param[out] stats Puntero a las estadísticas.
+  * @param[in] config Configuración (se copia).
+  */
+ void statsInit(stats_t *stats, const statsConfig_t *config);
+ 
+ /**
+  * @brief Descarta las mediciones de la ventana, conservando la configuración.
+  *
+  * @param[in,out] stats Puntero a las estadísticas.
+  */
+ void statsReset(stats_t *stats);
+ 
+ /**
+  * @brief Agrega una medición a la ventana; si está llena sale la más antigua.
+  *
+  * @param[in,out] stats Puntero a las estadísticas.
+  * @param[in] value Medición [mm].
+  */
+ void statsUpdate(stats_t *stats, uint16_t value);
+ 
+ /**
+  * @brief Devuelve la cantidad de mediciones en la ventana.
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ uint16_t statsCount(const stats_t *stats);
+ 
+ /**
+  * @brief Devuelve el mínimo de la ventana [mm] (0 sin mediciones).
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ uint16_t statsMin(const stats_t *stats);
+ 
+ /**
+  * @brief Devuelve el máximo de la ventana [mm] (0 sin mediciones).
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ uint16_t statsMax(const stats_t *stats);
+ 
+ /**
+  * @brief Devuelve un percentil de la ventana aproximado por el histograma [mm].
+  *
+  * Se interpola entre las dos mediciones ordenadas que rodean al percentil, estimadas
+  * por el histograma, y el resultado se limita al mínimo y al máximo de la ventana,
+  * por lo que el error es a lo sumo el ancho de un intervalo.
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  * @param[in] percent Percentil (0 a 100).
+  * @return El percentil, o 0 sin mediciones.
+  */
+ uint16_t statsPercentile(const stats_t *stats, uint8_t percent);
+ 
+ /**
+  * @brief Devuelve el resumen de la ventana (todo en 0 sin mediciones).
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ statsSummary_t statsGetSummary(const stats_t *stats);
+ 
+ #ifdef API_STATS_BENCHMARK
+ 
+ /**
+  * @brief Ciclos de CPU de las estadísticas con la ventana completa.
+  *
+  * Ciclos por medición = updateCycles / samples.
+  */
+ typedef struct {
+     uint32_t samples;           /**< Mediciones agregadas. */
+     uint32_t updateCycles;      /**< Ciclos totales de statsUpdate(). */
+     uint32_t maxUpdateCycles;   /**< Ciclos de la statsUpdate() más lenta (la que vacía más entradas de una cola). */
+     uint32_t summaryCycles;     /**< Ciclos de una llamada a statsGetSummary(). */
+ } statsBenchmark_t;
+ 
+ void statsBenchmark(statsBenchmark_t *result, uint32_t samples);
+ 
+ #endif /* API_STATS_BENCHMARK */
+ 
+ #endif /* API_API_STATS_H_ */
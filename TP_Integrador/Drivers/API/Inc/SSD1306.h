@@ -1,6 +1,6 @@
 /**
  * @file SSD1306.h
- * @brief Interfaz para el control de un display OLED SSD1306 vía I2C.
+ * @brief Interfaz para el control de un display OLED SSD1306 vía I2C o SPI.
  *
  * Proporciona funciones para inicialización, control de encendido, limpieza,
  * y escritura de caracteres y strings en pantalla.
@@ -11,7 +11,10 @@
  #define API_INC_SSD1306_H_
  
  #include <string.h>
+ #include <stdbool.h>
  #include "stm32f4xx_hal.h"
+ #include "font.h"
+ #include "SSD1306_Port.h"
  #include <assert.h>
  
  /**
@@ -19,10 +22,10 @@
   * @{
   */
  
- /// @brief Ancho del display en píxeles.
+ /// @brief Ancho máximo del display en píxeles (tamaño de los buffers de cada instancia).
  #define SSD1306_WIDTH           128
  
- /// @brief Alto del display en píxeles.
+ /// @brief Alto máximo del display en píxeles (tamaño de los buffers de cada instancia).
  #define SSD1306_HEIGHT          64
  
  /// @brief Máximo número de caracteres por línea (fuente 5x7).
@@ -31,65 +34,302 @@
  /// @brief Máximo número de páginas de memoria (8 páginas de 8 píxeles).
  #define SDD1306_MAX_PAGE        7
  
+ /// @brief Cantidad máxima de páginas de memoria del display.
+ #define SSD1306_PAGES           (SSD1306_HEIGHT / 8)
+ 
+ /// @brief Ancho de una celda de caracter de la fuente 5x7: 5 columnas + 1 de espacio.
+ #define SSD1306_CHAR_CELL_WIDTH 6
+ 
+ /// @brief Direcciones I2C de 7 bits posibles del SSD1306 (pin SA0 en 0 o en 1).
+ #define SSD1306_ADDRESS         0x3C
+ #define SSD1306_ADDRESS_ALT     0x3D
+ 
+ /**
+  * @brief Desplaza la pantalla con el comando de scroll de contenido (2Ch/2Dh) del panel.
+  *
+  * Con 0 el desplazamiento se hace en el framebuffer y se reenvía la región completa
+  * (para controladores compatibles que no implementan ese comando).
+  */
+ #ifndef SSD1306_USE_CONTENT_SCROLL
+ #define SSD1306_USE_CONTENT_SCROLL  1
+ #endif
+ 
+ /// @brief Ventanas de escritura que puede usar cada página en una trama.
+ #define SSD1306_MAX_PAGE_SPANS  4
+ 
+ /// @brief Cantidad máxima de segmentos de una trama.
+ #define SSD1306_MAX_SEGMENTS    (SSD1306_PAGES * SSD1306_MAX_PAGE_SPANS)
+ 
  /** @} */ // Fin de configuraciones
  
  /**
-  * @brief Inicializa el display SSD1306 con los parámetros de configuración necesarios.
+  * @brief Alineación de un texto dentro de un campo de ancho fijo.
   */
- void SSD1306_Init(void);
+ typedef enum {
+     SSD1306_ALIGN_LEFT,     /**< Texto pegado al inicio del campo. */
+     SSD1306_ALIGN_RIGHT     /**< Texto pegado al final del campo (campos numéricos). */
+ } SSD1306_Align_t;
+ 
+ /**
+  * @brief Rango de columnas modificadas de una página del framebuffer.
+  *
+  * La página no tiene cambios pendientes cuando start > end.
+  */
+ typedef struct {
+     uint8_t start;     /**< Primera columna modificada. */
+     uint8_t end;       /**< Última columna modificada. */
+ } SSD1306_Dirty_t;
+ 
+ /**
+  * @brief Segmento de una trama a enviar: rectángulo de columnas y páginas.
+  */
+ typedef struct {
+     uint8_t pageStart; /**< Primera página. */
+     uint8_t pageEnd;   /**< Última página. */
+     uint8_t start;     /**< Primera columna. */
+     uint8_t end;       /**< Última columna. */
+     uint16_t offset;   /**< Posición de sus datos en el front buffer. */
+     uint16_t size;     /**< Cantidad de bytes de datos. */
+ } SSD1306_Segment_t;
+ 
+ /**
+  * @brief Contadores del planificador de SSD1306_Flush().
+  *
+  * Los bytes incluyen los de las ventanas y los de control (los que cuenta la capa de
+  * puerto). La referencia "naive" es una ventana por página con cambios, desde la
+  * primera hasta la última columna escrita.
+  */
+ typedef struct {
+     uint32_t frames;          /**< Tramas enviadas. */
+     uint32_t segments;        /**< Ventanas abiertas por el planificador. */
+     uint32_t plannedBytes;    /**< Bytes de bus de las tramas planificadas. */
+     uint32_t naiveBytes;      /**< Bytes de bus que habría costado la referencia. */
+ } SSD1306_FlushStats_t;
+ 
+ /**
+  * @brief Imagen completa del panel en flash.
+  *
+  * Los datos están en orden de página, como la GDDRAM en modo de direccionamiento
+  * horizontal: width bytes de la página 0, luego los de la página 1, etc.
+  */
+ typedef struct {
+     uint8_t width;          /**< Ancho de la imagen en columnas. */
+     uint8_t pages;          /**< Alto de la imagen en páginas. */
+     const uint8_t* data;    /**< width * pages bytes. */
+ } SSD1306_Image_t;
+ 
+ /**
+  * @brief Instancia de un display SSD1306.
+  *
+  * Contiene el bus y la dirección del panel, su geometría y todo el estado del
+  * driver (framebuffer, rangos pendientes y trama en envío). Se pasa a todas las
+  * funciones del driver, por lo que pueden usarse varios paneles a la vez. Los
+  * campos se completan con SSD1306_Init() y no deben modificarse desde afuera.
+  */
+ typedef struct SSD1306 {
+     SSD1306_Bus_t* bus;                                 /**< Bus al que está conectado el panel. */
+     uint8_t address;                                    /**< Dirección I2C de 7 bits. */
+     uint8_t width;                                      /**< Ancho del panel en píxeles. */
+     uint8_t height;                                     /**< Alto del panel en píxeles. */
+     uint8_t pages;                                      /**< Páginas del panel (height / 8). */
+     uint8_t framebuffer[SSD1306_PAGES][SSD1306_WIDTH];  /**< Copia en RAM de la GDDRAM (back buffer). */
+     uint8_t shadow[SSD1306_PAGES][SSD1306_WIDTH];       /**< Contenido de la GDDRAM una vez enviada la última trama. */
+     SSD1306_Dirty_t dirty[SSD1306_PAGES];               /**< Rango escrito desde el último flush en cada página. */
+     uint8_t frontbuffer[SSD1306_PAGES * SSD1306_WIDTH]; /**< Datos de la trama en envío, por segmento. */
+     SSD1306_Segment_t segments[SSD1306_MAX_SEGMENTS];   /**< Segmentos de la trama en envío. */
+     uint8_t segmentCount;                               /**< Cantidad de segmentos de la trama. */
+     volatile uint8_t segmentIndex;                      /**< Segmento en curso. */
+     volatile bool windowPhase;                          /**< La próxima transferencia es la ventana (true) o los datos. */
+     volatile bool flushBusy;                            /**< Hay una trama de este panel en envío. */
+     uint8_t windowCommands[6];                          /**< COLUMN_ADDR/PAGE_ADDR del segmento en curso. */
+     uint8_t cursorColumn;                               /**< Columna del cursor en píxeles. */
+     uint8_t cursorPage;                                 /**< Página del cursor. */
+     SSD1306_FlushStats_t flushStats;                    /**< Contadores del planificador. */
+     struct SSD1306* next;                               /**< Siguiente display del mismo bus. */
+ } SSD1306_t;
+ 
+ /**
+  * @brief Inicializa un display SSD1306 y lo agrega a su bus.
+  *
+  * @param dev Instancia a inicializar.
+  * @param bus Bus ya inicializado con SSD1306_Port_BusInit().
+  * @param address Dirección I2C de 7 bits (SSD1306_ADDRESS o SSD1306_ADDRESS_ALT).
+  * @param width Ancho del panel en píxeles (hasta SSD1306_WIDTH).
+  * @param height Alto del panel en píxeles: 16, 32 o 64.
+  */
+ void SSD1306_Init(SSD1306_t* dev, SSD1306_Bus_t* bus, uint8_t address, uint8_t width, uint8_t height);
+ 
+ /**
+  * @brief Envía N bytes de comando al display en una única transacción I2C.
+  *
+  * @param dev Instancia del display.
+  * @param commands Puntero a los bytes de comando (puede ser una tabla en flash).
+  * @param size Cantidad de bytes de comando.
+  */
+ void SSD1306_SendCommandStream(SSD1306_t* dev, const uint8_t* commands, size_t size);
  
  /**
   * @brief Limpia completamente la pantalla.
+  *
+  * @param dev Instancia del display.
   */
- void SSD1306_Clear(void);
+ void SSD1306_Clear(SSD1306_t* dev);
+ 
+ /**
+  * @brief Reemplaza el contenido completo de la pantalla por una imagen en flash.
+  *
+  * La imagen se envía en una sola transacción de datos, sin pasar por el planificador,
+  * y queda como contenido del framebuffer para dibujar encima.
+  *
+  * @param dev Instancia del display.
+  * @param image Imagen del tamaño del panel.
+  */
+ void SSD1306_LoadImage(SSD1306_t* dev, const SSD1306_Image_t* image);
+ 
+ /**
+  * @brief Envía al display las regiones del framebuffer modificadas desde el último envío.
+  *
+  * Las funciones de escritura solo modifican el framebuffer en RAM; el contenido
+  * se hace visible al llamar a esta función. Con SSD1306_USE_DMA el envío es no
+  * bloqueante y se puede seguir dibujando mientras la trama está en el bus.
+  *
+  * @param dev Instancia del display.
+  * @return true si la trama se envió o se inició su envío, false si la anterior
+  *         sigue en curso (los cambios quedan pendientes para el próximo llamado).
+  */
+ bool SSD1306_Flush(SSD1306_t* dev);
+ 
+ /**
+  * @brief Indica si hay una trama en envío por DMA.
+  *
+  * @param dev Instancia del display.
+  * @return true mientras la trama anterior está en el bus.
+  */
+ bool SSD1306_FlushBusy(const SSD1306_t* dev);
+ 
+ /**
+  * @brief Devuelve los contadores del planificador de envío (bytes planificados y de referencia).
+  *
+  * @param dev Instancia del display.
+  */
+ SSD1306_FlushStats_t SSD1306_GetFlushStats(const SSD1306_t* dev);
+ 
+ /**
+  * @brief Reinicia los contadores del planificador de envío.
+  *
+  * @param dev Instancia del display.
+  */
+ void SSD1306_ResetFlushStats(SSD1306_t* dev);
  
  /**
   * @brief Enciende el display (salir de modo de apagado).
+  *
+  * @param dev Instancia del display.
   */
- void SSD1306_DisplayOn(void);
+ void SSD1306_DisplayOn(SSD1306_t* dev);
  
  /**
   * @brief Apaga el display (modo bajo consumo).
+  *
+  * @param dev Instancia del display.
   */
- void SSD1306_DisplayOff(void);
+ void SSD1306_DisplayOff(SSD1306_t* dev);
  
  /**
-  * @brief Escribe un solo carácter en la posición actual del cursor.
+  * @brief Escribe un solo carácter en el framebuffer, en la posición actual del cursor.
   *
+  * @param dev Instancia del display.
   * @param c Carácter a escribir.
   */
- void SSD1306_WriteChar(char c);
+ void SSD1306_WriteChar(SSD1306_t* dev, char c);
  
  /**
   * @brief Escribe una cadena de texto en la pantalla, de forma continua.
   *
+  * @param dev Instancia del display.
   * @param str Puntero a la cadena de caracteres terminada en NULL.
   */
- void SSD1306_WriteString(char* str);
+ void SSD1306_WriteString(SSD1306_t* dev, char* str);
  
  /**
-  * @brief Muestra en pantalla los valores de medición actual, máxima y mínima.
+  * @brief Escribe un texto en un campo de ancho fijo, en una sola operación por página.
   *
-  * @param Actual Valor actual medido.
-  * @param Maxima Valor máximo registrado.
-  * @param Minima Valor mínimo registrado.
+  * Las celdas del campo que no ocupa el texto se borran y el texto que no entra se recorta.
+  *
+  * @param dev Instancia del display.
+  * @param x Celda de caracter inicial del campo (0 a 21).
+  * @param page Página del display (0 a 7).
+  * @param widthChars Ancho del campo en caracteres.
+  * @param str Texto a escribir, nulo-terminado.
+  * @param align Alineación del texto dentro del campo.
   */
- void SSD1306_PrintMesurement(uint16_t Actual, uint16_t Maxima, uint16_t Minima);
+ void SSD1306_DrawText(SSD1306_t* dev, uint8_t x, uint8_t page, uint8_t widthChars, const char* str, SSD1306_Align_t align);
  
  /**
-  * @brief Muestra en pantalla el valor de tiempo de muestreo seleccionado.
+  * @brief Escribe un texto con cualquier fuente en un campo de ancho fijo en píxeles.
+  *
+  * Admite fuentes de varias páginas (FontDigits2x, FontDigits3x) y proporcionales.
+  * El campo ocupa font->pages páginas a partir de page; lo que no ocupa el texto se borra.
   *
-  * @param muestreo Tiempo de muestreo en milisegundos.
+  * @param dev Instancia del display.
+  * @param x Columna inicial del campo en píxeles (0 a 127).
+  * @param page Página superior del campo.
+  * @param width Ancho del campo en píxeles.
+  * @param str Texto a escribir, nulo-terminado.
+  * @param font Fuente a utilizar.
+  * @param align Alineación del texto dentro del campo.
+  */
+ void SSD1306_DrawTextFont(SSD1306_t* dev, uint8_t x, uint8_t page, uint8_t width, const char* str, const font_t* font, SSD1306_Align_t align);
+ 
+ /**
+  * @brief Calcula el ancho en píxeles de un texto con una fuente, incluyendo el espaciado.
   */
- void SSD1306_PrintMuestreo(uint32_t muestreo);
+ uint16_t SSD1306_TextWidth(const char* str, const font_t* font);
  
  /**
-  * @brief Muestra en pantalla la configuración del puerto y calibración.
+  * @brief Devuelve el ancho de un glifo sin el espaciado.
   *
-  * @param port Puerto configurado.
-  * @param cal Estado de calibración.
+  * @param font Fuente a utilizar.
+  * @param c Carácter.
   */
- void SSD1306_PrintSetup(uint8_t port, uint8_t cal);
+ uint8_t SSD1306_GlyphWidth(const font_t* font, char c);
  
- #endif /* API_INC_SSD1306_H_ */
+ /**
+  * @brief Desplaza una columna a la izquierda el contenido de un rectángulo de la pantalla.
+  *
+  * La primera columna del rectángulo pasa a la última, que normalmente se reescribe
+  * luego con SSD1306_WriteColumn().
+  *
+  * @param dev Instancia del display.
+  * @param pageStart Página inicial.
+  * @param pageEnd Página final.
+  * @param colStart Columna inicial.
+  * @param colEnd Columna final.
+  */
+ void SSD1306_ScrollLeft(SSD1306_t* dev, uint8_t pageStart, uint8_t pageEnd, uint8_t colStart, uint8_t colEnd);
  
+ /**
+  * @brief Escribe una columna de varias páginas y la marca para enviar en el próximo flush.
+  *
+  * @param dev Instancia del display.
+  * @param column Columna destino.
+  * @param pageStart Página inicial.
+  * @param pageEnd Página final.
+  * @param data Un byte por página, de pageStart a pageEnd.
+  */
+ void SSD1306_WriteColumn(SSD1306_t* dev, uint8_t column, uint8_t pageStart, uint8_t pageEnd, const uint8_t* data);
+ 
+ /**
+  * @brief Devuelve una fila del framebuffer para escribirla directamente y la marca para el próximo flush.
+  *
+  * Es el punto de acceso de los módulos que dibujan sobre el framebuffer (por ejemplo SSD1306_Gfx).
+  *
+  * @param dev Instancia del display.
+  * @param page Página de la fila.
+  * @param start Primera columna que se va a escribir.
+  * @param end Última columna que se va a escribir.
+  * @return Puntero a la columna start de la página; solo pueden escribirse las columnas start a end.
+  */
+ uint8_t* SSD1306_EditRow(SSD1306_t* dev, uint8_t page, uint8_t start, uint8_t end);
+ 
+ #endif /* API_INC_SSD1306_H_ */
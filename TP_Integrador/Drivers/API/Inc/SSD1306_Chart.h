@@ -0,0 +1,63 @@
+/**
+ * @file SSD1306_Chart.h
+ * @brief Gráfico desplazable de un valor en el tiempo para el display SSD1306.
+ *
+ * El gráfico ocupa el ancho completo del panel en un rango de páginas. Cada muestra nueva
+ * desplaza el gráfico una columna a la izquierda (con el scroll del panel) y se
+ * dibuja en la última columna, por lo que cada muestra cuesta una sola columna en el bus.
+ *
+ */
+
+ #ifndef API_INC_SSD1306_CHART_H_
+ #define API_INC_SSD1306_CHART_H_
+ 
+ #include "SSD1306.h"
+ 
+ /**
+  * @brief Gráfico desplazable.
+  */
+ typedef struct {
+     SSD1306_t* dev;         /**< Display donde se dibuja el gráfico. */
+     uint8_t pageStart;      /**< Página superior del gráfico. */
+     uint8_t pageEnd;        /**< Página inferior del gráfico. */
+     uint16_t min;           /**< Valor dibujado en la fila inferior. */
+     uint16_t max;           /**< Valor dibujado en la fila superior. */
+     uint8_t lastRow;        /**< Fila de la muestra anterior (para unir el trazo). */
+     bool hasLast;           /**< false si no hay muestra anterior válida. */
+ } SSD1306_Chart_t;
+ 
+ /**
+  * @brief Inicializa un gráfico sobre un rango de páginas.
+  *
+  * Se asume que el rango está en blanco (por ejemplo, luego de SSD1306_Clear()).
+  *
+  * @param chart Puntero al gráfico.
+  * @param dev Display donde se dibuja el gráfico.
+  * @param pageStart Página superior.
+  * @param pageEnd Página inferior.
+  * @param min Valor correspondiente a la fila inferior.
+  * @param max Valor correspondiente a la fila superior.
+  */
+ void SSD1306_ChartInit(SSD1306_Chart_t* chart, SSD1306_t* dev, uint8_t pageStart, uint8_t pageEnd, uint16_t min, uint16_t max);
+ 
+ /**
+  * @brief Agrega una muestra en el borde derecho del gráfico.
+  *
+  * @param chart Puntero al gráfico.
+  * @param value Valor de la muestra; 0 se toma como muestra inválida y deja la columna vacía.
+  */
+ void SSD1306_ChartPush(SSD1306_Chart_t* chart, uint16_t value);
+ 
+ /**
+  * @brief Agrega varias muestras en el borde derecho del gráfico sin usar el scroll del panel.
+  *
+  * El gráfico se desplaza en el framebuffer y las columnas que cambian se envían con el
+  * próximo SSD1306_Flush(), por lo que el costo en el bus no depende de la cantidad de muestras.
+  *
+  * @param chart Puntero al gráfico.
+  * @param values Muestras, de la más antigua a la más nueva (0: muestra inválida).
+  * @param count Cantidad de muestras (a lo sumo el ancho del panel).
+  */
+ void SSD1306_ChartAppend(SSD1306_Chart_t* chart, const uint16_t* values, uint8_t count);
+ 
+ #endif /* API_INC_SSD1306_CHART_H_ */
@@ -0,0 +1,143 @@
+/**
+ * @file SSD1306_Gfx.h
+ * @brief Dibujo en cualquier posición de píxel sobre el framebuffer del display SSD1306.
+ *
+ * A diferencia de las funciones de texto del driver, que escriben páginas completas,
+ * los mapas de bits, glifos y primitivas de este módulo pueden empezar en cualquier
+ * fila (y), con recorte contra los bordes del panel y una operación de combinación
+ * con el contenido existente. Todo se dibuja en el framebuffer y llega al panel con
+ * el próximo SSD1306_Flush().
+ *
+ */
+
+ #ifndef API_INC_SSD1306_GFX_H_
+ #define API_INC_SSD1306_GFX_H_
+ 
+ #include "SSD1306.h"
+ 
+ /**
+  * @brief Operación de combinación de los píxeles dibujados con el framebuffer.
+  */
+ typedef enum {
+     SSD1306_ROP_COPY,       /**< Reemplaza el rectángulo dibujado (los píxeles apagados de la fuente borran). */
+     SSD1306_ROP_OR,         /**< Enciende los píxeles encendidos de la fuente. */
+     SSD1306_ROP_XOR,        /**< Invierte los píxeles encendidos de la fuente. */
+     SSD1306_ROP_CLEAR       /**< Apaga los píxeles encendidos de la fuente. */
+ } SSD1306_Rop_t;
+ 
+ /**
+  * @brief Mapa de bits en flash o RAM.
+  *
+  * Los datos están en orden de página, como los glifos de font_t: width bytes por cada
+  * banda de 8 filas, con el bit 0 de cada byte en la fila superior de la banda.
+  */
+ typedef struct {
+     uint8_t width;          /**< Ancho en columnas. */
+     uint8_t height;         /**< Alto en filas; las filas sobrantes de la última banda se ignoran. */
+     const uint8_t* data;    /**< width * ((height + 7) / 8) bytes. */
+ } SSD1306_Bitmap_t;
+ 
+ /**
+  * @brief Dibuja un mapa de bits con su esquina superior izquierda en (x, y).
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina (puede ser negativa o exceder el panel: se recorta).
+  * @param y Fila de la esquina (ídem).
+  * @param bitmap Mapa de bits.
+  * @param rop Operación de combinación.
+  */
+ void SSD1306_GfxBlit(SSD1306_t* dev, int16_t x, int16_t y, const SSD1306_Bitmap_t* bitmap, SSD1306_Rop_t rop);
+ 
+ /**
+  * @brief Dibuja un texto con cualquier fuente a partir de (x, y).
+  *
+  * @param dev Instancia del display.
+  * @param x Columna del primer glifo.
+  * @param y Fila superior de los glifos.
+  * @param str Texto nulo-terminado.
+  * @param font Fuente a utilizar.
+  * @param rop Operación de combinación; con SSD1306_ROP_COPY también se borra el espaciado.
+  * @return Columna siguiente al último glifo (con su espaciado).
+  */
+ int16_t SSD1306_GfxText(SSD1306_t* dev, int16_t x, int16_t y, const char* str, const font_t* font, SSD1306_Rop_t rop);
+ 
+ /**
+  * @brief Dibuja un píxel.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna.
+  * @param y Fila.
+  * @param rop Operación de combinación (SSD1306_ROP_COPY y SSD1306_ROP_OR lo encienden).
+  */
+ void SSD1306_GfxPixel(SSD1306_t* dev, int16_t x, int16_t y, SSD1306_Rop_t rop);
+ 
+ /**
+  * @brief Dibuja una línea entre dos puntos, ambos incluidos.
+  *
+  * @param dev Instancia del display.
+  * @param x0 Columna inicial.
+  * @param y0 Fila inicial.
+  * @param x1 Columna final.
+  * @param y1 Fila final.
+  * @param rop Operación de combinación.
+  */
+ void SSD1306_GfxLine(SSD1306_t* dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1, SSD1306_Rop_t rop);
+ 
+ /**
+  * @brief Dibuja el contorno de un rectángulo.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina superior izquierda.
+  * @param y Fila de la esquina superior izquierda.
+  * @param width Ancho en columnas.
+  * @param height Alto en filas.
+  * @param rop Operación de combinación.
+  */
+ void SSD1306_GfxRect(SSD1306_t* dev, int16_t x, int16_t y, uint8_t width, uint8_t height, SSD1306_Rop_t rop);
+ 
+ /**
+  * @brief Rellena un rectángulo.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina superior izquierda.
+  * @param y Fila de la esquina superior izquierda.
+  * @param width Ancho en columnas.
+  * @param height Alto en filas.
+  * @param rop Operación de combinación (SSD1306_ROP_CLEAR lo borra).
+  */
+ void SSD1306_GfxFillRect(SSD1306_t* dev, int16_t x, int16_t y, uint8_t width, uint8_t height, SSD1306_Rop_t rop);
+ 
+ /**
+  * @brief Dibuja una barra horizontal con contorno, llena en proporción a un valor.
+  *
+  * El interior se llena de izquierda a derecha y el resto se borra, por lo que la barra
+  * puede redibujarse con otro valor sin borrarla antes.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina superior izquierda.
+  * @param y Fila de la esquina superior izquierda.
+  * @param width Ancho total en columnas (al menos 3).
+  * @param height Alto total en filas (al menos 3).
+  * @param value Valor mostrado (se limita a max).
+  * @param max Valor de la barra llena.
+  */
+ void SSD1306_GfxBar(SSD1306_t* dev, int16_t x, int16_t y, uint8_t width, uint8_t height, uint16_t value, uint16_t max);
+ 
+ #ifdef SSD1306_GFX_BENCHMARK
+ 
+ /**
+  * @brief Resultado de la medición de SSD1306_GfxBenchmark().
+  *
+  * Píxeles por microsegundo = pixels * (SystemCoreClock / 1000000) / cycles.
+  */
+ typedef struct {
+     uint32_t iterations;    /**< Cantidad de mapas de bits dibujados. */
+     uint32_t pixels;        /**< Píxeles procesados en total. */
+     uint32_t cycles;        /**< Ciclos de CPU totales. */
+ } SSD1306_GfxBenchmark_t;
+ 
+ void SSD1306_GfxBenchmark(SSD1306_t* dev, SSD1306_GfxBenchmark_t* result, uint32_t iterations);
+ 
+ #endif /* SSD1306_GFX_BENCHMARK */
+ 
+ #endif /* API_INC_SSD1306_GFX_H_ */
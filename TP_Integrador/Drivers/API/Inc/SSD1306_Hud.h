@@ -0,0 +1,122 @@
+/**
+ * @file SSD1306_Hud.h
+ * @brief Pantalla de diagnóstico con métricas de funcionamiento del equipo.
+ *
+ * Muestra, una fila por métrica, la tasa de muestreo lograda, la latencia del sensor,
+ * los cuadros por segundo del display, la ocupación de su bus, las vueltas por segundo
+ * del lazo principal, las tramas inválidas y perdidas y la pila libre. Una segunda
+ * página muestra las estadísticas de las últimas mediciones de distancia (media,
+ * desvío, extremos y percentiles) y las descartadas. Las tasas se calculan a partir
+ * de contadores acumulados que provee la aplicación, una vez por período, de modo que
+ * tomar las métricas no cuesta nada entre períodos.
+ *
+ */
+
+ #ifndef API_INC_SSD1306_HUD_H_
+ #define API_INC_SSD1306_HUD_H_
+ 
+ #include "SSD1306.h"
+ #include "SSD1306_Widget.h"
+ 
+ /// @brief Período de cálculo y dibujo de las métricas (ms).
+ #define SSD1306_HUD_PERIOD_MS       1000
+ 
+ /// @brief Filas de cada página de la pantalla de diagnóstico (una por métrica).
+ #define SSD1306_HUD_ROWS            8
+ 
+ /// @brief Páginas de la pantalla de diagnóstico: funcionamiento y mediciones.
+ #define SSD1306_HUD_PAGES           2
+ 
+ /**
+  * @brief Métricas que entrega la aplicación: contadores acumulados y valores instantáneos.
+  */
+ typedef struct {
+     uint32_t samples;           /**< Mediciones válidas recibidas (acumulado). */
+     uint32_t latencyUs;         /**< Latencia pedido-respuesta de la última medición (us). */
+     uint32_t frames;            /**< Cuadros enviados al display (acumulado). */
+     uint8_t busBusyPercent;     /**< Ocupación del bus del display (%). */
+     uint32_t loops;             /**< Vueltas del lazo principal (acumulado). */
+     uint32_t invalidFrames;     /**< Tramas inválidas del sensor (acumulado). */
+     uint32_t droppedFrames;     /**< Pedidos al sensor sin respuesta (acumulado). */
+     uint32_t freeStack;         /**< Bytes de pila que nunca se usaron. */
+     uint16_t windowSamples;     /**< Mediciones de distancia en la ventana de las estadísticas. */
+     uint32_t meanTenths;        /**< Media de la ventana (décimas de mm). */
+     uint32_t stddevTenths;      /**< Desvío estándar de la ventana (décimas de mm). */
+     uint16_t minDistance;       /**< Mínimo de la ventana (mm). */
+     uint16_t maxDistance;       /**< Máximo de la ventana (mm). */
+     uint16_t median;            /**< Mediana de la ventana (mm). */
+     uint16_t p95;               /**< Percentil 95 de la ventana (mm). */
+     uint32_t rejectedSamples;   /**< Mediciones descartadas por código de error o rango (acumulado). */
+ } SSD1306_HudMetrics_t;
+ 
+ /**
+  * @brief Estado de la pantalla de diagnóstico.
+  */
+ typedef struct {
+     SSD1306_t* dev;                             /**< Display donde se muestra. */
+     bool visible;                               /**< La pantalla de diagnóstico ocupa el display. */
+     uint8_t page;                               /**< Página que se muestra. */
+     uint32_t windowStart;                       /**< Tick del último cálculo de las tasas. */
+     SSD1306_HudMetrics_t last;                  /**< Métricas del último cálculo, para las diferencias. */
+     uint32_t values[SSD1306_HUD_PAGES][SSD1306_HUD_ROWS];   /**< Último valor calculado de cada fila. */
+     SSD1306_Field_t fields[SSD1306_HUD_ROWS];   /**< Valor mostrado en cada fila. */
+ } SSD1306_Hud_t;
+ 
+ /**
+  * @brief Inicializa la pantalla de diagnóstico, oculta.
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @param dev Display donde se muestra.
+  */
+ void SSD1306_HudInit(SSD1306_Hud_t* hud, SSD1306_t* dev);
+ 
+ /**
+  * @brief Borra el display y muestra la pantalla de diagnóstico con los últimos valores.
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @note Mientras está visible la aplicación no debe dibujar sus pantallas en el display.
+  */
+ void SSD1306_HudShow(SSD1306_Hud_t* hud);
+ 
+ /**
+  * @brief Pasa a la página siguiente de la pantalla de diagnóstico (después de la última vuelve a la primera).
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @note Si está visible se vuelve a dibujar con los últimos valores.
+  */
+ void SSD1306_HudNextPage(SSD1306_Hud_t* hud);
+ 
+ /**
+  * @brief Oculta la pantalla de diagnóstico.
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @note El contenido queda en el display hasta que la aplicación vuelva a dibujar su pantalla.
+  */
+ void SSD1306_HudHide(SSD1306_Hud_t* hud);
+ 
+ /**
+  * @brief Indica si la pantalla de diagnóstico está visible.
+  *
+  * @param hud Pantalla de diagnóstico.
+  */
+ bool SSD1306_HudVisible(const SSD1306_Hud_t* hud);
+ 
+ /**
+  * @brief Indica si pasó el período y corresponde tomar las métricas.
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @return true si hay que llamar a SSD1306_HudUpdate().
+  */
+ bool SSD1306_HudDue(const SSD1306_Hud_t* hud);
+ 
+ /**
+  * @brief Calcula las tasas del período y, si está visible, actualiza la pantalla.
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @param metrics Métricas actuales.
+  * @note Solo se redibujan las celdas que cambiaron; el contenido llega al panel con el
+  *       próximo SSD1306_Flush().
+  */
+ void SSD1306_HudUpdate(SSD1306_Hud_t* hud, const SSD1306_HudMetrics_t* metrics);
+ 
+ #endif /* API_INC_SSD1306_HUD_H_ */
@@ -1,5 +1,10 @@
 /**
  * @file SSD1306_Port.h
+ * @brief Capa de puerto del SSD1306: transporte I2C o SPI 4 hilos, ambos con DMA.
+ *
+ * El transporte se elige al compilar con SSD1306_TRANSPORT; SSD1306.c no cambia.
+ * Las funciones de envío conservan el nombre SSD1306_I2C_Transmit*: en SPI el byte
+ * de control se traduce al nivel del pin D/C y la dirección no se usa.
  *
  */
 
@@ -10,15 +15,138 @@
  #include "stm32f4xx_hal.h"
  #include <string.h>
  #include <stdlib.h>
+ #include <stdbool.h>
+ 
+ /**
+  * @brief Selecciona el modo de envío de SSD1306_Flush().
+  *
+  * 1: envío no bloqueante por DMA, encadenado desde el callback de fin de transmisión.
+  * 0: envío bloqueante.
+  */
+ #ifndef SSD1306_USE_DMA
+ #define SSD1306_USE_DMA          1
+ #endif
+ 
+ /**
+  * @name Transporte del display
+  * @{
+  */
+ 
+ #define SSD1306_TRANSPORT_I2C    0    /**< I2C: byte de control antes de cada bloque. */
+ #define SSD1306_TRANSPORT_SPI    1    /**< SPI 4 hilos: pin D/C en lugar del byte de control, CS por bus. */
+ 
+ /// @brief Transporte usado por la capa de puerto.
+ #ifndef SSD1306_TRANSPORT
+ #define SSD1306_TRANSPORT        SSD1306_TRANSPORT_I2C
+ #endif
+ 
+ #if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+ #define SSD1306_PORT_FRAME_BITS     0              /**< Bits de bus por transacción, además de los datos (CS y D/C no ocupan el reloj). */
+ #define SSD1306_PORT_BYTE_BITS      8              /**< Bits de bus por byte transmitido. */
+ #define SSD1306_PORT_CONTROL_BYTES  0              /**< Bytes de control por transacción (D/C es un pin). */
+ #else
+ #define SSD1306_PORT_FRAME_BITS     (1 + 9 + 1)    /**< START, dirección con ACK y STOP. */
+ #define SSD1306_PORT_BYTE_BITS      9              /**< 8 bits de datos y ACK. */
+ #define SSD1306_PORT_CONTROL_BYTES  1              /**< Byte de control antes de cada bloque. */
+ #endif
+ 
+ /** @} */
+ 
+ /**
+  * @brief Contadores de tráfico en el bus del display.
+  */
+ typedef struct {
+     uint32_t transactions;    /**< Cantidad de transacciones I2C (START ... STOP). */
+     uint32_t bytes;           /**< Bytes transmitidos, incluyendo el byte de control en I2C (sin dirección). */
+ } SSD1306_PortStats_t;
+ 
+ struct SSD1306;
+ 
+ /**
+  * @brief Bus I2C compartido por uno o más displays.
+  *
+  * Los displays conectados al mismo periférico (por ejemplo 0x3C y 0x3D) comparten
+  * un bus: sus tramas por DMA se intercalan transferencia por transferencia, de modo
+  * que un envío grande de un panel no bloquea los cambios de otro.
+  */
+ typedef struct SSD1306_Bus {
+     void* handle;                       /**< Handle del periférico (I2C_HandleTypeDef* o SPI_HandleTypeDef* en STM32). */
+     void* dcPort;                       /**< Puerto del pin D/C (solo SPI). */
+     uint16_t dcPin;                     /**< Pin D/C (solo SPI). */
+     void* csPort;                       /**< Puerto del pin CS (solo SPI). */
+     uint16_t csPin;                     /**< Pin CS (solo SPI). */
+     struct SSD1306* devices;            /**< Displays conectados al bus (lista enlazada). */
+     struct SSD1306* current;            /**< Display de la transferencia en curso. */
+     volatile bool busy;                 /**< true mientras algún display tiene una trama en envío. */
+     SSD1306_PortStats_t stats;          /**< Tráfico del bus desde el último reinicio. */
+     struct SSD1306_Bus* next;           /**< Siguiente bus registrado (para los callbacks de la HAL). */
+ } SSD1306_Bus_t;
+ 
+ /**
+  * @brief Inicializa un bus y lo registra para recibir los callbacks del periférico.
+  *
+  * @param[in] bus Bus a inicializar.
+  * @param[in] handle Handle del periférico ya configurado (por ejemplo &hi2c1 o &hspi1).
+  */
+ void SSD1306_Port_BusInit(SSD1306_Bus_t* bus, void* handle);
+ 
+ /**
+  * @brief Asigna los pines D/C y CS de un bus SPI y los deja en reposo (CS en alto).
+  *
+  * @param[in] bus Bus ya inicializado con SSD1306_Port_BusInit().
+  * @param[in] dcPort Puerto del pin D/C (GPIO_TypeDef* en STM32).
+  * @param[in] dcPin Pin D/C.
+  * @param[in] csPort Puerto del pin CS.
+  * @param[in] csPin Pin CS.
+  *
+  * @note En SPI cada bus tiene un solo display (un pin CS por bus).
+  */
+ void SSD1306_Port_SetPins(SSD1306_Bus_t* bus, void* dcPort, uint16_t dcPin, void* csPort, uint16_t csPin);
  
+ /**
+  * @brief Envía datos al display SSD1306 en modo bloqueante.
+  *
+  * @param[in] bus Bus del display.
+  * @param[in] address Dirección I2C de 7 bits del display (0x3C o 0x3D); no se usa en SPI.
+  * @param[in] control Byte de control (comando o datos) que precede al bloque; en SPI fija el pin D/C.
+  * @param[in] pData Puntero al buffer de datos a transmitir.
+  * @param[in] Size Cantidad de bytes a transmitir.
+  */
+ void SSD1306_I2C_Transmit(SSD1306_Bus_t* bus, uint8_t address, uint8_t control, const uint8_t *pData, uint16_t Size);
  
  /**
-  * @brief Envía datos al display SSD1306 mediante I2C.
+  * @brief Inicia el envío de datos al display SSD1306 mediante DMA.
+  *
+  * Retorna inmediatamente; al finalizar se llama a SSD1306_TxCpltCallback().
+  * El buffer debe permanecer válido hasta ese momento.
   *
+  * @param[in] bus Bus del display.
+  * @param[in] address Dirección I2C de 7 bits del display (0x3C o 0x3D); no se usa en SPI.
+  * @param[in] control Byte de control (comando o datos) que precede al bloque; en SPI fija el pin D/C.
   * @param[in] pData Puntero al buffer de datos a transmitir.
   * @param[in] Size Cantidad de bytes a transmitir.
   */
- void SSD1306_I2C_Transmit(uint8_t *pData, uint16_t Size);
+ void SSD1306_I2C_Transmit_DMA(SSD1306_Bus_t* bus, uint8_t address, uint8_t control, const uint8_t *pData, uint16_t Size);
+ 
+ /**
+  * @brief Devuelve el tiempo transcurrido desde el arranque, en milisegundos.
+  */
+ uint32_t SSD1306_Port_GetTick(void);
+ 
+ /**
+  * @brief Devuelve los contadores de tráfico acumulados desde el último reinicio.
+  *
+  * @param[in] bus Bus consultado.
+  * @return Copia de los contadores de transacciones y bytes.
+  */
+ SSD1306_PortStats_t SSD1306_Port_GetStats(const SSD1306_Bus_t* bus);
+ 
+ /**
+  * @brief Reinicia los contadores de tráfico del bus.
+  *
+  * @param[in] bus Bus a reiniciar.
+  */
+ void SSD1306_Port_ResetStats(SSD1306_Bus_t* bus);
  
  
  #endif /* API_INC_SSD1306_PORT_H_ */
@@ -0,0 +1,110 @@
+/**
+ * @file SSD1306_Refresh.h
+ * @brief Limitador de refresco del display SSD1306, independiente del ritmo de muestreo.
+ *
+ * Las actualizaciones que llegan antes de que toque el próximo cuadro se agrupan en
+ * uno solo, que se dibuja con el último valor disponible. Además de la tasa máxima de
+ * cuadros se respeta un presupuesto de ocupación del bus: el tiempo de bus usado se
+ * estima con los contadores de la capa de puerto y, si se excede, el cuadro se posterga.
+ *
+ */
+
+ #ifndef API_INC_SSD1306_REFRESH_H_
+ #define API_INC_SSD1306_REFRESH_H_
+ 
+ #include "SSD1306.h"
+ 
+ /// @brief Tasa máxima de cuadros por defecto.
+ #define SSD1306_REFRESH_DEFAULT_FPS         20
+ 
+ /// @brief Porcentaje máximo del bus que puede ocupar el display, por defecto.
+ #define SSD1306_REFRESH_DEFAULT_BUDGET      50
+ 
+ /// @brief Ventana sobre la que se calcula el porcentaje de ocupación del bus (ms).
+ #define SSD1306_REFRESH_WINDOW_MS           1000
+ 
+ /**
+  * @brief Contadores publicados por el limitador.
+  */
+ typedef struct {
+     uint32_t framesDrawn;       /**< Cuadros enviados al display. */
+     uint32_t updatesCoalesced;  /**< Actualizaciones agrupadas en un cuadro ya pendiente. */
+     uint32_t framesDeferred;    /**< Veces que un cuadro vencido se postergó por el presupuesto de bus. */
+     uint8_t busBusyPercent;     /**< Ocupación del bus en la última ventana completa (%). */
+ } SSD1306_RefreshStats_t;
+ 
+ /**
+  * @brief Estado del limitador de refresco de un display.
+  */
+ typedef struct {
+     SSD1306_t* dev;                 /**< Display refrescado. */
+     uint32_t framePeriod;           /**< Tiempo mínimo entre cuadros (ms). */
+     uint8_t busBudget;              /**< Porcentaje máximo de ocupación del bus. */
+     uint32_t busClockHz;            /**< Frecuencia del bus, para estimar su tiempo de ocupación. */
+     uint32_t lastFrame;             /**< Tick del último cuadro enviado. */
+     bool pending;                   /**< Hay contenido nuevo sin enviar. */
+     bool deferred;                  /**< El cuadro pendiente ya se contó como postergado. */
+     uint32_t lastTick;              /**< Tick de la última actualización del crédito de bus. */
+     uint32_t lastTransactions;      /**< Transacciones del bus contadas hasta lastTick. */
+     uint32_t lastBytes;             /**< Bytes del bus contados hasta lastTick. */
+     int32_t creditUs;               /**< Tiempo de bus disponible (us); negativo si se excedió. */
+     uint32_t windowStart;           /**< Tick de inicio de la ventana de ocupación. */
+     uint32_t windowBusyUs;          /**< Tiempo de bus usado en la ventana actual (us). */
+     SSD1306_RefreshStats_t stats;   /**< Contadores publicados. */
+ } SSD1306_Refresh_t;
+ 
+ /**
+  * @brief Inicializa el limitador de un display.
+  *
+  * @param refresh Limitador a inicializar.
+  * @param dev Display ya inicializado.
+  * @param maxFps Tasa máxima de cuadros por segundo (1 a 1000).
+  * @param busBudget Porcentaje máximo del bus que puede ocupar el display (1 a 100).
+  * @param busClockHz Frecuencia del bus (por ejemplo 100000 o 400000 en I2C, 10000000 en SPI).
+  */
+ void SSD1306_RefreshInit(SSD1306_Refresh_t* refresh, SSD1306_t* dev, uint16_t maxFps, uint8_t busBudget, uint32_t busClockHz);
+ 
+ /**
+  * @brief Cambia la tasa máxima de cuadros.
+  *
+  * @param refresh Limitador del display.
+  * @param maxFps Tasa máxima de cuadros por segundo (1 a 1000).
+  */
+ void SSD1306_RefreshSetFps(SSD1306_Refresh_t* refresh, uint16_t maxFps);
+ 
+ /**
+  * @brief Indica que hay contenido nuevo para mostrar.
+  *
+  * @param refresh Limitador del display.
+  * @note Si ya había un cuadro pendiente, la actualización se agrupa con él.
+  */
+ void SSD1306_RefreshRequest(SSD1306_Refresh_t* refresh);
+ 
+ /**
+  * @brief Indica si corresponde dibujar y enviar un cuadro.
+  *
+  * Es true si hay contenido pendiente, pasó el período de cuadro, el display no tiene
+  * una trama en envío y queda presupuesto de bus.
+  *
+  * @param refresh Limitador del display.
+  * @note Debe llamarse periódicamente (por ejemplo en cada vuelta del lazo principal):
+  *       también actualiza la estimación de ocupación del bus.
+  */
+ bool SSD1306_RefreshDue(SSD1306_Refresh_t* refresh);
+ 
+ /**
+  * @brief Envía el cuadro dibujado y lo registra.
+  *
+  * @param refresh Limitador del display.
+  * @note El contenido debe dibujarse en el framebuffer justo antes, con los últimos valores.
+  */
+ void SSD1306_RefreshFlush(SSD1306_Refresh_t* refresh);
+ 
+ /**
+  * @brief Devuelve los contadores del limitador.
+  *
+  * @param refresh Limitador consultado.
+  */
+ SSD1306_RefreshStats_t SSD1306_RefreshGetStats(const SSD1306_Refresh_t* refresh);
+ 
+ #endif /* API_INC_SSD1306_REFRESH_H_ */
@@ -0,0 +1,20 @@
+/**
+ * @file SSD1306_Splash.h
+ * @brief Imágenes de arranque de la pantalla de medición, generadas en flash.
+ *
+ * Contienen las etiquetas fijas de la pantalla de medición ya rasterizadas en
+ * orden de página. Las genera Tools/splashgen.py en SSD1306_Splash.c, por lo que
+ * al arrancar no se formatea ni se dibuja ningún texto fijo.
+ *
+ */
+
+ #ifndef API_INC_SSD1306_SPLASH_H_
+ #define API_INC_SSD1306_SPLASH_H_
+ 
+ #include "SSD1306.h"
+ 
+ /* Imágenes generadas por Tools/splashgen.py en SSD1306_Splash.c */
+ extern const SSD1306_Image_t SSD1306_SplashMeasure64;   /**< Pantalla de medición de 128x64. */
+ extern const SSD1306_Image_t SSD1306_SplashMeasure32;   /**< Pantalla de medición de 128x32. */
+ 
+ #endif /* API_INC_SSD1306_SPLASH_H_ */
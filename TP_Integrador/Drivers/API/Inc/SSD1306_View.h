@@ -0,0 +1,152 @@
+/**
+ * @file SSD1306_View.h
+ * @brief Pantallas de la aplicación (medición y gráfico) sobre un display SSD1306.
+ *
+ * Cada vista está ligada a un display y guarda los campos retenidos y el gráfico
+ * que muestra, por lo que cada panel puede tener su propia vista. La distribución
+ * de la pantalla se elige según la altura del panel (64 o 32 filas).
+ *
+ */
+
+ #ifndef API_INC_SSD1306_VIEW_H_
+ #define API_INC_SSD1306_VIEW_H_
+ 
+ #include "SSD1306.h"
+ #include "SSD1306_Widget.h"
+ #include "SSD1306_Chart.h"
+ 
+ /// @brief Longitud máxima de los textos que arma la vista (22 caracteres por página).
+ #define SSD1306_VIEW_TEXT_LENGTH    22
+ 
+ /// @brief Muestras del gráfico que pueden esperar al próximo cuadro: un ancho de panel (las anteriores ya no se verían).
+ #define SSD1306_VIEW_CHART_QUEUE    SSD1306_WIDTH
+ 
+ /// @brief Muestras por cuadro que se dibujan con el scroll del panel; si hay más se redibuja el gráfico en el framebuffer (el panel necesita un cuadro de refresco entre dos 2Dh).
+ #define SSD1306_VIEW_CHART_SCROLLS  1
+ 
+ /**
+  * @brief Pantallas disponibles.
+  */
+ typedef enum {
+     SSD1306_SCREEN_MEASURE,     /**< Distancia actual, máxima, mínima, muestreo y configuración. */
+     SSD1306_SCREEN_CHART        /**< Distancia actual y gráfico de distancia en el tiempo. */
+ } SSD1306_Screen_t;
+ 
+ /**
+  * @brief Campos con etiqueta de la pantalla de medición.
+  */
+ typedef enum {
+     SSD1306_FIELD_DISTANCIA,
+     SSD1306_FIELD_MAXIMA,
+     SSD1306_FIELD_MINIMA,
+     SSD1306_FIELD_MUESTREO,
+     SSD1306_FIELD_VALUES_COUNT
+ } SSD1306_ScreenField;
+ 
+ struct SSD1306_Layout;
+ 
+ /**
+  * @brief Estado de las pantallas mostradas en un display.
+  */
+ typedef struct {
+     SSD1306_t* dev;                                             /**< Display de la vista. */
+     const struct SSD1306_Layout* layout;                        /**< Distribución según la altura del panel. */
+     SSD1306_Screen_t screen;                                    /**< Pantalla mostrada. */
+     bool ready;                                                 /**< Los campos reflejan el contenido del panel. */
+     SSD1306_Field_t valueFields[SSD1306_FIELD_VALUES_COUNT];    /**< Valores de la pantalla de medición. */
+     SSD1306_Field_t calibField;                                 /**< Estado de calibración. */
+     SSD1306_Field_t portField;                                  /**< Puerto configurado. */
+     char distanceText[SSD1306_VIEW_TEXT_LENGTH];                /**< Distancia mostrada con dígitos grandes. */
+     SSD1306_Field_t chartValueField;                            /**< Distancia actual en la pantalla de gráfico. */
+     SSD1306_Field_t chartSamplingField;                         /**< Muestreo en la pantalla de gráfico. */
+     SSD1306_Chart_t chart;                                      /**< Gráfico de distancia. */
+     uint16_t chartQueue[SSD1306_VIEW_CHART_QUEUE];              /**< Muestras del gráfico aún no dibujadas (circular). */
+     uint8_t chartHead;                                          /**< Posición de la muestra más antigua de la cola. */
+     uint8_t chartCount;                                         /**< Muestras en la cola. */
+ } SSD1306_View_t;
+ 
+ /**
+  * @brief Asocia una vista a un display ya inicializado y muestra la pantalla de medición.
+  *
+  * Envía de una vez la imagen en flash con las etiquetas fijas de la pantalla, por lo
+  * que no hace falta borrar el display antes.
+  *
+  * @param view Vista a inicializar.
+  * @param dev Display de la vista (al menos 32 filas).
+  */
+ void SSD1306_ViewInit(SSD1306_View_t* view, SSD1306_t* dev);
+ 
+ /**
+  * @brief Cambia la pantalla mostrada. Borra el display si la pantalla cambia.
+  *
+  * @param view Vista del display.
+  * @param screen Pantalla a mostrar.
+  *
+  * @note Tras el cambio deben volver a llamarse las funciones Print* para dibujar su contenido.
+  */
+ void SSD1306_SetScreen(SSD1306_View_t* view, SSD1306_Screen_t screen);
+ 
+ /**
+  * @brief Vuelve a dibujar el fondo de la pantalla actual, por ejemplo tras la pantalla de diagnóstico.
+  *
+  * @param view Vista del display.
+  *
+  * @note Tras la llamada deben volver a llamarse las funciones Print* para dibujar su contenido.
+  */
+ void SSD1306_ViewRedraw(SSD1306_View_t* view);
+ 
+ /**
+  * @brief Devuelve la pantalla mostrada actualmente.
+  *
+  * @param view Vista del display.
+  */
+ SSD1306_Screen_t SSD1306_GetScreen(const SSD1306_View_t* view);
+ 
+ /**
+  * @brief Muestra en pantalla los valores de medición actual, máxima y mínima.
+  *
+  * @param view Vista del display.
+  * @param Actual Valor actual medido.
+  * @param Maxima Valor máximo registrado.
+  * @param Minima Valor mínimo registrado.
+  */
+ void SSD1306_PrintMesurement(SSD1306_View_t* view, uint16_t Actual, uint16_t Maxima, uint16_t Minima);
+ 
+ /**
+  * @brief Encola una muestra para el gráfico; se dibuja con la próxima SSD1306_PrintMesurement().
+  *
+  * Así cada medición ocupa su columna aunque el display dibuje menos cuadros que mediciones.
+  * Fuera de la pantalla de gráfico la muestra se descarta, y la cola se vacía cuando otra
+  * pantalla ocupó el display (SSD1306_ViewRedraw()).
+  *
+  * @param view Vista del display.
+  * @param value Distancia en milímetros (0: muestra inválida, columna vacía).
+  */
+ void SSD1306_PushSample(SSD1306_View_t* view, uint16_t value);
+ 
+ /**
+  * @brief Muestra en pantalla el valor de tiempo de muestreo seleccionado.
+  *
+  * @param view Vista del display.
+  * @param muestreo Tiempo de muestreo en milisegundos.
+  */
+ void SSD1306_PrintMuestreo(SSD1306_View_t* view, uint32_t muestreo);
+ 
+ /**
+  * @brief Muestra en el lugar del tiempo de muestreo la tasa lograda en modo continuo.
+  *
+  * @param view Vista del display.
+  * @param muestras Muestras por segundo.
+  */
+ void SSD1306_PrintRate(SSD1306_View_t* view, uint32_t muestras);
+ 
+ /**
+  * @brief Muestra en pantalla la configuración del puerto y calibración.
+  *
+  * @param view Vista del display.
+  * @param port Puerto configurado.
+  * @param cal Estado de calibración.
+  */
+ void SSD1306_PrintSetup(SSD1306_View_t* view, uint8_t port, uint8_t cal);
+ 
+ #endif /* API_INC_SSD1306_VIEW_H_ */
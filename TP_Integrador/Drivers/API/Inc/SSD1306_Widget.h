@@ -0,0 +1,63 @@
+/**
+ * @file SSD1306_Widget.h
+ * @brief Campos de texto retenidos para el display SSD1306.
+ *
+ * Cada campo está ligado a un rango de celdas de una página y recuerda el texto
+ * que muestra. Al actualizarlo solo se redibujan las celdas que cambiaron, de modo
+ * que un valor que no varía no genera tráfico en el bus.
+ *
+ */
+
+ #ifndef API_INC_SSD1306_WIDGET_H_
+ #define API_INC_SSD1306_WIDGET_H_
+ 
+ #include "SSD1306.h"
+ 
+ /// @brief Ancho máximo de un campo en caracteres (una línea completa).
+ #define SSD1306_FIELD_MAX_CHARS     SDD1306_MAX_CHARACTER
+ 
+ /**
+  * @brief Campo de texto ligado a celdas de la pantalla.
+  */
+ typedef struct {
+     SSD1306_t* dev;                                 /**< Display donde se muestra el campo. */
+     uint8_t x;                                      /**< Celda inicial (0 a 21). */
+     uint8_t page;                                   /**< Página del display (0 a 7). */
+     uint8_t width;                                  /**< Ancho del campo en caracteres. */
+     SSD1306_Align_t align;                          /**< Alineación del texto dentro del campo. */
+     char shown[SSD1306_FIELD_MAX_CHARS + 1];        /**< Celdas mostradas actualmente (con relleno). */
+     bool valid;                                     /**< false si se desconoce lo que muestra la pantalla. */
+ } SSD1306_Field_t;
+ 
+ /**
+  * @brief Inicializa un campo sobre un rango de celdas de una página.
+  *
+  * Se asume que el rango está en blanco (por ejemplo, luego de SSD1306_Clear()).
+  *
+  * @param field Puntero al campo.
+  * @param dev Display donde se muestra el campo.
+  * @param x Celda inicial.
+  * @param page Página del display.
+  * @param width Ancho del campo en caracteres (se recorta al borde de la pantalla).
+  * @param align Alineación del texto dentro del campo.
+  */
+ void SSD1306_FieldInit(SSD1306_Field_t* field, SSD1306_t* dev, uint8_t x, uint8_t page, uint8_t width, SSD1306_Align_t align);
+ 
+ /**
+  * @brief Actualiza el texto de un campo redibujando solo las celdas que cambiaron.
+  *
+  * @param field Puntero al campo.
+  * @param str Texto nuevo, nulo-terminado. Lo que excede el ancho del campo se recorta.
+  */
+ void SSD1306_FieldSetText(SSD1306_Field_t* field, const char* str);
+ 
+ /**
+  * @brief Fuerza el redibujado completo del campo en la próxima actualización.
+  *
+  * Debe llamarse cuando el contenido de la pantalla se modificó por fuera del campo.
+  *
+  * @param field Puntero al campo.
+  */
+ void SSD1306_FieldInvalidate(SSD1306_Field_t* field);
+ 
+ #endif /* API_INC_SSD1306_WIDGET_H_ */
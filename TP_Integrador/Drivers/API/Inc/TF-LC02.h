@@ -16,6 +16,90 @@
  #include <string.h>
  #include <assert.h>
  
+ /// @brief Modo continuo: espera máxima de la respuesta a un pedido antes de repetirlo (ms).
+ #ifndef TFLC02_FREERUN_TIMEOUT_MS
+ #define TFLC02_FREERUN_TIMEOUT_MS     10
+ #endif
+ 
+ /// @brief Modo continuo: pedidos seguidos sin respuesta tras los cuales se espera TFLC02_FREERUN_BACKOFF_MS.
+ #define TFLC02_FREERUN_MAX_RETRIES    3
+ 
+ /// @brief Modo continuo: espera antes de volver a pedir cuando el sensor no responde (ms).
+ #define TFLC02_FREERUN_BACKOFF_MS     100
+ 
+ /// @brief Comandos que pueden esperar en la cola de transmisión (potencia de dos).
+ #define TFLC02_TX_QUEUE_LEN           8
+ 
+ /// @brief Mediciones que pueden esperar a TFLC02_ReadSamples() (al llenarse se descartan las más antiguas).
+ #define TFLC02_SAMPLE_RING_LEN        32
+ 
+ /**
+  * @brief Contadores de la comunicación con el sensor.
+  *
+  * Se actualizan al pedir una medición y al procesar cada trama, sin costo apreciable,
+  * para diagnosticar el enlace sin depurador.
+  */
+ typedef struct {
+     uint32_t requests;          /**< Pedidos de medición enviados. */
+     uint32_t measurements;      /**< Mediciones válidas recibidas (sin código de error del sensor). */
+     uint32_t invalidFrames;     /**< Tramas comenzadas y descartadas (cabecera, comando, largo o fin inválidos). */
+     uint32_t discardedBytes;    /**< Bytes descartados al resincronizar (ruido y comienzo de tramas inválidas). */
+     uint32_t droppedRequests;   /**< Pedidos de medición sin respuesta antes del pedido siguiente, o abandonados por el modo continuo tras sus reintentos. */
+     uint32_t latencyUs;         /**< Tiempo entre el fin del envío del último pedido respondido y la llegada del fin de su trama (us). */
+     uint32_t rxInterrupts;      /**< Interrupciones de UART4 y su DMA de recepción atendidas (incluye las 6 del envío de cada comando). */
+     uint32_t rxCycles;          /**< Ciclos de CPU dentro de esas interrupciones (se usan diferencias: da la vuelta). */
+     uint32_t rxOverflows;       /**< Bytes recibidos descartados porque el buffer circular estaba lleno. */
+     uint32_t rxErrors;          /**< Errores de la UART (ruido, trama, desborde del periférico). */
+     uint32_t timeouts;          /**< Pedidos del modo continuo sin respuesta dentro de TFLC02_FREERUN_TIMEOUT_MS. */
+     uint32_t retries;           /**< Pedidos del modo continuo repetidos tras un timeout. */
+     uint32_t txCommands;        /**< Comandos terminados de enviar. */
+     uint32_t txQueueMax;        /**< Máximo de comandos en la cola de transmisión. */
+     uint32_t txOverflows;       /**< Comandos descartados porque la cola de transmisión estaba llena. */
+     uint32_t sampleOverflows;   /**< Mediciones descartadas sin leer porque se llenó el buffer de muestras. */
+ } TFLC02_Stats_t;
+ 
+ /**
+  * @brief Medición con los instantes del pedido y de la respuesta.
+  *
+  * Los instantes son lecturas del contador de ciclos del DWT tomadas en las
+  * interrupciones de la UART; la resta de dos de ellos dividida por
+  * (SystemCoreClock / 1000000) da microsegundos mientras no pase una vuelta del
+  * contador (51 s a 84 MHz).
+  */
+ typedef struct {
+     uint16_t distance;          /**< Distancia medida [mm]. */
+     uint8_t errorCode;          /**< Código de error del sensor (0: medición válida). */
+     uint32_t requestTime;       /**< Fin del envío del pedido respondido, o frameEndTime si no respondía a un pedido pendiente (o llegó antes de que terminara su envío). */
+     uint32_t frameEndTime;      /**< Llegada del fin de la trama de respuesta. */
+ } TFLC02_Sample_t;
+ 
+ /**
+  * @brief Estadísticas de tiempo de las mediciones recibidas.
+  *
+  * La latencia es el tiempo entre requestTime y frameEndTime de las mediciones que
+  * respondían a un pedido pendiente. El intervalo es el tiempo entre los frameEndTime
+  * de mediciones consecutivas y el jitter, el promedio móvil de la diferencia absoluta
+  * entre intervalos consecutivos (con peso 1/16, como el de RTP).
+  */
+ typedef struct {
+     uint32_t samples;           /**< Mediciones consideradas. */
+     uint32_t answered;          /**< Mediciones que respondían a un pedido (las de la latencia). */
+     uint32_t latencyMinUs;      /**< Latencia mínima (us). */
+     uint32_t latencyMaxUs;      /**< Latencia máxima (us). */
+     uint32_t latencyMeanUs;     /**< Latencia media (us). */
+     uint32_t intervalMinUs;     /**< Intervalo mínimo entre mediciones (us). */
+     uint32_t intervalMaxUs;     /**< Intervalo máximo entre mediciones (us). */
+     uint32_t jitterUs;          /**< Jitter del intervalo entre mediciones (us). */
+ } TFLC02_Timing_t;
+ 
+ /**
+  * @brief Función que se llama al terminar de enviar un comando.
+  *
+  * @param cmd Comando enviado.
+  * @note Se llama desde la interrupción de la UART: debe ser breve.
+  */
+ typedef void (*TFLC02_TxCallback_t)(uint8_t cmd);
+ 
  /**
   * @brief Inicializa el sensor TF-LC02.
   *
@@ -26,13 +110,26 @@
  void TFLC02_Init(void);
  
  /**
-  * @brief Inicia la recepción de datos del sensor TF-LC02 por interrupciones UART.
+  * @brief Inicia la recepción de datos del sensor TF-LC02.
   *
-  * Esta función inicia la recepción del sensor TF-LC02, habilitando las
-  * interrupciones UART para recibir datos del sensor.
+  * Con TFLC02_USE_RX_DMA la UART recibe continuamente en un buffer circular por DMA
+  * y las tramas se entregan al detectarse la línea inactiva; si no, se recibe byte
+  * por byte por interrupción. También vacía la cola de transmisión, por lo que debe
+  * llamarse antes de enviar comandos y no mientras se envía uno.
   */
  void TFLC02_Start(void);
  
+ /**
+  * @brief Registra la función a llamar al terminar de enviar cada comando.
+  *
+  * Los comandos no se envían al pedirlos: se encolan (hasta TFLC02_TX_QUEUE_LEN) y la
+  * UART los envía por interrupción, uno detrás de otro, por lo que las funciones que
+  * envían comandos retornan sin esperar la transmisión.
+  *
+  * @param callback Función a llamar, o NULL para no llamar a ninguna.
+  */
+ void TFLC02_SetTxCallback(TFLC02_TxCallback_t callback);
+ 
  /**
   * @brief Envia el comando para medir la distancia.
   *
@@ -41,6 +138,45 @@
   */
  void TFLC02_Mesure(void);
  
+ /**
+  * @brief Inicia el modo continuo: cada medición se pide en cuanto llega la respuesta a la anterior.
+  *
+  * En lugar de pedir mediciones a un período fijo, TFLC02_FreeRunUpdate() envía el
+  * pedido siguiente apenas se procesa la respuesta al anterior, por lo que el muestreo
+  * queda limitado por el intercambio en la UART y la medición del sensor. Hay a lo
+  * sumo un pedido sin responder: si no hay respuesta en TFLC02_FREERUN_TIMEOUT_MS se
+  * repite, y tras TFLC02_FREERUN_MAX_RETRIES pedidos seguidos sin respuesta se espera
+  * TFLC02_FREERUN_BACKOFF_MS antes de volver a pedir.
+  */
+ void TFLC02_FreeRunStart(void);
+ 
+ /**
+  * @brief Detiene el modo continuo; la respuesta a un pedido en curso se procesa igual.
+  */
+ void TFLC02_FreeRunStop(void);
+ 
+ /**
+  * @brief Indica si el modo continuo está activo.
+  */
+ bool TFLC02_FreeRunActive(void);
+ 
+ /**
+  * @brief Avanza el modo continuo: envía el pedido siguiente o repite uno vencido.
+  *
+  * Debe llamarse en cada vuelta del lazo principal, después de procesar las tramas
+  * recibidas, para que el pedido siguiente salga en la misma vuelta que la respuesta.
+  *
+  * @return true si se envió un pedido de medición.
+  */
+ bool TFLC02_FreeRunUpdate(void);
+ 
+ /**
+  * @brief Obtiene las mediciones válidas recibidas en el último segundo del modo continuo.
+  *
+  * @return Muestras por segundo logradas (0 hasta completar el primer segundo).
+  */
+ uint32_t TFLC02_FreeRunRate(void);
+ 
  /**
   * @brief Envia el comando para obtener la información del sensor.
   *
@@ -109,13 +245,62 @@
  /**
   * @brief Verifica si hay una trama completa para procesar.
   *
-  * Esta función verifica si existe una trama completa en el buffer de recepción
-  * que puede ser procesada. La trama debe contener todos los datos necesarios.
+  * Pasa al parser, de a un byte, los bytes que la interrupción de recepción dejó en
+  * el buffer circular, hasta completar una trama, que queda lista para
+  * TFLC02_Parse_Packet(). El parser conserva la trama a medio recibir entre llamadas
+  * y, ante un byte que no corresponde, busca la próxima cabecera sin descartar los
+  * bytes que siguen. Las tramas siguientes esperan en el buffer circular, por lo que
+  * pueden llegar varias entre dos llamadas.
   *
   * @return true Si hay una trama completa disponible.
   * @return false Si no hay una trama completa.
   */
  bool TFLC02_FramePresent(void);
  
- #endif /* API_INC_TF_LC02_H_ */
+ /**
+  * @brief Obtiene los contadores de la comunicación con el sensor.
+  *
+  * @return Copia de los contadores acumulados desde el arranque.
+  * @note La latencia se mide con el contador de ciclos del DWT, que debe estar
+  *       habilitado (cyclesInit() de API_cycles.h).
+  */
+ TFLC02_Stats_t TFLC02_GetStats(void);
  
+ /**
+  * @brief Extrae las mediciones recibidas, de la más antigua a la más reciente.
+  *
+  * Cada medición procesada por TFLC02_Parse_Packet() queda, con sus instantes, en un
+  * buffer de TFLC02_SAMPLE_RING_LEN mediciones; si no se leen a tiempo se descartan
+  * las más antiguas y se cuentan en sampleOverflows.
+  *
+  * @param[out] samples Destino de las mediciones.
+  * @param[in] max Cantidad máxima de mediciones a extraer.
+  * @return Mediciones extraídas.
+  * @note Debe llamarse desde el lazo principal, como TFLC02_Parse_Packet().
+  */
+ uint16_t TFLC02_ReadSamples(TFLC02_Sample_t *samples, uint16_t max);
+ 
+ /**
+  * @brief Obtiene las estadísticas de tiempo de las mediciones recibidas.
+  *
+  * @return Estadísticas acumuladas desde TFLC02_Start() o TFLC02_ResetTiming().
+  */
+ TFLC02_Timing_t TFLC02_GetTiming(void);
+ 
+ /**
+  * @brief Pone en cero las estadísticas de tiempo.
+  */
+ void TFLC02_ResetTiming(void);
+ 
+ /**
+  * @brief Cuenta una interrupción de recepción del sensor y su duración.
+  *
+  * @param cycles Ciclos de CPU que llevó atender la interrupción.
+  * @note Se llama desde UART4_IRQHandler() y DMA1_Stream2_IRQHandler(); con los
+  *       contadores de TFLC02_GetStats() se obtienen interrupciones y ciclos por medición.
+  *       UART4_IRQHandler() también atiende el envío de los comandos (una interrupción
+  *       por byte más la de fin de transmisión).
+  */
+ void TFLC02_CountInterrupt(uint32_t cycles);
+ 
+ #endif /* API_INC_TF_LC02_H_ */
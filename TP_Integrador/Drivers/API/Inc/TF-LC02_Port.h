@@ -3,7 +3,7 @@
  * @brief Interfaz de bajo nivel para la comunicación UART con el sensor TF-LC02.
  *
  * Este archivo declara las funciones necesarias para transmitir y recibir datos,
- * en modo bloqueante e interrupción, utilizando UART.
+ * en modo bloqueante, interrupción y DMA circular, utilizando UART.
  */
 
  #ifndef API_INC_TF_LC02_PORT_H_
@@ -12,6 +12,17 @@
  #include "stm32f4xx_hal.h"
  #include "main.h"
  
+ /**
+  * @brief Modo de recepción de las tramas del sensor.
+  *
+  * 1: DMA circular con detección de línea inactiva: una interrupción por trama
+  *    (más una cada vez que el DMA da la vuelta al buffer).
+  * 0: interrupción por byte, rearmada desde el callback de recepción.
+  */
+ #ifndef TFLC02_USE_RX_DMA
+ #define TFLC02_USE_RX_DMA        1
+ #endif
+ 
  /**
   * @brief Transmite datos hacia el sensor TF-LC02 mediante UART en modo bloqueante.
   *
@@ -33,11 +44,11 @@
  /**
   * @brief Transmite datos hacia el sensor TF-LC02 mediante UART en modo interrupción.
   *
-  * @param[in] huart Puntero a la estructura de la UART utilizada (no es utilizado internamente, se usa huart4).
   * @param[in] pData Puntero al buffer de datos a transmitir.
   * @param[in] Size Cantidad de bytes a transmitir.
+  * @note El buffer debe seguir válido hasta que se llame a HAL_UART_TxCpltCallback().
   */
- void TFLC02_Port_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+ void TFLC02_Port_Transmit_IT(const uint8_t *pData, uint16_t Size);
  
  /**
   * @brief Recibe datos desde el sensor TF-LC02 mediante UART en modo interrupción.
@@ -47,5 +58,15 @@
   */
  void TFLC02_Port_Receive_IT(uint8_t *pData, uint16_t Size);
  
- #endif /* API_INC_TF_LC02_PORT_H_ */
+ /**
+  * @brief Inicia la recepción continua desde el sensor TF-LC02 en un buffer circular por DMA.
+  *
+  * @param[out] pData Buffer circular donde el DMA escribe los datos recibidos.
+  * @param[in] Size Tamaño del buffer.
+  * @note Cada vez que la línea queda inactiva (fin de trama) o el DMA completa el buffer
+  *       se llama a HAL_UARTEx_RxEventCallback() con la posición de escritura. La
+  *       interrupción de medio buffer se deshabilita.
+  */
+ void TFLC02_Port_ReceiveToIdle_DMA(uint8_t *pData, uint16_t Size);
  
+ #endif /* API_INC_TF_LC02_PORT_H_ */
@@ -9,11 +9,86 @@
 #define API_INC_FONT_H_
 
 #include <stdint.h>
-
-extern const uint8_t Font5x7[][5];
+#include <stddef.h>
 
 #define ASCII_OFFSET 32
 #define ASCII_MIN 32
 #define ASCII_MAX 126
 
+/// @brief Glifos entre entradas del índice de una fuente comprimida.
+#define FONT_PACK_INDEX_STEP 16
+
+/// @brief Glifos descomprimidos que guarda el caché en RAM.
+#define FONT_CACHE_ENTRIES 12
+
+/// @brief Bytes de cada entrada del caché (width * pages de la fuente comprimida más grande).
+#define FONT_CACHE_GLYPH_BYTES 48
+
+/**
+ * @brief Descriptor de una fuente en flash.
+ *
+ * Los glifos se usan en orden de página: el glifo del carácter c ocupa width * pages
+ * bytes y cada página ocupa width bytes. Los caracteres fuera de [first, last] se
+ * dibujan en blanco.
+ *
+ * Si packed es NULL el glifo de c empieza en glyphs[(c - first) * width * pages]. Si no,
+ * los glifos están comprimidos por columnas (ver Tools/fontgen.py) y fontGlyph() los
+ * descomprime en un caché en RAM la primera vez que se usan.
+ */
+typedef struct {
+    uint8_t width;              /**< Columnas por glifo en la tabla. */
+    uint8_t pages;              /**< Alto del glifo en páginas de 8 píxeles. */
+    char first;                 /**< Primer carácter de la tabla. */
+    char last;                  /**< Último carácter de la tabla. */
+    uint8_t spacing;            /**< Columnas en blanco entre glifos. */
+    const uint8_t* glyphs;      /**< Tabla de glifos. */
+    const uint8_t* widths;      /**< Ancho útil de cada glifo, o NULL si es monoespaciada. */
+    uint8_t rows;               /**< Filas útiles del glifo (bits de cada columna comprimida). */
+    const uint8_t* packed;      /**< Glifos comprimidos, o NULL si están en glyphs. */
+    const uint16_t* packedIndex;/**< Posición en bits en packed de cada FONT_PACK_INDEX_STEP glifos. */
+    uint8_t* cacheSlots;        /**< Entrada del caché más uno de cada glifo (0: no está), en RAM. */
+} font_t;
+
+/**
+ * @brief Contadores del caché de glifos comprimidos.
+ */
+typedef struct {
+    uint32_t hits;              /**< Glifos encontrados ya descomprimidos. */
+    uint32_t misses;            /**< Glifos descomprimidos desde flash. */
+    uint32_t evictions;         /**< Glifos descartados para hacer lugar (el usado hace más tiempo). */
+} fontCacheStats_t;
+
+extern const uint8_t Font5x7[][5];
+
+/// @brief Font5x7 como descriptor (celdas de 6 columnas).
+extern const font_t FontSmall;
+
+/* Fuentes generadas por Tools/fontgen.py en font_gen.c */
+extern const font_t FontDigits2x;       /**< Dígitos, '-', '.' y '/' de 10x14 px. */
+extern const font_t FontDigits3x;       /**< Dígitos, '-', '.' y '/' de 15x21 px. */
+extern const font_t FontProportional;   /**< Font5x7 con ancho variable. */
+
+/**
+ * @brief Devuelve el glifo de un carácter en orden de página.
+ *
+ * @param font Fuente.
+ * @param c Carácter.
+ * @return width * pages bytes del glifo, o NULL si la fuente no incluye el carácter.
+ *
+ * @note En una fuente comprimida el puntero apunta al caché y vale hasta la siguiente
+ *       llamada: una nueva descompresión puede reutilizar esa entrada. Un glifo que ya
+ *       está en el caché cuesta un acceso a su índice, igual que en una fuente sin comprimir.
+ */
+const uint8_t* fontGlyph(const font_t* font, char c);
+
+/**
+ * @brief Devuelve los contadores del caché de glifos.
+ */
+fontCacheStats_t fontCacheGetStats(void);
+
+/**
+ * @brief Pone en cero los contadores del caché de glifos (no vacía el caché).
+ */
+void fontCacheResetStats(void);
+
 #endif /* API_INC_FONT_H_ */
@@ -19,7 +19,7 @@
 	 BUTTON_FALLING,  /**< Estado: posible transición a presionado. */
 	 BUTTON_DOWN,     /**< Estado: botón presionado. */
 	 BUTTON_RAISING,  /**< Estado: posible transición a liberado. */
-	 BUTTON_PRESSING, /**< Estado opcional no utilizado actualmente. */
+	 BUTTON_PRESSING, /**< Estado: botón mantenido presionado (pulsación larga ya registrada). */
  } debounceState_t;
  
  /**
@@ -37,11 +37,31 @@
   */
  static bool pushed = false;
  
+ /**
+  * @brief Variable que indica si se registró una pulsación larga.
+  */
+ static bool longPushed = false;
+ 
+ /**
+  * @brief Temporizador de la pulsación larga, desde que se confirma la presión.
+  */
+ static delay_t holdDelay;
+ 
+ /**
+  * @brief Indica si la presión en curso ya se registró como pulsación larga.
+  */
+ static bool holdReported = false;
+ 
  /**
   * @brief Tiempo de control de rebote en milisegundos.
   */
  const uint8_t time_ms = 10;
  
+ /**
+  * @brief Tiempo que debe mantenerse presionado el pulsador para una pulsación larga, en milisegundos.
+  */
+ const uint16_t longPress_ms = 1000;
+ 
  /**
   * @brief Inicializa la máquina de estados de antirebote.
   *
@@ -56,6 +76,9 @@
   *
   * Evalúa periódicamente el estado físico del pulsador y maneja la transición de estados
   * considerando el tiempo de rebote para detectar presiones reales.
+  * Una presión que se suelta antes de longPress_ms se registra como pulsación corta al
+  * soltarse; si se mantiene, se registra una pulsación larga y al soltarla no se
+  * registra ninguna corta.
   */
  void debounceFSM_update(void) {
  
@@ -72,7 +95,8 @@
 		 if (delayRead(&delay)) {
 			 if (HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin) == GPIO_PIN_RESET) {
 				 FSM = BUTTON_DOWN;
-				 pushed = true; /**< Se registra que el botón fue presionado. */
+				 holdReported = false;
+				 delayInit(&holdDelay, longPress_ms);
 			 } else {
 				 FSM = BUTTON_UP;
 			 }
@@ -80,6 +104,17 @@
 		 break;
  
 	 case BUTTON_DOWN:
+		 if (HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin) == GPIO_PIN_SET) {
+			 FSM = BUTTON_RAISING;
+			 delayInit(&delay, time_ms);
+		 } else if (delayRead(&holdDelay)) {
+			 FSM = BUTTON_PRESSING;
+			 holdReported = true;
+			 longPushed = true; /**< Se registra la pulsación larga sin esperar a que se suelte. */
+		 }
+		 break;
+ 
+	 case BUTTON_PRESSING:
 		 if (HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin) == GPIO_PIN_SET) {
 			 FSM = BUTTON_RAISING;
 			 delayInit(&delay, time_ms);
@@ -89,9 +124,12 @@
 	 case BUTTON_RAISING:
 		 if (delayRead(&delay)) {
 			 if (HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin) == GPIO_PIN_SET) {
+				 if (!holdReported) {
+					 pushed = true; /**< Se registra la pulsación corta al soltar el botón. */
+				 }
 				 FSM = BUTTON_UP;
 			 } else {
-				 FSM = BUTTON_DOWN;
+				 FSM = holdReported ? BUTTON_PRESSING : BUTTON_DOWN;
 			 }
 		 }
 		 break;
@@ -110,6 +148,7 @@
   * @return true si se detecto una pulsacion, false en caso contrario.
   *
   * Devuelve true solo una vez por pulsación detectada. Y cuando se lee la variable se torna a false.
+  * La pulsación corta se registra al soltar el botón, para distinguirla de una larga.
   */
  bool_t readPushed(){
  
@@ -123,3 +162,22 @@
  
  }
  
+ /**
+  * @brief Verifica si el boton se mantuvo presionado el tiempo de una pulsacion larga.
+  *
+  * @return true si se detecto una pulsacion larga, false en caso contrario.
+  *
+  * Devuelve true solo una vez por pulsación larga, mientras el botón sigue presionado.
+  */
+ bool_t readLongPushed(){
+ 
+	 if(longPushed){
+		 longPushed = false;
+		 return true;
+	 }
+	 else{
+		 return false;
+	 }
+ 
+ }
+ 
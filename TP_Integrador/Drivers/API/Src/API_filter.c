@@ -0,0 +1,254 @@
+/**
+ * @file API_filter.c
+ * @brief Implementación de la cadena de filtros en punto fijo.
+ *
+ * Las distancias se llevan a Q16 (16 bits de fracción) al entrar al EMA y al Kalman;
+ * los productos por coeficientes Q15 se hacen en 64 bits, que el Cortex-M4 resuelve
+ * con SMULL. El Kalman usa una medición como unidad de tiempo, con el modelo de
+ * aceleración blanca discreta: Q = q * [1/4 1/2; 1/2 1].
+ */
+
+ #include "../../Drivers/API/Inc/API_filter.h"
+ #include <stddef.h>
+ #include <string.h>
+ 
+ #ifdef API_FILTER_BENCHMARK
+ #include "../../Drivers/API/Inc/API_cycles.h"
+ #endif
+ 
+ static uint16_t filterMedian(filter_t *filter, uint16_t distance);
+ static int32_t filterEma(filter_t *filter, int32_t x);
+ static int32_t filterKalman(filter_t *filter, int32_t z);
+ 
+ /**
+  * @brief Inicializa la cadena sin mediciones.
+  *
+  * @param[out] filter Puntero a la cadena.
+  * @param[in] config Configuración (se copia).
+  */
+ void filterInit(filter_t *filter, const filterConfig_t *config) {
+ 
+	 assert(filter != NULL);
+	 assert(config != NULL);
+	 assert(config->medianSize >= 1 && config->medianSize <= FILTER_MEDIAN_MAX && (config->medianSize & 1));
+	 assert(config->emaAlpha > 0 && config->emaAlpha <= FILTER_Q15_ONE);
+	 assert(config->maxDistance <= FILTER_DISTANCE_MAX);
+ 
+	 memset(filter, 0, sizeof(*filter));
+	 filter->config = *config;
+ }
+ 
+ /**
+  * @brief Descarta las mediciones anteriores, conservando la configuración y los contadores.
+  *
+  * @param[in,out] filter Puntero a la cadena.
+  */
+ void filterReset(filter_t *filter) {
+ 
+	 filter->windowCount = 0;
+	 filter->windowPos = 0;
+	 filter->started = false;
+	 filter->converged = false;
+	 filter->steady = 0;
+ }
+ 
+ /**
+  * @brief Pasa una medición por la cadena.
+  *
+  * @param[in,out] filter Puntero a la cadena.
+  * @param[in] distance Distancia medida [mm].
+  * @param[in] errorCode Código de error del sensor.
+  * @return true si la medición pasó la compuerta y la salida se actualizó.
+  */
+ bool filterUpdate(filter_t *filter, uint16_t distance, uint8_t errorCode) {
+ 
+	 const filterConfig_t *config = &filter->config;
+ 
+	 if (errorCode & config->errorMask) {
+		 filter->stats.rejectedError++;
+		 return false;
+	 }
+	 if (distance < config->minDistance || distance > config->maxDistance) {
+		 filter->stats.rejectedRange++;
+		 return false;
+	 }
+	 filter->stats.accepted++;
+ 
+	 int32_t x = (int32_t)filterMedian(filter, distance) << 16;
+ 
+	 if (!filter->started) {
+		 filter->ema = x;
+		 filter->position = x;
+		 filter->velocity = 0;
+		 filter->p00 = config->kalmanR;
+		 filter->p01 = 0;
+		 filter->p11 = config->kalmanR;
+		 filter->started = true;
+	 } else {
+		 if (config->emaAlpha < FILTER_Q15_ONE) x = filterEma(filter, x);
+		 if (config->kalman) x = filterKalman(filter, x);
+	 }
+ 
+	 //Redondeo a mm; el Kalman puede estimar una posición apenas negativa
+	 x = (x + 0x8000) >> 16;
+	 filter->value = (x < 0) ? 0 : (x > FILTER_DISTANCE_MAX) ? FILTER_DISTANCE_MAX : (uint16_t)x;
+ 
+	 return true;
+ }
+ 
+ /**
+  * @brief Devuelve la última salida de la cadena [mm].
+  *
+  * @param[in] filter Puntero a la cadena.
+  */
+ uint16_t filterValue(const filter_t *filter) {
+	 return filter->value;
+ }
+ 
+ /**
+  * @brief Devuelve los contadores de la cadena.
+  *
+  * @param[in] filter Puntero a la cadena.
+  */
+ filterStats_t filterGetStats(const filter_t *filter) {
+	 return filter->stats;
+ }
+ 
+ /**
+  * @brief Agrega una medición a la ventana y devuelve su mediana.
+  *
+  * La ventana se mantiene ordenada: sale la medición más antigua y entra la nueva
+  * desplazando a lo sumo medianSize valores. Hasta llenar la ventana se toma la
+  * mediana de las mediciones que hay.
+  */
+ static uint16_t filterMedian(filter_t *filter, uint16_t distance) {
+ 
+	 uint8_t size = filter->config.medianSize;
+	 uint8_t count = filter->windowCount;
+	 uint16_t *sorted = filter->sorted;
+ 
+	 if (size == 1) return distance;
+ 
+	 if (count == size) {
+		 //Se quita la medición más antigua de la ventana ordenada
+		 uint16_t oldest = filter->window[filter->windowPos];
+		 uint8_t i = 0;
+		 while (sorted[i] != oldest) i++;
+		 for (; i + 1 < count; i++) sorted[i] = sorted[i + 1];
+		 count--;
+	 }
+ 
+	 uint8_t i = count;
+	 while (i > 0 && sorted[i - 1] > distance) {
+		 sorted[i] = sorted[i - 1];
+		 i--;
+	 }
+	 sorted[i] = distance;
+	 count++;
+ 
+	 filter->window[filter->windowPos] = distance;
+	 filter->windowPos = (filter->windowPos + 1 == size) ? 0 : filter->windowPos + 1;
+	 filter->windowCount = count;
+ 
+	 return sorted[count / 2];
+ }
+ 
+ /**
+  * @brief Promedio móvil exponencial: ema += alpha * (x - ema).
+  */
+ static int32_t filterEma(filter_t *filter, int32_t x) {
+ 
+	 filter->ema += (int32_t)(((int64_t)filter->config.emaAlpha * (x - filter->ema)) >> 15);
+	 return filter->ema;
+ }
+ 
+ /**
+  * @brief Predicción y corrección del Kalman de velocidad constante con la medición z (Q16).
+  *
+  * Las ganancias dependen solo de la covarianza, que no depende de las mediciones:
+  * cuando durante FILTER_KALMAN_STEADY pasos cambian a lo sumo un LSB se dejan de
+  * actualizar covarianza y ganancias, y cada paso cuesta dos productos. En punto fijo
+  * la covarianza no llega a un punto fijo exacto (el truncamiento hace oscilar las
+  * ganancias en un LSB), por lo que se admite esa diferencia.
+  */
+ static int32_t filterKalman(filter_t *filter, int32_t z) {
+ 
+	 filter->position += filter->velocity;
+ 
+	 if (!filter->converged) {
+		 int64_t q = filter->config.kalmanQ;
+		 int64_t s;
+		 int32_t k0, k1;
+ 
+		 filter->p00 += 2 * filter->p01 + filter->p11 + q / 4;
+		 filter->p01 += filter->p11 + q / 2;
+		 filter->p11 += q;
+ 
+		 s = filter->p00 + filter->config.kalmanR;
+		 k0 = (int32_t)(filter->p00 * 32768 / s);
+		 k1 = (int32_t)(filter->p01 * 32768 / s);
+ 
+		 //P = (I - K H) P, con la covarianza de posición y velocidad anterior
+		 filter->p11 -= (k1 * filter->p01) >> 15;
+		 filter->p01 -= (k0 * filter->p01) >> 15;
+		 filter->p00 -= (k0 * filter->p00) >> 15;
+ 
+		 bool same = (k0 - filter->k0 <= 1 && filter->k0 - k0 <= 1 && k1 - filter->k1 <= 1 && filter->k1 - k1 <= 1);
+		 filter->steady = same ? filter->steady + 1 : 0;
+		 filter->converged = (filter->steady >= FILTER_KALMAN_STEADY);
+		 filter->k0 = k0;
+		 filter->k1 = k1;
+	 }
+ 
+	 int64_t innovation = (int64_t)z - filter->position;
+	 filter->position += (int32_t)((filter->k0 * innovation) >> 15);
+	 filter->velocity += (int32_t)((filter->k1 * innovation) >> 15);
+ 
+	 return filter->position;
+ }
+ 
+ #ifdef API_FILTER_BENCHMARK
+ 
+ /**
+  * @brief Mide los ciclos de CPU de la cadena agregando una etapa por vez.
+  *
+  * Filtra una rampa con ruido pseudoaleatorio, picos y errores con cada configuración
+  * y acumula los ciclos del DWT. Pensado para inspeccionar el resultado desde el
+  * depurador.
+  *
+  * @param result Resultado de la medición.
+  * @param samples Mediciones filtradas con cada configuración.
+  */
+ void filterBenchmark(filterBenchmark_t *result, uint32_t samples) {
+ 
+	 filterConfig_t config = FILTER_CONFIG_DEFAULT;
+	 filter_t filter;
+ 
+	 if (result == NULL) return;
+ 
+	 uint32_t *cycles[] = { &result->gateCycles, &result->medianCycles, &result->emaCycles, &result->kalmanCycles };
+ 
+	 cyclesInit();
+	 result->samples = samples;
+ 
+	 for (uint8_t stages = 0; stages < 4; stages++) {
+		 uint32_t seed = 1;
+ 
+		 config.medianSize = (stages >= 1) ? 5 : 1;
+		 config.emaAlpha = (stages >= 2) ? FILTER_Q15(0.25) : FILTER_Q15_ONE;
+		 config.kalman = (stages >= 3);
+		 filterInit(&filter, &config);
+ 
+		 uint32_t start = cyclesNow();
+		 for (uint32_t i = 0; i < samples; i++) {
+			 seed = seed * 1664525u + 1013904223u;
+			 uint16_t distance = (uint16_t)(500 + (i % 1000) + (seed >> 28));
+			 uint8_t error = ((seed >> 20) & 0x3F) == 0 ? 0x02 : 0;
+			 if (((seed >> 14) & 0x3F) == 0) distance += 400;
+			 filterUpdate(&filter, distance, error);
+		 }
+		 *cycles[stages] = cyclesNow() - start;
+	 }
+ }
+ 
+ #endif /* API_FILTER_BENCHMARK */
@@ -0,0 +1,118 @@
+/**
+ * @file API_ring.c
+ * @brief Implementación del buffer circular de un productor y un consumidor.
+ *
+ * El productor solo escribe head y overflows y el consumidor solo escribe tail, por
+ * lo que no hacen falta secciones críticas: basta con el orden de memoria de los
+ * índices (acquire al leer el del otro lado, release al publicar el propio).
+ */
+
+ #include "../../Drivers/API/Inc/API_ring.h"
+ #include <stddef.h>
+ 
+ /**
+  * @brief Inicializa un buffer circular vacío.
+  *
+  * @param[out] ring Puntero al buffer circular.
+  * @param[in] buffer Memoria del buffer.
+  * @param[in] size Tamaño de la memoria en bytes (potencia de dos).
+  */
+ void ringInit(ring_t *ring, uint8_t *buffer, uint32_t size) {
+ 
+	 assert(ring != NULL);
+	 assert(buffer != NULL);
+	 assert(size > 0 && (size & (size - 1)) == 0);
+ 
+	 ring->buffer = buffer;
+	 ring->mask = size - 1;
+	 atomic_init(&ring->overflows, 0);
+	 atomic_init(&ring->head, 0);
+	 atomic_init(&ring->tail, 0);
+ }
+ 
+ /**
+  * @brief Agrega un byte (lado productor).
+  *
+  * @param[in,out] ring Puntero al buffer circular.
+  * @param[in] byte Byte a agregar.
+  * @return true si se agregó, false si el buffer estaba lleno.
+  */
+ bool ringPut(ring_t *ring, uint8_t byte) {
+ 
+	 return ringWrite(ring, &byte, 1) == 1;
+ }
+ 
+ /**
+  * @brief Agrega varios bytes con una sola publicación (lado productor).
+  *
+  * @param[in,out] ring Puntero al buffer circular.
+  * @param[in] data Bytes a agregar.
+  * @param[in] length Cantidad de bytes.
+  * @return Bytes agregados.
+  */
+ uint32_t ringWrite(ring_t *ring, const uint8_t *data, uint32_t length) {
+ 
+	 uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	 uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	 uint32_t space = ring->mask + 1 - (head - tail);
+	 uint32_t count = (length < space) ? length : space;
+ 
+	 for (uint32_t i = 0; i < count; i++) {
+		 ring->buffer[(head + i) & ring->mask] = data[i];
+	 }
+ 
+	 //Los bytes quedan visibles para el consumidor recién al publicar head
+	 atomic_store_explicit(&ring->head, head + count, memory_order_release);
+	 if (count < length) {
+		 atomic_store_explicit(&ring->overflows, atomic_load_explicit(&ring->overflows, memory_order_relaxed) + (length - count), memory_order_relaxed);
+	 }
+ 
+	 return count;
+ }
+ 
+ /**
+  * @brief Extrae el byte más antiguo (lado consumidor).
+  *
+  * @param[in,out] ring Puntero al buffer circular.
+  * @param[out] byte Byte extraído.
+  * @return true si había un byte, false si el buffer estaba vacío.
+  */
+ bool ringGet(ring_t *ring, uint8_t *byte) {
+ 
+	 uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	 uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+ 
+	 if (head == tail) {
+		 return false;
+	 }
+ 
+	 *byte = ring->buffer[tail & ring->mask];
+ 
+	 //La posición se libera para el productor recién después de leer el byte
+	 atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+ 
+	 return true;
+ }
+ 
+ /**
+  * @brief Devuelve la cantidad de bytes disponibles para el consumidor.
+  *
+  * @param[in] ring Puntero al buffer circular.
+  */
+ uint32_t ringCount(ring_t *ring) {
+ 
+	 uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	 uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+ 
+	 return head - tail;
+ }
+ 
+ /**
+  * @brief Devuelve los bytes descartados por buffer lleno desde la inicialización.
+  *
+  * @param[in] ring Puntero al buffer circular.
+  */
+ uint32_t ringOverflows(const ring_t *ring) {
+ 
+	 return atomic_load_explicit(&ring->overflows, memory_order_relaxed);
+ }
@@ -0,0 +1,55 @@
+/**
+ * @file API_stack.c
+ * @brief Implementación de la medición de pila libre por marca de agua.
+ *
+ */
+
+ #include "../../Drivers/API/Inc/API_stack.h"
+ #include "stm32f4xx.h"
+ 
+ /// @brief Patrón con el que se llena la pila sin usar.
+ #define STACK_PATTERN       0xC5C5C5C5u
+ 
+ /// @brief Bytes por debajo de la pila en uso que no se pintan (margen para las llamadas en curso).
+ #define STACK_PAINT_MARGIN  64u
+ 
+ extern uint8_t _estack;          /* Definido en el script del linker */
+ extern uint32_t _Min_Stack_Size; /* Definido en el script del linker */
+ 
+ /**
+  * @brief Devuelve el límite inferior de la zona reservada de pila.
+  */
+ static uint32_t* stackLimit(void){
+     return (uint32_t*)((uintptr_t)&_estack - (uintptr_t)&_Min_Stack_Size);
+ }
+ 
+ /**
+  * @brief Llena con el patrón la zona reservada de pila que está por debajo de la pila en uso.
+  */
+ void stackPaint(void){
+ 
+     uint32_t* word = stackLimit();
+     uint32_t* top = (uint32_t*)(uintptr_t)((__get_MSP() - STACK_PAINT_MARGIN) & ~3u);
+ 
+     while (word < top) {
+         *word++ = STACK_PATTERN;
+     }
+ }
+ 
+ /**
+  * @brief Devuelve los bytes de la zona reservada de pila que nunca se usaron.
+  *
+  * @return Bytes libres desde el límite inferior de la zona.
+  */
+ uint32_t stackFree(void){
+ 
+     const uint32_t* limit = stackLimit();
+     const uint32_t* word = limit;
+     const uint32_t* end = (const uint32_t*)&_estack;
+ 
+     while (word < end && *word == STACK_PATTERN) {
+         word++;
+     }
+ 
+     return (uint32_t)(word - limit) * sizeof(uint32_t);
+ }
@@ -0,0 +1,306 @@
+/**
+ * @file API_stats.c
+ * @brief Implementación de las estadísticas de ventana deslizante.
+ *
+ * Media y varianza salen de la recurrencia de Welford escalada por la cantidad n de
+ * mediciones: se guardan la suma S (media = S / n) y T = n * M2, ambas enteras, por
+ * lo que la actualización es exacta y no acumula redondeo. Al quitar la medición old
+ * y agregar x en un solo paso M2 cambia en (x - old) * (x - media nueva + old - media
+ * anterior), y T en (x - old) * (n x - S nueva + n old - S anterior). Con mediciones
+ * de hasta 65535 mm y 128 en la ventana T no supera 2^44.
+ */
+
+ #include "../../Drivers/API/Inc/API_stats.h"
+ #include <stddef.h>
+ #include <string.h>
+ 
+ #ifdef API_STATS_BENCHMARK
+ #include "../../Drivers/API/Inc/API_cycles.h"
+ #endif
+ 
+ static void statsDequePush(statsDeque_t *deque, uint16_t value, uint16_t seq, bool keepMin);
+ static void statsDequeExpire(statsDeque_t *deque, uint16_t seq, uint16_t window);
+ static uint8_t statsBin(const stats_t *stats, uint16_t value);
+ static uint32_t statsRankValue(const stats_t *stats, uint16_t rank);
+ static uint32_t statsSqrt(uint64_t x);
+ 
+ /**
+  * @brief Inicializa las estadísticas sin mediciones.
+  *
+  * @param[out] stats Puntero a las estadísticas.
+  * @param[in] config Configuración (se copia).
+  */
+ void statsInit(stats_t *stats, const statsConfig_t *config) {
+ 
+	 assert(stats != NULL);
+	 assert(config != NULL);
+	 assert(config->window >= 1 && config->window <= STATS_WINDOW_MAX);
+	 assert(config->binWidth > 0);
+ 
+	 memset(stats, 0, sizeof(*stats));
+	 stats->config = *config;
+ }
+ 
+ /**
+  * @brief Descarta las mediciones de la ventana, conservando la configuración.
+  *
+  * @param[in,out] stats Puntero a las estadísticas.
+  */
+ void statsReset(stats_t *stats) {
+ 
+	 statsConfig_t config = stats->config;
+ 
+	 memset(stats, 0, sizeof(*stats));
+	 stats->config = config;
+ }
+ 
+ /**
+  * @brief Agrega una medición a la ventana; si está llena sale la más antigua.
+  *
+  * @param[in,out] stats Puntero a las estadísticas.
+  * @param[in] value Medición [mm].
+  */
+ void statsUpdate(stats_t *stats, uint16_t value) {
+ 
+	 uint16_t window = stats->config.window;
+	 int64_t x = value;
+	 int64_t sum = stats->sum;
+ 
+	 statsDequeExpire(&stats->minDeque, stats->seq, window);
+	 statsDequeExpire(&stats->maxDeque, stats->seq, window);
+	 statsDequePush(&stats->minDeque, value, stats->seq, true);
+	 statsDequePush(&stats->maxDeque, value, stats->seq, false);
+	 stats->seq++;
+ 
+	 if (stats->count < window) {
+		 //La ventana crece: M2 += (x - S / (n - 1)) * (x - (S + x) / n), con T = n * M2
+		 int64_t n = ++stats->count;
+		 if (n > 1) stats->scaledM2 = (n * stats->scaledM2 + ((n - 1) * x - sum) * (n * x - sum - x)) / (n - 1);
+		 stats->sum += value;
+	 } else {
+		 //La medición nueva reemplaza a la más antigua
+		 uint16_t oldest = stats->window[stats->pos];
+		 int64_t old = oldest;
+		 int64_t n = window;
+		 stats->scaledM2 += (x - old) * ((n * x - (sum + x - old)) + (n * old - sum));
+		 stats->sum += (uint32_t)value - oldest;
+		 stats->bins[statsBin(stats, oldest)]--;
+	 }
+ 
+	 stats->window[stats->pos] = value;
+	 stats->bins[statsBin(stats, value)]++;
+	 stats->pos = (stats->pos + 1 == window) ? 0 : stats->pos + 1;
+ }
+ 
+ /**
+  * @brief Devuelve la cantidad de mediciones en la ventana.
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ uint16_t statsCount(const stats_t *stats) {
+	 return stats->count;
+ }
+ 
+ /**
+  * @brief Devuelve el mínimo de la ventana [mm].
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ uint16_t statsMin(const stats_t *stats) {
+	 return (stats->count == 0) ? 0 : stats->minDeque.entries[stats->minDeque.head].value;
+ }
+ 
+ /**
+  * @brief Devuelve el máximo de la ventana [mm].
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ uint16_t statsMax(const stats_t *stats) {
+	 return (stats->count == 0) ? 0 : stats->maxDeque.entries[stats->maxDeque.head].value;
+ }
+ 
+ /**
+  * @brief Devuelve un percentil de la ventana aproximado por el histograma [mm].
+  *
+  * El percentil está en la posición percent * (count - 1) / 100 de las mediciones
+  * ordenadas: se estiman por el histograma las dos mediciones que la rodean y se
+  * interpola entre ellas con la parte fraccionaria de la posición (en Q8).
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  * @param[in] percent Percentil (0 a 100).
+  */
+ uint16_t statsPercentile(const stats_t *stats, uint8_t percent) {
+ 
+	 if (stats->count == 0) return 0;
+	 if (percent > 100) percent = 100;
+ 
+	 uint32_t position = (((uint32_t)percent * (stats->count - 1)) << 8) / 100;
+	 uint16_t rank = (uint16_t)(position >> 8);
+	 uint32_t fraction = position & 0xFF;
+	 uint32_t value = statsRankValue(stats, rank);
+ 
+	 if (fraction != 0) {
+		 uint32_t next = statsRankValue(stats, rank + 1);
+		 value += ((next - value) * fraction + 128) >> 8;
+	 }
+ 
+	 uint16_t min = statsMin(stats);
+	 uint16_t max = statsMax(stats);
+ 
+	 return (value < min) ? min : (value > max) ? max : (uint16_t)value;
+ }
+ 
+ /**
+  * @brief Devuelve el resumen de la ventana.
+  *
+  * @param[in] stats Puntero a las estadísticas.
+  */
+ statsSummary_t statsGetSummary(const stats_t *stats) {
+ 
+	 statsSummary_t summary = {0};
+ 
+	 if (stats->count == 0) return summary;
+ 
+	 summary.count = stats->count;
+	 summary.min = statsMin(stats);
+	 summary.max = statsMax(stats);
+	 summary.meanTenths = (uint32_t)(((uint64_t)stats->sum * 10 + stats->count / 2) / stats->count);
+	 if (stats->count > 1) {
+		 //Varianza de la muestra, T / (n (n - 1)), en Q16: su raíz queda en Q8
+		 uint64_t variance = ((uint64_t)stats->scaledM2 << 16) / ((uint32_t)stats->count * (stats->count - 1));
+		 summary.stddevTenths = (uint32_t)(((uint64_t)statsSqrt(variance) * 10 + 128) >> 8);
+	 }
+	 summary.median = statsPercentile(stats, 50);
+	 summary.p95 = statsPercentile(stats, 95);
+ 
+	 return summary;
+ }
+ 
+ /**
+  * @brief Agrega una medición al final de una cola monótona.
+  *
+  * Antes se quitan del final las mediciones que ya no pueden ser el extremo mientras
+  * la nueva esté en la ventana: las mayores o iguales para el mínimo y las menores o
+  * iguales para el máximo.
+  */
+ static void statsDequePush(statsDeque_t *deque, uint16_t value, uint16_t seq, bool keepMin) {
+ 
+	 while (deque->len > 0) {
+		 uint16_t last = deque->entries[(deque->head + deque->len - 1) % STATS_WINDOW_MAX].value;
+		 if (keepMin ? (last < value) : (last > value)) break;
+		 deque->len--;
+	 }
+ 
+	 deque->entries[(deque->head + deque->len) % STATS_WINDOW_MAX] = (statsDequeEntry_t){ value, seq };
+	 deque->len++;
+ }
+ 
+ /**
+  * @brief Quita del comienzo de una cola las mediciones que salen de la ventana al entrar la medición seq.
+  */
+ static void statsDequeExpire(statsDeque_t *deque, uint16_t seq, uint16_t window) {
+ 
+	 while (deque->len > 0 && (uint16_t)(seq - deque->entries[deque->head].seq) >= window) {
+		 deque->head = (deque->head + 1) % STATS_WINDOW_MAX;
+		 deque->len--;
+	 }
+ }
+ 
+ /**
+  * @brief Intervalo del histograma de una medición.
+  */
+ static uint8_t statsBin(const stats_t *stats, uint16_t value) {
+ 
+	 if (value < stats->config.binOrigin) return 0;
+ 
+	 uint32_t bin = (uint32_t)(value - stats->config.binOrigin) / stats->config.binWidth;
+	 return (bin >= STATS_BINS) ? STATS_BINS - 1 : (uint8_t)bin;
+ }
+ 
+ /**
+  * @brief Estima por el histograma la medición que ocupa la posición rank (desde 0) entre las ordenadas.
+  *
+  * Las mediciones de cada intervalo se suponen repartidas de manera uniforme: la k-ésima
+  * de las n de un intervalo está a (k + 1/2) / n de su ancho.
+  */
+ static uint32_t statsRankValue(const stats_t *stats, uint16_t rank) {
+ 
+	 uint32_t width = stats->config.binWidth;
+	 uint16_t before = 0;
+	 uint8_t bin = 0;
+ 
+	 while (bin < STATS_BINS - 1 && before + stats->bins[bin] <= rank) {
+		 before += stats->bins[bin];
+		 bin++;
+	 }
+ 
+	 uint32_t offset = (stats->bins[bin] == 0) ? 0 : ((2u * (rank - before) + 1) * width) / (2u * stats->bins[bin]);
+	 return stats->config.binOrigin + bin * width + offset;
+ }
+ 
+ /**
+  * @brief Raíz cuadrada entera (truncada), bit por bit.
+  */
+ static uint32_t statsSqrt(uint64_t x) {
+ 
+	 uint64_t root = 0;
+	 uint64_t bit = (uint64_t)1 << 62;
+ 
+	 while (bit > x) bit >>= 2;
+ 
+	 while (bit != 0) {
+		 if (x >= root + bit) {
+			 x -= root + bit;
+			 root = (root >> 1) + bit;
+		 } else {
+			 root >>= 1;
+		 }
+		 bit >>= 2;
+	 }
+ 
+	 return (uint32_t)root;
+ }
+ 
+ #ifdef API_STATS_BENCHMARK
+ 
+ /**
+  * @brief Mide los ciclos de CPU de statsUpdate() y statsGetSummary().
+  *
+  * Agrega una rampa con ruido pseudoaleatorio a una ventana de STATS_WINDOW_MAX
+  * mediciones y acumula los ciclos del DWT de cada llamada. Pensado para inspeccionar
+  * el resultado desde el depurador.
+  *
+  * @param result Resultado de la medición.
+  * @param samples Mediciones agregadas.
+  */
+ void statsBenchmark(statsBenchmark_t *result, uint32_t samples) {
+ 
+	 statsConfig_t config = STATS_CONFIG_DEFAULT;
+	 stats_t stats;
+	 uint32_t seed = 1;
+ 
+	 if (result == NULL) return;
+ 
+	 cyclesInit();
+	 statsInit(&stats, &config);
+	 *result = (statsBenchmark_t){ .samples = samples };
+ 
+	 for (uint32_t i = 0; i < samples; i++) {
+		 seed = seed * 1664525u + 1013904223u;
+		 uint16_t value = (uint16_t)(500 + (i % 1000) + (seed >> 26));
+ 
+		 uint32_t start = cyclesNow();
+		 statsUpdate(&stats, value);
+		 uint32_t cycles = cyclesNow() - start;
+ 
+		 result->updateCycles += cycles;
+		 if (cycles > result->maxUpdateCycles) result->maxUpdateCycles = cycles;
+	 }
+ 
+	 uint32_t start = cyclesNow();
+	 volatile statsSummary_t summary = statsGetSummary(&stats);
+	 result->summaryCycles = cyclesNow() - start;
+	 (void)summary;
+ }
+ 
+ #endif /* API_STATS_BENCHMARK */
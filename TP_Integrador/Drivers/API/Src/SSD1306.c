@@ -22,7 +22,6 @@
  #include "../../Drivers/API/Inc/SSD1306_Port.h"
  #include "../../Drivers/API/Inc/font.h"
  #include <stdlib.h>
- #include <stdio.h>
  
  /**
   * @name Definiciones de comandos de trama y configuraciones para el SSD1306
@@ -35,18 +34,22 @@
  /// @brief Código de control para enviar datos al SSD1306.
  #define SSD1306_DATA           		0x40
  
- /// @brief Longitud máxima del buffer de impresión (22 caracteres por página).
- #define BUFFER_TO_PRINT_LENGTH		22
- 
  /// @brief Configuración del divisor de reloj del display.
  #define CLOCK_DIV_CONFIG			0x80
  
- /// @brief Configuración de la proporción de multiplexado.
+ /// @brief Configuración de la proporción de multiplexado (64 filas; se ajusta a la altura del panel).
  #define MULTIPLEX_RATIO_CONFIG		0x3F
  
- /// @brief Configuración de pines COM (hardware interno del display).
+ /// @brief Configuración de pines COM (hardware interno del display): alternada para 64 filas.
  #define COMM_PIN_CONFIG 			0x12
  
+ /// @brief Configuración de pines COM secuencial, para paneles de 32 y 16 filas.
+ #define COMM_PIN_CONFIG_SEQUENTIAL	0x02
+ 
+ /// @brief Posición en la secuencia de inicialización de los argumentos que dependen de la altura.
+ #define INIT_MULTIPLEX_ARG			4
+ #define INIT_COM_PINS_ARG			15
+ 
  /// @brief Configuración del nivel de contraste inicial.
  #define CONTRAST_CONFIG				0x7F
  
@@ -56,6 +59,18 @@
  /// @brief Dirección base para el modo de direccionamiento por páginas.
  #define PAGE_ADDRESSING				0xB0
  
+ /// @brief Valor de MEMORY_ADDR_MODE para el modo de direccionamiento horizontal.
+ #define HORIZONTAL_ADDRESSING		0x00
+ 
+ /// @brief Marca de página sin cambios pendientes (start > end).
+ #define DIRTY_CLEAN_START			0xFF
+ 
+ /// @brief Bytes de bus que agrega cada segmento: ventana (6 comandos) y los bytes de control de sus dos transacciones.
+ #define SEGMENT_OVERHEAD_BYTES		(6 + 2 * SSD1306_PORT_CONTROL_BYTES)
+ 
+ /// @brief Costo en bits de bus de abrir un segmento, según el transporte (START, dirección y STOP incluidos).
+ #define SEGMENT_OVERHEAD_BITS		(2 * SSD1306_PORT_FRAME_BITS + SEGMENT_OVERHEAD_BYTES * SSD1306_PORT_BYTE_BITS)
+ 
  /** @} */
  
  
@@ -76,6 +91,8 @@
      SSD1306_CMD_SCROLL_LEFT             = 0x27,
      SSD1306_CMD_SCROLL_VERTICAL_RIGHT   = 0x29,
      SSD1306_CMD_SCROLL_VERTICAL_LEFT    = 0x2A,
+     SSD1306_CMD_CONTENT_SCROLL_RIGHT    = 0x2C,
+     SSD1306_CMD_CONTENT_SCROLL_LEFT     = 0x2D,
      SSD1306_CMD_DEACTIVATE_SCROLL       = 0x2E,
      SSD1306_CMD_ACTIVATE_SCROLL        	= 0x2F,
      SSD1306_CMD_SET_VERTICAL_SCROLL_AREA = 0xA3,
@@ -105,268 +122,1107 @@
  
  } SSD1306_Command;
  
- void SSD1306_SendCommand(uint8_t command);
- void SSD1306_SendData(uint8_t* data, size_t size);
- void SSD1306_SetCursor(uint8_t x, uint8_t page);
+ 
+ /**
+  * @brief Secuencia de inicialización del display, almacenada en flash.
+  *
+  * Se envía completa en una única transacción precedida por un solo byte de control.
+  * Los argumentos de multiplexado y pines COM corresponden a un panel de 64 filas;
+  * SSD1306_Init() los ajusta a la altura de cada panel sobre una copia en RAM.
+  */
+ static const uint8_t SSD1306_InitSequence[] = {
+     SSD1306_CMD_DISPLAY_OFF,
+     SSD1306_CMD_SET_DISPLAY_CLOCK_DIV,  CLOCK_DIV_CONFIG,
+     SSD1306_CMD_SET_MULTIPLEX_RATIO,    MULTIPLEX_RATIO_CONFIG,
+     SSD1306_CMD_SET_DISPLAY_OFFSET,     0x00,
+     SSD1306_CMD_SET_START_LINE,
+     SSD1306_CMD_CHARGE_PUMP,            SSD1306_CMD_ENA_CHARGE_PUMP,
+     SSD1306_CMD_MEMORY_ADDR_MODE,       HORIZONTAL_ADDRESSING,
+     SSD1306_CMD_SET_SEGMENT_REMAP_1,
+     SSD1306_CMD_COM_SCAN_DEC,
+     SSD1306_CMD_SET_COM_PINS,           COMM_PIN_CONFIG,
+     SSD1306_CMD_SET_CONTRAST,           CONTRAST_CONFIG,
+     SSD1306_CMD_SET_PRECHARGE,          PRECHARGE_CONFIG,
+     SSD1306_CMD_SET_VCOM_DESELECT,      SSD1306_CMD_SET_START_LINE,
+     SSD1306_CMD_ENTIRE_DISPLAY_RESUME,
+     SSD1306_CMD_SET_NORMAL_DISPLAY,
+     SSD1306_CMD_DISPLAY_ON
+ };
+ 
+ /// @brief Datos en cero para toda la pantalla más grande soportada (1024 bytes en flash).
+ static const uint8_t SSD1306_ZeroFrame[SSD1306_WIDTH * SSD1306_PAGES] = { 0 };
+ 
+ void SSD1306_SendCommand(SSD1306_t* dev, uint8_t command);
+ void SSD1306_SendData(SSD1306_t* dev, uint8_t* data, size_t size);
+ void SSD1306_SetCursor(SSD1306_t* dev, uint8_t x, uint8_t page);
+ void SSD1306_SetWindow(SSD1306_t* dev, uint8_t colStart, uint8_t colEnd, uint8_t pageStart, uint8_t pageEnd);
+ static void SSD1306_WaitIdle(const SSD1306_t* dev);
+ static void SSD1306_BusStart(SSD1306_Bus_t* bus, SSD1306_t* dev);
+ static void SSD1306_StartTransfer(SSD1306_t* dev);
+ void SSD1306_TxCpltCallback(SSD1306_Bus_t* bus);
+ static void SSD1306_ResetDirty(SSD1306_t* dev);
+ static void SSD1306_DiffPage(const SSD1306_t* dev, uint8_t page, uint8_t start, uint8_t end, uint32_t* mask);
+ static uint8_t SSD1306_PlanPage(const uint32_t* mask, uint8_t start, uint8_t end, SSD1306_Dirty_t* spans);
+ static void SSD1306_AddSpan(SSD1306_t* dev, uint8_t page, uint8_t start, uint8_t end);
+ static void SSD1306_MergeSegments(SSD1306_t* dev);
+ static uint16_t SSD1306_SegmentArea(const SSD1306_Segment_t* seg);
+ static void SSD1306_WriteBuffer(SSD1306_t* dev, uint8_t page, uint8_t column, const uint8_t* data, uint8_t size);
+ static void SSD1306_ShiftDirty(SSD1306_t* dev, uint8_t page, uint8_t colStart, uint8_t colEnd);
+ static uint8_t SSD1306_RenderText(uint8_t* row, uint8_t width, const char* str, SSD1306_Align_t align);
  
  /**
   * @brief Envía un comando al display OLED SSD1306.
   *
+  * @param dev Instancia del display.
   * @param command Código del comando a enviar.
   *
   * @note El comando se envía utilizando la función de transmisión I2C.
   */
- void SSD1306_SendCommand(uint8_t command) {
+ void SSD1306_SendCommand(SSD1306_t* dev, uint8_t command) {
+ 
+     SSD1306_WaitIdle(dev);
+     SSD1306_I2C_Transmit(dev->bus, dev->address, SSD1306_COMMAND, &command, 1);
+ 
+ }
+ 
+ /**
+  * @brief Envía una secuencia de comandos al display en una sola transacción.
+  *
+  * @param dev Instancia del display.
+  * @param commands Puntero a los bytes de comando (puede residir en flash).
+  * @param size Cantidad de bytes de comando.
+  *
+  * @note Se antepone un único byte de control de comando a toda la secuencia.
+  */
+ void SSD1306_SendCommandStream(SSD1306_t* dev, const uint8_t* commands, size_t size) {
  
-     uint8_t data[2];
-     data[0] = SSD1306_COMMAND;
-     data[1] = command;
+     assert(commands != NULL);
+     if (size == 0) return;
  
-     SSD1306_I2C_Transmit(data, 2);
+     SSD1306_WaitIdle(dev);
+     SSD1306_I2C_Transmit(dev->bus, dev->address, SSD1306_COMMAND, commands, size);
  
  }
  
  /**
   * @brief Envía un bloque de datos al display OLED SSD1306.
   *
+  * @param dev Instancia del display.
   * @param data Puntero a los datos a enviar.
   * @param size Cantidad de bytes a enviar.
   *
   * @note El primer byte enviado es un indicador de "datos", seguido por el bloque de datos real.
-  *       El tamaño máximo permitido es 128 bytes de datos + 1 byte de control.
+  *       Los datos se transmiten directamente desde el buffer recibido.
   */
- void SSD1306_SendData(uint8_t* data, size_t size) {
+ void SSD1306_SendData(SSD1306_t* dev, uint8_t* data, size_t size) {
  
-     //Se define un buffer con el ancho de pixeles del display + el byte de control
-     static uint8_t buffer[SSD1306_WIDTH + 1];
+     assert(data != NULL);
+     if (size == 0) return;
  
-     //Verificacion de longitud de datos a enviar
-     if (size + 1 > sizeof(buffer)) return;
+     SSD1306_WaitIdle(dev);
+     SSD1306_I2C_Transmit(dev->bus, dev->address, SSD1306_DATA, data, size);
  
+ }
+ 
+ /**
+  * @brief Inicializa un display OLED SSD1306 y lo agrega a su bus.
+  *
+  * @param dev Instancia a inicializar.
+  * @param bus Bus ya inicializado con SSD1306_Port_BusInit().
+  * @param address Dirección I2C de 7 bits.
+  * @param width Ancho del panel en píxeles (hasta SSD1306_WIDTH).
+  * @param height Alto del panel en píxeles: 16, 32 o 64.
+  *
+  * @note Envía la secuencia de arranque con el multiplexado y la configuración de
+  *       pines COM que corresponden a la altura del panel. Los buffers de la instancia
+  *       tienen el tamaño del panel más grande; un panel más chico usa solo una parte.
+  */
+ void SSD1306_Init(SSD1306_t* dev, SSD1306_Bus_t* bus, uint8_t address, uint8_t width, uint8_t height) {
+ 
+     assert(dev != NULL);
+     assert(bus != NULL);
+     assert(width > 0 && width <= SSD1306_WIDTH);
+     assert(height == 16 || height == 32 || height == 64);
+ 
+     uint8_t init[sizeof(SSD1306_InitSequence)];
+     SSD1306_t** link = &bus->devices;
+ 
+     dev->bus = bus;
+     dev->address = address;
+     dev->width = width;
+     dev->height = height;
+     dev->pages = height / 8;
+     dev->segmentCount = 0;
+     dev->segmentIndex = 0;
+     dev->windowPhase = false;
+     dev->flushBusy = false;
+     dev->cursorColumn = 0;
+     dev->cursorPage = 0;
+ 
+     memset(dev->framebuffer, 0x00, sizeof(dev->framebuffer));
+     memset(dev->shadow, 0x00, sizeof(dev->shadow));
+     memset(&dev->flushStats, 0, sizeof(dev->flushStats));
+     SSD1306_ResetDirty(dev);
+ 
+     //Se agrega el display al final de la lista del bus (una sola vez)
+     while (*link != NULL && *link != dev) link = &(*link)->next;
+     if (*link == NULL) {
+         dev->next = NULL;
+         *link = dev;
+     }
  
-     memset(buffer, 0, sizeof(buffer));
-     buffer[0] = SSD1306_DATA;
-     memcpy(&buffer[1], data, size);
+     memcpy(init, SSD1306_InitSequence, sizeof(init));
  
-     SSD1306_I2C_Transmit(buffer, size + 1);
+     assert(init[INIT_MULTIPLEX_ARG - 1] == SSD1306_CMD_SET_MULTIPLEX_RATIO);
+     assert(init[INIT_COM_PINS_ARG - 1] == SSD1306_CMD_SET_COM_PINS);
+ 
+     init[INIT_MULTIPLEX_ARG] = height - 1;
+     init[INIT_COM_PINS_ARG] = (height == 64) ? COMM_PIN_CONFIG : COMM_PIN_CONFIG_SEQUENTIAL;
+ 
+     SSD1306_SendCommandStream(dev, init, sizeof(init));
  
  }
  
  /**
-  * @brief Inicializa el display OLED SSD1306.
+  * @brief Limpia completamente el contenido del display OLED SSD1306.
+  *
+  * @param dev Instancia del display.
   *
-  * @note Configura el puerto I2C y envía la secuencia de comandos necesarios para el arranque del display.
+  * @note Se pone a cero el framebuffer y se escribe toda la GDDRAM del panel sin
+  *       importar su contenido previo: una transacción para la ventana completa y otra
+  *       con la trama en cero almacenada en flash.
   */
- void SSD1306_Init(void) {
+ void SSD1306_Clear(SSD1306_t* dev) {
  
+     uint8_t window[] = {
+         SSD1306_CMD_COLUMN_ADDR, 0, dev->width - 1,
+         SSD1306_CMD_PAGE_ADDR, 0, dev->pages - 1
+     };
  
-     SSD1306_SendCommand(SSD1306_CMD_DISPLAY_OFF);
-     SSD1306_SendCommand(SSD1306_CMD_SET_DISPLAY_CLOCK_DIV);
-     SSD1306_SendCommand(CLOCK_DIV_CONFIG);
+     SSD1306_WaitIdle(dev);
  
-     SSD1306_SendCommand(SSD1306_CMD_SET_MULTIPLEX_RATIO);
-     SSD1306_SendCommand(MULTIPLEX_RATIO_CONFIG);
+     memset(dev->framebuffer, 0x00, sizeof(dev->framebuffer));
+     memset(dev->shadow, 0x00, sizeof(dev->shadow));
+     SSD1306_ResetDirty(dev);
  
-     SSD1306_SendCommand(SSD1306_CMD_SET_DISPLAY_OFFSET);
-     SSD1306_SendCommand(SSD1306_CMD_SET_LOWER_COLUMN);
+     SSD1306_SendCommandStream(dev, window, sizeof(window));
+     SSD1306_I2C_Transmit(dev->bus, dev->address, SSD1306_DATA, SSD1306_ZeroFrame, dev->width * dev->pages);
+ }
  
-     SSD1306_SendCommand(SSD1306_CMD_SET_START_LINE);
+ /**
+  * @brief Reemplaza el contenido completo de la pantalla por una imagen en flash.
+  *
+  * @param dev Instancia del display.
+  * @param image Imagen del tamaño del panel.
+  *
+  * @note Como SSD1306_Clear(): una transacción para la ventana completa y otra con los
+  *       datos, que salen directamente de la flash. El framebuffer y la copia del panel
+  *       quedan con la imagen, de modo que el próximo SSD1306_Flush() solo envía lo que
+  *       se dibuje encima.
+  */
+ void SSD1306_LoadImage(SSD1306_t* dev, const SSD1306_Image_t* image) {
  
-     SSD1306_SendCommand(SSD1306_CMD_CHARGE_PUMP);
-     SSD1306_SendCommand(SSD1306_CMD_ENA_CHARGE_PUMP);
+     assert(image != NULL);
+     assert(image->width == dev->width && image->pages == dev->pages);
  
-     SSD1306_SendCommand(SSD1306_CMD_MEMORY_ADDR_MODE);
-     SSD1306_SendCommand(SSD1306_CMD_SET_LOWER_COLUMN);
+     uint8_t window[] = {
+         SSD1306_CMD_COLUMN_ADDR, 0, dev->width - 1,
+         SSD1306_CMD_PAGE_ADDR, 0, dev->pages - 1
+     };
  
-     SSD1306_SendCommand(SSD1306_CMD_SET_SEGMENT_REMAP_1);
-     SSD1306_SendCommand(SSD1306_CMD_COM_SCAN_DEC);
+     SSD1306_WaitIdle(dev);
  
-     SSD1306_SendCommand(SSD1306_CMD_SET_COM_PINS);
-     SSD1306_SendCommand(COMM_PIN_CONFIG);
-     SSD1306_SendCommand(SSD1306_CMD_SET_CONTRAST);
-     SSD1306_SendCommand(CONTRAST_CONFIG);
+     memset(dev->framebuffer, 0x00, sizeof(dev->framebuffer));
+     for (uint8_t page = 0; page < dev->pages; page++) {
+         memcpy(dev->framebuffer[page], &image->data[page * image->width], image->width);
+     }
+     memcpy(dev->shadow, dev->framebuffer, sizeof(dev->shadow));
+     SSD1306_ResetDirty(dev);
  
-     SSD1306_SendCommand(SSD1306_CMD_SET_PRECHARGE);
-     SSD1306_SendCommand(PRECHARGE_CONFIG);
+     SSD1306_SendCommandStream(dev, window, sizeof(window));
+     SSD1306_I2C_Transmit(dev->bus, dev->address, SSD1306_DATA, image->data, dev->width * dev->pages);
+ }
  
-     SSD1306_SendCommand(SSD1306_CMD_SET_VCOM_DESELECT);
-     SSD1306_SendCommand(SSD1306_CMD_SET_START_LINE);
-     SSD1306_SendCommand(SSD1306_CMD_ENTIRE_DISPLAY_RESUME);
-     SSD1306_SendCommand(SSD1306_CMD_SET_NORMAL_DISPLAY);
-     SSD1306_SendCommand(SSD1306_CMD_DISPLAY_ON);
+ /**
+  * @brief Marca todas las páginas del framebuffer como sin cambios pendientes.
+  */
+ static void SSD1306_ResetDirty(SSD1306_t* dev) {
  
+     for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+         dev->dirty[page].start = DIRTY_CLEAN_START;
+         dev->dirty[page].end = 0;
+     }
  }
  
  /**
-  * @brief Limpia completamente el contenido del display OLED SSD1306.
+  * @brief Envía al display únicamente las regiones modificadas del framebuffer.
+  *
+  * @param dev Instancia del display.
+  * @return true si la trama se envió (o se inició su envío), false si la trama
+  *         anterior todavía está en el bus; en ese caso los cambios quedan pendientes.
+  *
+  * @note Dentro del rango escrito de cada página se compara el framebuffer con la
+  *       copia de lo que ya tiene el panel, de a 4 bytes, y se obtiene el mapa de
+  *       columnas que realmente cambiaron. A partir de él se planifican las ventanas
+  *       COLUMN_ADDR/PAGE_ADDR (modo horizontal) con un modelo de costo del bus: un
+  *       hueco sin cambios se reenvía si cuesta menos que abrir otra ventana, y las
+  *       ventanas de páginas contiguas se unen en un rectángulo cuando las columnas
+  *       extra cuestan menos que la ventana que se ahorra, como ocurre con los glifos
+  *       de varias páginas. Cada segmento envía su contenido en una sola transacción.
+  *       Con SSD1306_USE_DMA la función retorna inmediatamente y los segmentos se
+  *       encadenan desde SSD1306_TxCpltCallback(), intercalados con los de los otros
+  *       displays del mismo bus.
+  */
+ bool SSD1306_Flush(SSD1306_t* dev) {
+ 
+     uint16_t offset = 0;
+     uint16_t total = 0;
+     uint32_t naive = 0;
+ 
+     if (dev->flushBusy) return false;
+ 
+     dev->segmentCount = 0;
+ 
+     for (uint8_t page = 0; page < dev->pages; page++) {
+ 
+         SSD1306_Dirty_t* range = &dev->dirty[page];
+         uint32_t mask[SSD1306_WIDTH / 32] = { 0 };
+         SSD1306_Dirty_t spans[SSD1306_MAX_PAGE_SPANS + 1];
+ 
+         if (range->start > range->end) continue;
+ 
+         uint8_t start = range->start;
+         uint8_t end = range->end;
+ 
+         range->start = DIRTY_CLEAN_START;
+         range->end = 0;
+ 
+         //Referencia: una ventana por página desde la primera hasta la última columna escrita
+         naive += (end - start + 1) + SEGMENT_OVERHEAD_BYTES;
+ 
+         SSD1306_DiffPage(dev, page, start, end, mask);
+ 
+         uint8_t count = SSD1306_PlanPage(mask, start, end, spans);
+         for (uint8_t i = 0; i < count; i++) {
+             SSD1306_AddSpan(dev, page, spans[i].start, spans[i].end);
+         }
+     }
+ 
+     dev->flushStats.naiveBytes += naive;
+ 
+     if (dev->segmentCount == 0) return true;
+ 
+     SSD1306_MergeSegments(dev);
+ 
+     for (uint8_t i = 0; i < dev->segmentCount; i++) {
+         total += SSD1306_SegmentArea(&dev->segments[i]);
+     }
+ 
+     //Si los rectángulos se superponen tanto que no entran en el front buffer, se envía uno que los contiene
+     if (total > sizeof(dev->frontbuffer)) {
+         SSD1306_Segment_t bounds = dev->segments[0];
+         for (uint8_t i = 1; i < dev->segmentCount; i++) {
+             SSD1306_Segment_t* seg = &dev->segments[i];
+             if (seg->start < bounds.start) bounds.start = seg->start;
+             if (seg->end > bounds.end) bounds.end = seg->end;
+             if (seg->pageStart < bounds.pageStart) bounds.pageStart = seg->pageStart;
+             if (seg->pageEnd > bounds.pageEnd) bounds.pageEnd = seg->pageEnd;
+         }
+         dev->segments[0] = bounds;
+         dev->segmentCount = 1;
+     }
+ 
+     for (uint8_t i = 0; i < dev->segmentCount; i++) {
+ 
+         SSD1306_Segment_t* seg = &dev->segments[i];
+         uint8_t width = seg->end - seg->start + 1;
+ 
+         seg->offset = offset;
+         for (uint8_t page = seg->pageStart; page <= seg->pageEnd; page++) {
+             memcpy(&dev->frontbuffer[offset], &dev->framebuffer[page][seg->start], width);
+             memcpy(&dev->shadow[page][seg->start], &dev->framebuffer[page][seg->start], width);
+             offset += width;
+         }
+         seg->size = offset - seg->offset;
+     }
+ 
+     dev->flushStats.frames++;
+     dev->flushStats.segments += dev->segmentCount;
+     dev->flushStats.plannedBytes += offset + (uint32_t)dev->segmentCount * SEGMENT_OVERHEAD_BYTES;
+ 
+ #if SSD1306_USE_DMA
+     dev->segmentIndex = 0;
+     dev->windowPhase = true;
+     dev->flushBusy = true;
+     SSD1306_BusStart(dev->bus, dev);
+ #else
+     for (uint8_t i = 0; i < dev->segmentCount; i++) {
+         SSD1306_Segment_t* seg = &dev->segments[i];
+         SSD1306_SetWindow(dev, seg->start, seg->end, seg->pageStart, seg->pageEnd);
+         SSD1306_SendData(dev, &dev->frontbuffer[seg->offset], seg->size);
+     }
+ #endif
+ 
+     return true;
+ }
+ 
+ /**
+  * @brief Marca las columnas de una página que difieren de lo que ya tiene el panel.
+  *
+  * @param dev Instancia del display.
+  * @param page Página a comparar.
+  * @param start Primera columna escrita.
+  * @param end Última columna escrita.
+  * @param mask Mapa de bits de columnas (un bit por columna) donde se marcan los cambios.
   *
-  * @note La limpieza se realiza página por página escribiendo ceros en toda la memoria de video.
+  * @note La comparación se hace de a palabras de 32 bits; solo en las palabras que
+  *       difieren se revisa cada byte.
   */
- void SSD1306_Clear(void) {
-     uint8_t zero_buffer[SSD1306_WIDTH];
-     memset(zero_buffer, 0x00, sizeof(zero_buffer));
+ static void SSD1306_DiffPage(const SSD1306_t* dev, uint8_t page, uint8_t start, uint8_t end, uint32_t* mask) {
+ 
+     const uint8_t* row = dev->framebuffer[page];
+     const uint8_t* panel = dev->shadow[page];
+ 
+     for (uint16_t col = start & ~3u; col <= end; col += 4) {
  
-     for (uint8_t page = 0; page < 8; page++) {
-         SSD1306_SendCommand(0xB0 + page);       // Page start
-         SSD1306_SendCommand(SSD1306_CMD_SET_LOWER_COLUMN);              // Lower column start
-         SSD1306_SendCommand(SSD1306_CMD_SET_HIGHER_COLUMN);              // Higher column start
-         SSD1306_SendData(zero_buffer, SSD1306_WIDTH);
+         uint32_t a;
+         uint32_t b;
+ 
+         memcpy(&a, &row[col], sizeof(a));
+         memcpy(&b, &panel[col], sizeof(b));
+ 
+         if (a == b) continue;
+ 
+         for (uint16_t i = col; i < col + 4; i++) {
+             if (i >= start && i <= end && row[i] != panel[i]) mask[i >> 5] |= 1u << (i & 31);
+         }
+     }
+ }
+ 
+ /**
+  * @brief Arma las ventanas de una página a partir de su mapa de columnas cambiadas.
+  *
+  * @param mask Mapa de bits de columnas cambiadas.
+  * @param start Primera columna a considerar.
+  * @param end Última columna a considerar.
+  * @param spans Ventanas resultantes (al menos SSD1306_MAX_PAGE_SPANS + 1 elementos).
+  * @return Cantidad de ventanas (hasta SSD1306_MAX_PAGE_SPANS).
+  *
+  * @note Un hueco se reenvía cuando sus bytes cuestan menos que abrir otra ventana.
+  *       Si quedan más ventanas que el máximo, se unen las separadas por el hueco más chico.
+  */
+ static uint8_t SSD1306_PlanPage(const uint32_t* mask, uint8_t start, uint8_t end, SSD1306_Dirty_t* spans) {
+ 
+     uint8_t count = 0;
+     uint16_t col = start;
+ 
+     while (col <= end) {
+ 
+         //Sin cambios desde esta columna hasta el fin de la palabra: se saltea la palabra
+         if ((mask[col >> 5] >> (col & 31)) == 0) {
+             col = (col | 31) + 1;
+             continue;
+         }
+ 
+         if (!(mask[col >> 5] & (1u << (col & 31)))) {
+             col++;
+             continue;
+         }
+ 
+         uint8_t runStart = col;
+         while (col <= end && (mask[col >> 5] & (1u << (col & 31)))) col++;
+         uint8_t runEnd = col - 1;
+ 
+         if (count > 0 && (uint32_t)(runStart - spans[count - 1].end - 1) * SSD1306_PORT_BYTE_BITS <= SEGMENT_OVERHEAD_BITS) {
+             spans[count - 1].end = runEnd;
+             continue;
+         }
+ 
+         spans[count].start = runStart;
+         spans[count].end = runEnd;
+         count++;
+ 
+         if (count > SSD1306_MAX_PAGE_SPANS) {
+             uint8_t best = 0;
+             for (uint8_t i = 1; i < count - 1; i++) {
+                 if (spans[i + 1].start - spans[i].end < spans[best + 1].start - spans[best].end) best = i;
+             }
+             spans[best].end = spans[best + 1].end;
+             memmove(&spans[best + 1], &spans[best + 2], (count - best - 2) * sizeof(spans[0]));
+             count--;
+         }
      }
+ 
+     return count;
+ }
+ 
+ /**
+  * @brief Agrega una ventana de una página a la trama, uniéndola a un segmento existente si conviene.
+  *
+  * @param dev Instancia del display.
+  * @param page Página de la ventana.
+  * @param start Primera columna.
+  * @param end Última columna.
+  *
+  * @note Se elige el segmento que termina en la página anterior (o en la misma) cuya
+  *       unión agrega menos bytes que los que cuesta la ventana por separado.
+  */
+ static void SSD1306_AddSpan(SSD1306_t* dev, uint8_t page, uint8_t start, uint8_t end) {
+ 
+     int32_t separate = (int32_t)(end - start + 1) * SSD1306_PORT_BYTE_BITS + SEGMENT_OVERHEAD_BITS;
+     int32_t bestExtra = separate;
+     SSD1306_Segment_t* best = NULL;
+ 
+     for (uint8_t i = 0; i < dev->segmentCount; i++) {
+ 
+         SSD1306_Segment_t* seg = &dev->segments[i];
+ 
+         if (seg->pageEnd != page && seg->pageEnd + 1 != page) continue;
+ 
+         uint8_t mergedStart = (start < seg->start) ? start : seg->start;
+         uint8_t mergedEnd = (end > seg->end) ? end : seg->end;
+         int32_t before = (int32_t)(seg->end - seg->start + 1) * (seg->pageEnd - seg->pageStart + 1);
+         int32_t after = (int32_t)(mergedEnd - mergedStart + 1) * (page - seg->pageStart + 1);
+         int32_t extra = (after - before) * SSD1306_PORT_BYTE_BITS;
+ 
+         if (extra <= bestExtra) {
+             bestExtra = extra;
+             best = seg;
+         }
+     }
+ 
+     if (best != NULL) {
+         if (start < best->start) best->start = start;
+         if (end > best->end) best->end = end;
+         best->pageEnd = page;
+         return;
+     }
+ 
+     dev->segments[dev->segmentCount].pageStart = page;
+     dev->segments[dev->segmentCount].pageEnd = page;
+     dev->segments[dev->segmentCount].start = start;
+     dev->segments[dev->segmentCount].end = end;
+     dev->segmentCount++;
+ }
+ 
+ /**
+  * @brief Une de a pares los segmentos cuyo rectángulo común cuesta menos que enviarlos por separado.
+  *
+  * @param dev Instancia del display.
+  *
+  * @note El rectángulo común puede contener por completo a otros segmentos, que se
+  *       descartan; su costo también cuenta como ahorro. En cada vuelta se aplica la
+  *       unión que más ahorra, hasta que ninguna ahorra nada. Solo se prueban pares de
+  *       páginas contiguas o superpuestas, y la cantidad de segmentos es chica.
+  */
+ static void SSD1306_MergeSegments(SSD1306_t* dev) {
+ 
+     while (dev->segmentCount > 1) {
+ 
+         int32_t bestSaving = 0;
+         uint8_t bestA = 0;
+         uint8_t bestB = 0;
+         SSD1306_Segment_t bestUnion = dev->segments[0];
+ 
+         for (uint8_t a = 0; a < dev->segmentCount; a++) {
+             for (uint8_t b = a + 1; b < dev->segmentCount; b++) {
+ 
+                 const SSD1306_Segment_t* segA = &dev->segments[a];
+                 const SSD1306_Segment_t* segB = &dev->segments[b];
+ 
+                 if (segA->pageEnd + 1 < segB->pageStart || segB->pageEnd + 1 < segA->pageStart) continue;
+ 
+                 SSD1306_Segment_t merged = *segA;
+                 merged.start = (segA->start < segB->start) ? segA->start : segB->start;
+                 merged.end = (segA->end > segB->end) ? segA->end : segB->end;
+                 merged.pageStart = (segA->pageStart < segB->pageStart) ? segA->pageStart : segB->pageStart;
+                 merged.pageEnd = (segA->pageEnd > segB->pageEnd) ? segA->pageEnd : segB->pageEnd;
+ 
+                 int32_t separate = (int32_t)(SSD1306_SegmentArea(segA) + SSD1306_SegmentArea(segB)) * SSD1306_PORT_BYTE_BITS + 2 * SEGMENT_OVERHEAD_BITS;
+ 
+                 for (uint8_t c = 0; c < dev->segmentCount; c++) {
+                     const SSD1306_Segment_t* segC = &dev->segments[c];
+                     if (c == a || c == b) continue;
+                     if (segC->start >= merged.start && segC->end <= merged.end && segC->pageStart >= merged.pageStart && segC->pageEnd <= merged.pageEnd) {
+                         separate += (int32_t)SSD1306_SegmentArea(segC) * SSD1306_PORT_BYTE_BITS + SEGMENT_OVERHEAD_BITS;
+                     }
+                 }
+ 
+                 int32_t saving = separate - ((int32_t)SSD1306_SegmentArea(&merged) * SSD1306_PORT_BYTE_BITS + SEGMENT_OVERHEAD_BITS);
+ 
+                 if (saving > bestSaving) {
+                     bestSaving = saving;
+                     bestA = a;
+                     bestB = b;
+                     bestUnion = merged;
+                 }
+             }
+         }
+ 
+         if (bestSaving <= 0) return;
+ 
+         //Se reemplaza el primero por la unión y se descartan el segundo y los contenidos
+         dev->segments[bestA] = bestUnion;
+ 
+         uint8_t count = 0;
+         for (uint8_t c = 0; c < dev->segmentCount; c++) {
+             const SSD1306_Segment_t* seg = &dev->segments[c];
+             bool contained = (c != bestA) && (c == bestB || (seg->start >= bestUnion.start && seg->end <= bestUnion.end &&
+                              seg->pageStart >= bestUnion.pageStart && seg->pageEnd <= bestUnion.pageEnd));
+             if (!contained) dev->segments[count++] = *seg;
+         }
+         dev->segmentCount = count;
+     }
+ }
+ 
+ /**
+  * @brief Devuelve la cantidad de bytes de datos de un segmento.
+  */
+ static uint16_t SSD1306_SegmentArea(const SSD1306_Segment_t* seg) {
+     return (uint16_t)(seg->end - seg->start + 1) * (seg->pageEnd - seg->pageStart + 1);
+ }
+ 
+ /**
+  * @brief Devuelve los contadores del planificador de envío.
+  *
+  * @param dev Instancia del display.
+  */
+ SSD1306_FlushStats_t SSD1306_GetFlushStats(const SSD1306_t* dev) {
+     return dev->flushStats;
+ }
+ 
+ /**
+  * @brief Reinicia los contadores del planificador de envío.
+  *
+  * @param dev Instancia del display.
+  */
+ void SSD1306_ResetFlushStats(SSD1306_t* dev) {
+     memset(&dev->flushStats, 0, sizeof(dev->flushStats));
+ }
+ 
+ /**
+  * @brief Indica si hay una trama del framebuffer en envío.
+  *
+  * @param dev Instancia del display.
+  * @return true mientras la trama de este display no terminó de enviarse.
+  */
+ bool SSD1306_FlushBusy(const SSD1306_t* dev) {
+     return dev->flushBusy;
+ }
+ 
+ /**
+  * @brief Espera a que el bus quede libre antes de usarlo en modo bloqueante.
+  *
+  * @note Se espera a las tramas de todos los displays del bus, no solo a la propia.
+  */
+ static void SSD1306_WaitIdle(const SSD1306_t* dev) {
+     while (dev->bus->busy) {
+     }
+ }
+ 
+ /**
+  * @brief Inicia la trama de un display si el bus está libre.
+  *
+  * @note Si el bus está ocupado no se hace nada: al terminar la transferencia en curso,
+  *       SSD1306_TxCpltCallback() encuentra la trama pendiente y la atiende.
+  */
+ static void SSD1306_BusStart(SSD1306_Bus_t* bus, SSD1306_t* dev) {
+ 
+     if (bus->busy) return;
+ 
+     bus->busy = true;
+     bus->current = dev;
+     SSD1306_StartTransfer(dev);
+ }
+ 
+ /**
+  * @brief Inicia por DMA la próxima transferencia de la trama de un display.
+  *
+  * @note Cada segmento se envía en dos transferencias: su ventana y luego sus datos.
+  *       La ventana queda guardada en el propio panel, por lo que entre ambas pueden
+  *       intercalarse transferencias de otro display del bus.
+  */
+ static void SSD1306_StartTransfer(SSD1306_t* dev) {
+ 
+     SSD1306_Segment_t* seg = &dev->segments[dev->segmentIndex];
+ 
+     if (!dev->windowPhase) {
+         SSD1306_I2C_Transmit_DMA(dev->bus, dev->address, SSD1306_DATA, &dev->frontbuffer[seg->offset], seg->size);
+         return;
+     }
+ 
+     dev->windowCommands[0] = SSD1306_CMD_COLUMN_ADDR;
+     dev->windowCommands[1] = seg->start;
+     dev->windowCommands[2] = seg->end;
+     dev->windowCommands[3] = SSD1306_CMD_PAGE_ADDR;
+     dev->windowCommands[4] = seg->pageStart;
+     dev->windowCommands[5] = seg->pageEnd;
+ 
+     SSD1306_I2C_Transmit_DMA(dev->bus, dev->address, SSD1306_COMMAND, dev->windowCommands, sizeof(dev->windowCommands));
+ }
+ 
+ /**
+  * @brief Avanza las tramas en envío de un bus al completarse cada transferencia DMA.
+  *
+  * @param bus Bus cuya transferencia terminó.
+  *
+  * @note Es llamada desde la capa de puerto (contexto de interrupción). Tras la
+  *       ventana de un segmento siguen sus datos y tras los datos, el siguiente
+  *       segmento. La próxima transferencia se toma del siguiente display del bus
+  *       con trama pendiente (round robin), de modo que los paneles avanzan a la par.
+  */
+ void SSD1306_TxCpltCallback(SSD1306_Bus_t* bus) {
+ 
+     SSD1306_t* dev = bus->current;
+     SSD1306_t* next = dev;
+ 
+     if (!bus->busy || dev == NULL) return;
+ 
+     if (dev->windowPhase) {
+         dev->windowPhase = false;
+     } else {
+         dev->windowPhase = true;
+         dev->segmentIndex++;
+         if (dev->segmentIndex >= dev->segmentCount) dev->flushBusy = false;
+     }
+ 
+     do {
+         next = (next->next != NULL) ? next->next : bus->devices;
+         if (next->flushBusy) {
+             bus->current = next;
+             SSD1306_StartTransfer(next);
+             return;
+         }
+     } while (next != dev);
+ 
+     bus->busy = false;
+ }
+ 
+ /**
+  * @brief Define la ventana de escritura de la GDDRAM en modo horizontal.
+  *
+  * @param dev Instancia del display.
+  * @param colStart Columna inicial.
+  * @param colEnd Columna final.
+  * @param pageStart Página inicial.
+  * @param pageEnd Página final.
+  *
+  * @note Los comandos COLUMN_ADDR y PAGE_ADDR se envían en una única transacción.
+  */
+ void SSD1306_SetWindow(SSD1306_t* dev, uint8_t colStart, uint8_t colEnd, uint8_t pageStart, uint8_t pageEnd) {
+ 
+     uint8_t window[] = {
+         SSD1306_CMD_COLUMN_ADDR, colStart, colEnd,
+         SSD1306_CMD_PAGE_ADDR, pageStart, pageEnd
+     };
+ 
+     SSD1306_SendCommandStream(dev, window, sizeof(window));
+ }
+ 
+ /**
+  * @brief Escribe un bloque de columnas en una página del framebuffer.
+  *
+  * @param dev Instancia del display.
+  * @param page Página destino.
+  * @param column Columna inicial.
+  * @param data Bytes a escribir (un byte por columna).
+  * @param size Cantidad de columnas.
+  *
+  * @note Se recorta al tamaño del panel y solo se marcan como modificadas
+  *       las columnas cuyo contenido realmente cambió.
+  */
+ static void SSD1306_WriteBuffer(SSD1306_t* dev, uint8_t page, uint8_t column, const uint8_t* data, uint8_t size) {
+ 
+     if (page >= dev->pages || column >= dev->width) return;
+     if (size > dev->width - column) size = dev->width - column;
+ 
+     uint8_t* row = &dev->framebuffer[page][column];
+     SSD1306_Dirty_t* range = &dev->dirty[page];
+     int16_t first = -1;
+     int16_t last = -1;
+ 
+     for (uint8_t i = 0; i < size; i++) {
+         if (row[i] != data[i]) {
+             row[i] = data[i];
+             if (first < 0) first = i;
+             last = i;
+         }
+     }
+ 
+     if (first < 0) return;
+ 
+     if (column + first < range->start) range->start = column + first;
+     if (column + last > range->end) range->end = column + last;
+ }
+ 
+ /**
+  * @brief Desplaza una columna a la izquierda el contenido de un rectángulo de la pantalla.
+  *
+  * @param dev Instancia del display.
+  * @param pageStart Página inicial.
+  * @param pageEnd Página final.
+  * @param colStart Columna inicial.
+  * @param colEnd Columna final.
+  *
+  * @note Con SSD1306_USE_CONTENT_SCROLL el panel desplaza su GDDRAM con el comando 2Dh
+  *       (8 bytes en el bus) y el framebuffer se rota igual, trasladando los rangos
+  *       pendientes, de modo que no se reenvía nada. El panel necesita al menos un
+  *       cuadro de refresco entre dos comandos 2Dh consecutivos.
+  *       Sin él, la rotación se hace en el framebuffer y se envían las columnas que cambian.
+  */
+ void SSD1306_ScrollLeft(SSD1306_t* dev, uint8_t pageStart, uint8_t pageEnd, uint8_t colStart, uint8_t colEnd) {
+ 
+     assert(pageStart <= pageEnd);
+     assert(pageEnd < dev->pages);
+     assert(colStart < colEnd);
+     assert(colEnd < dev->width);
+ 
+     uint8_t width = colEnd - colStart + 1;
+ 
+     for (uint8_t page = pageStart; page <= pageEnd; page++) {
+ 
+         uint8_t* row = &dev->framebuffer[page][colStart];
+ 
+ #if SSD1306_USE_CONTENT_SCROLL
+         uint8_t first = row[0];
+         memmove(row, row + 1, width - 1);
+         row[width - 1] = first;
+ 
+         //La GDDRAM rota igual, por lo que la copia del panel también
+         uint8_t* panel = &dev->shadow[page][colStart];
+         first = panel[0];
+         memmove(panel, panel + 1, width - 1);
+         panel[width - 1] = first;
+ 
+         SSD1306_ShiftDirty(dev, page, colStart, colEnd);
+ #else
+         uint8_t rotated[SSD1306_WIDTH];
+         memcpy(rotated, row + 1, width - 1);
+         rotated[width - 1] = row[0];
+         SSD1306_WriteBuffer(dev, page, colStart, rotated, width);
+ #endif
+     }
+ 
+ #if SSD1306_USE_CONTENT_SCROLL
+     uint8_t scroll[] = {
+         SSD1306_CMD_CONTENT_SCROLL_LEFT, 0x00, pageStart, 0x01, pageEnd, 0x00, colStart, colEnd
+     };
+ 
+     SSD1306_SendCommandStream(dev, scroll, sizeof(scroll));
+ #endif
+ }
+ 
+ /**
+  * @brief Traslada el rango pendiente de una página luego de rotar una columna a la izquierda.
+  *
+  * @note El rango resultante puede ser mayor al exacto, nunca menor.
+  */
+ static void SSD1306_ShiftDirty(SSD1306_t* dev, uint8_t page, uint8_t colStart, uint8_t colEnd) {
+ 
+     SSD1306_Dirty_t* range = &dev->dirty[page];
+ 
+     if (range->start > range->end) return;
+ 
+     //La primera columna del rectángulo pasa a la última
+     bool wraps = (range->start <= colStart && range->end >= colStart);
+ 
+     if (range->start > colStart && range->start <= colEnd) range->start--;
+     if (range->end > colStart && range->end <= colEnd) range->end--;
+     if (wraps && range->end < colEnd) range->end = colEnd;
+ }
+ 
+ /**
+  * @brief Escribe una columna de varias páginas y la marca para enviar en el próximo flush.
+  *
+  * @param dev Instancia del display.
+  * @param column Columna destino.
+  * @param pageStart Página inicial.
+  * @param pageEnd Página final.
+  * @param data Un byte por página.
+  *
+  * @note La columna se envía aunque no cambie en el framebuffer (la copia del panel
+  *       se invalida): tras un scroll de contenido no todos los controladores dejan
+  *       en la última columna lo mismo.
+  */
+ void SSD1306_WriteColumn(SSD1306_t* dev, uint8_t column, uint8_t pageStart, uint8_t pageEnd, const uint8_t* data) {
+ 
+     assert(data != NULL);
+     assert(column < dev->width);
+     assert(pageStart <= pageEnd);
+     assert(pageEnd < dev->pages);
+ 
+     for (uint8_t page = pageStart; page <= pageEnd; page++) {
+ 
+         SSD1306_Dirty_t* range = &dev->dirty[page];
+ 
+         dev->framebuffer[page][column] = data[page - pageStart];
+         dev->shadow[page][column] = ~data[page - pageStart];
+ 
+         if (column < range->start) range->start = column;
+         if (column > range->end) range->end = column;
+     }
+ }
+ 
+ /**
+  * @brief Devuelve una fila del framebuffer para escribirla directamente y marca el rango como modificado.
+  *
+  * @param dev Instancia del display.
+  * @param page Página de la fila.
+  * @param start Primera columna que se va a escribir.
+  * @param end Última columna que se va a escribir.
+  * @return Puntero a la columna start de la página.
+  *
+  * @note El rango puede incluir columnas que no cambian: SSD1306_Flush() las compara con
+  *       la copia del panel y no las envía.
+  */
+ uint8_t* SSD1306_EditRow(SSD1306_t* dev, uint8_t page, uint8_t start, uint8_t end) {
+ 
+     assert(page < dev->pages);
+     assert(start <= end);
+     assert(end < dev->width);
+ 
+     SSD1306_Dirty_t* range = &dev->dirty[page];
+ 
+     if (start < range->start) range->start = start;
+     if (end > range->end) range->end = end;
+ 
+     return &dev->framebuffer[page][start];
  }
  
  //Enciende el display
- void SSD1306_DisplayOn(void) {
-     SSD1306_SendCommand(SSD1306_CMD_DISPLAY_ON);
+ void SSD1306_DisplayOn(SSD1306_t* dev) {
+     SSD1306_SendCommand(dev, SSD1306_CMD_DISPLAY_ON);
  }
  
  //Apaga el display
- void SSD1306_DisplayOff(void) {
-     SSD1306_SendCommand(SSD1306_CMD_DISPLAY_OFF);
+ void SSD1306_DisplayOff(SSD1306_t* dev) {
+     SSD1306_SendCommand(dev, SSD1306_CMD_DISPLAY_OFF);
  }
  
  /**
   * @brief Configura la posición del cursor en el display OLED SSD1306.
   *
+  * @param dev Instancia del display.
   * @param x Índice horizontal del carácter (0 a 21 caracteres visibles).
   * @param page Página vertical del display (0 a 7).
   *
   * @note La posición se calcula en función de la fuente 5x7 más espacio entre caracteres.
+  *       Solo actualiza el cursor del framebuffer, no genera tráfico en el bus.
   */
- void SSD1306_SetCursor(uint8_t x, uint8_t page) {
+ void SSD1306_SetCursor(SSD1306_t* dev, uint8_t x, uint8_t page) {
  
      assert(x <= SDD1306_MAX_CHARACTER);
-     assert(page <= SDD1306_MAX_PAGE);
+     assert(page < dev->pages);
  
-     static uint8_t cursor5x7;
-     cursor5x7 = x * 6;			//Se redimensiona el cursor por la fuente que se usa 5x7 + espacio entre caracteres.
- 
-     SSD1306_SendCommand(PAGE_ADDRESSING + page);               		// Configura la pagina
-     SSD1306_SendCommand(SSD1306_CMD_SET_LOWER_COLUMN + (cursor5x7 & 0x0F));         // bit inferior
-     SSD1306_SendCommand(SSD1306_CMD_SET_HIGHER_COLUMN + ((cursor5x7 >> 4) & 0x0F));  // bit superor
+     dev->cursorColumn = x * SSD1306_CHAR_CELL_WIDTH;		//Se redimensiona el cursor por la fuente que se usa 5x7 + espacio entre caracteres.
+     dev->cursorPage = page;
  
  }
  
  /**
-  * @brief Escribe un carácter ASCII en el display OLED SSD1306.
+  * @brief Escribe un carácter ASCII en el framebuffer en la posición del cursor.
   *
+  * @param dev Instancia del display.
   * @param c Carácter a mostrar.
   *
   * @note Si el carácter no es soportado (fuera del rango imprimible ASCII), se muestra '?'.
   *       Cada carácter ocupa 5 columnas de píxeles más 1 columna de espacio en blanco.
+  *       Los cambios se envían al display con SSD1306_Flush().
   */
- void SSD1306_WriteChar(char c) {
-     static uint8_t space = 0x00;
+ void SSD1306_WriteChar(SSD1306_t* dev, char c) {
+ 
+     uint8_t cell[SSD1306_CHAR_CELL_WIDTH] = {0};
  
      if (c < ASCII_MIN || c > ASCII_MAX) c = '?'; // Caracteres no soportados
  
-     SSD1306_SendData((uint8_t*)Font5x7[c - ASCII_OFFSET], 5); // Enviar 5 columnas
-     SSD1306_SendData(&space, 1); 							// Espacio entre caracteres
+     memcpy(cell, Font5x7[c - ASCII_OFFSET], 5);	// 5 columnas de fuente, la sexta queda como espacio
+     SSD1306_WriteBuffer(dev, dev->cursorPage, dev->cursorColumn, cell, SSD1306_CHAR_CELL_WIDTH);
+ 
+     if (dev->cursorColumn < dev->width) dev->cursorColumn += SSD1306_CHAR_CELL_WIDTH;
  }
  
  
  /**
   * @brief Envía un string de caracteres al display OLED SSD1306.
   *
+  * @param dev Instancia del display.
   * @param str Puntero al string a enviar.
   *
   * @note El string debe ser nulo-terminado y no superar la cantidad máxima de caracteres permitidos.
+  *       Todo el texto se rasteriza en una fila y se escribe en el framebuffer de una vez,
+  *       por lo que al hacer SSD1306_Flush() se envía en una sola transacción de datos.
   */
- void SSD1306_WriteString(char* str) {
+ void SSD1306_WriteString(SSD1306_t* dev, char* str) {
  
      assert(str != NULL);
      assert(SDD1306_MAX_CHARACTER >= strlen(str));
  
-     while (*str) {
-         SSD1306_WriteChar(*str++);
-     }
+     uint8_t row[SSD1306_WIDTH];
+     uint16_t width = strlen(str) * SSD1306_CHAR_CELL_WIDTH;
+ 
+     if (dev->cursorColumn >= dev->width) return;
+     if (width > dev->width - dev->cursorColumn) width = dev->width - dev->cursorColumn;
+ 
+     SSD1306_RenderText(row, width, str, SSD1306_ALIGN_LEFT);
+     SSD1306_WriteBuffer(dev, dev->cursorPage, dev->cursorColumn, row, width);
+ 
+     dev->cursorColumn += width;
  
  }
  
  /**
-  * @brief Muestra las mediciones de distancia actual, máxima y mínima en el display OLED SSD1306.
+  * @brief Escribe un texto dentro de un campo de ancho fijo de una página.
+  *
+  * @param dev Instancia del display.
+  * @param x Celda de caracter inicial del campo (0 a 21).
+  * @param page Página del display (0 a 7).
+  * @param widthChars Ancho del campo en caracteres.
+  * @param str Texto a escribir, nulo-terminado.
+  * @param align Alineación del texto dentro del campo.
   *
-  * @param Actual Medición actual en milímetros (dividido por 10 para mostrar en centímetros).
-  * @param Maxima Medición máxima registrada en milímetros.
-  * @param Minima Medición mínima registrada en milímetros.
+  * @note El campo completo se rasteriza en una fila: las celdas sin texto quedan en blanco
+  *       (se borran restos de un valor anterior más largo) y el texto que excede el campo o
+  *       la pantalla se recorta.
   */
- void SSD1306_PrintMesurement(uint16_t Actual,uint16_t Maxima,uint16_t Minima){
+ void SSD1306_DrawText(SSD1306_t* dev, uint8_t x, uint8_t page, uint8_t widthChars, const char* str, SSD1306_Align_t align) {
  
-     static char buffer[BUFFER_TO_PRINT_LENGTH];
+     assert(str != NULL);
+     assert(x <= SDD1306_MAX_CHARACTER);
+     assert(page < dev->pages);
  
-     sprintf(buffer, "%2d.%d[cm]", Actual / 10, Actual % 10);
-     SSD1306_SetCursor(10, 0);
-     SSD1306_WriteString(buffer);
+     uint8_t row[SSD1306_WIDTH];
+     uint8_t column = x * SSD1306_CHAR_CELL_WIDTH;
+     uint16_t width = widthChars * SSD1306_CHAR_CELL_WIDTH;
  
-     sprintf(buffer, "%2d.%d[cm]", Maxima / 10, Maxima % 10);
-     SSD1306_SetCursor(7, 1);
-     SSD1306_WriteString(buffer);
+     if (column >= dev->width) return;
+     if (width > dev->width - column) width = dev->width - column;
  
-     sprintf(buffer, "%2d.%d[cm]", Minima / 10, Minima % 10);
-     SSD1306_SetCursor(7, 2);
-     SSD1306_WriteString(buffer);
+     SSD1306_RenderText(row, width, str, align);
+     SSD1306_WriteBuffer(dev, page, column, row, width);
  
  }
+ /**
+  * @brief Rasteriza un texto con la fuente 5x7 en una fila de píxeles.
+  *
+  * @param row Buffer de salida (un byte por columna).
+  * @param width Ancho de la fila en columnas.
+  * @param str Texto nulo-terminado.
+  * @param align Alineación del texto dentro de la fila.
+  * @return Cantidad de columnas ocupadas por el texto (recortado al ancho de la fila).
+  */
+ static uint8_t SSD1306_RenderText(uint8_t* row, uint8_t width, const char* str, SSD1306_Align_t align) {
+ 
+     uint16_t textWidth = strlen(str) * SSD1306_CHAR_CELL_WIDTH;
+     uint16_t offset = 0;
+ 
+     memset(row, 0x00, width);
  
+     if (align == SSD1306_ALIGN_RIGHT && textWidth < width) offset = width - textWidth;
+ 
+     for (; *str != '\0' && offset < width; str++) {
+ 
+         char c = *str;
+         if (c < ASCII_MIN || c > ASCII_MAX) c = '?'; // Caracteres no soportados
+ 
+         const uint8_t* glyph = Font5x7[c - ASCII_OFFSET];
+ 
+         for (uint8_t i = 0; i < 5 && offset + i < width; i++) {
+             row[offset + i] = glyph[i];
+         }
+ 
+         offset += SSD1306_CHAR_CELL_WIDTH;
+     }
+ 
+     return (textWidth < width) ? textWidth : width;
+ }
  
  /**
-  * @brief Muestra el tiempo de muestreo del sensor en el display OLED SSD1306.
+  * @brief Devuelve el ancho útil en columnas del glifo de un carácter.
   *
-  * @param muestreo Intervalo de muestreo en milisegundos.
+  * @param font Fuente a utilizar.
+  * @param c Carácter.
+  * @return Ancho del glifo sin el espaciado (el ancho de la tabla si la fuente es monoespaciada).
   */
- void SSD1306_PrintMuestreo(uint32_t muestreo){
+ uint8_t SSD1306_GlyphWidth(const font_t* font, char c) {
  
-     static char buffer[BUFFER_TO_PRINT_LENGTH];
- 
-     sprintf(buffer, "%lu[ms]", muestreo);
-     SSD1306_SetCursor(9, 3);
-     SSD1306_WriteString(buffer);
+     if (font->widths == NULL || c < font->first || c > font->last) return font->width;
+     return font->widths[c - font->first];
  }
  
+ /**
+  * @brief Calcula el ancho en píxeles de un texto con una fuente.
+  *
+  * @param str Texto nulo-terminado.
+  * @param font Fuente a utilizar.
+  * @return Suma del ancho de cada glifo más el espaciado que lo sigue.
+  */
+ uint16_t SSD1306_TextWidth(const char* str, const font_t* font) {
+ 
+     uint16_t width = 0;
+ 
+     assert(str != NULL);
+     assert(font != NULL);
+ 
+     for (; *str != '\0'; str++) {
+         width += SSD1306_GlyphWidth(font, *str) + font->spacing;
+     }
+ 
+     return width;
+ }
  
  /**
-  * @brief Muestra las mediciones de distancia actual, máxima y mínima en el display OLED SSD1306.
+  * @brief Escribe un texto con cualquier fuente en un campo de ancho fijo en píxeles.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna inicial del campo en píxeles.
+  * @param page Página superior del campo.
+  * @param width Ancho del campo en píxeles.
+  * @param str Texto a escribir, nulo-terminado.
+  * @param font Fuente a utilizar.
+  * @param align Alineación del texto dentro del campo.
   *
-  * @param Actual Medición actual en milímetros (dividido por 10 para mostrar en centímetros).
-  * @param Maxima Medición máxima registrada en milímetros.
-  * @param Minima Medición mínima registrada en milímetros.
+  * @note Los glifos se copian tal cual desde la tabla en flash (o desde el caché, si la
+  *       fuente está comprimida), página por página: no se escala nada al dibujar.
+  *       Cada página del campo se escribe en el framebuffer con una sola operación, de
+  *       modo que solo se envían las columnas que cambiaron.
+  *       Los caracteres que la fuente no incluye se dejan en blanco.
   */
- void SSD1306_PrintSetup(uint8_t port,uint8_t cal){
+ void SSD1306_DrawTextFont(SSD1306_t* dev, uint8_t x, uint8_t page, uint8_t width, const char* str, const font_t* font, SSD1306_Align_t align) {
  
-     static char buffer[BUFFER_TO_PRINT_LENGTH];
+     assert(str != NULL);
+     assert(font != NULL);
+     assert(page + font->pages <= dev->pages);
  
-     sprintf(buffer, "Distancia:");
-     SSD1306_SetCursor(0, 0);
-     SSD1306_WriteString(buffer);
+     uint8_t row[SSD1306_WIDTH];
+     uint16_t textWidth = SSD1306_TextWidth(str, font);
+     uint16_t origin = 0;
  
-     sprintf(buffer, "Maxima:");
-     SSD1306_SetCursor(0, 1);
-     SSD1306_WriteString(buffer);
+     if (x >= dev->width) return;
+     if (width > dev->width - x) width = dev->width - x;
  
-     sprintf(buffer, "Minima:");
-     SSD1306_SetCursor(0, 2);
-     SSD1306_WriteString(buffer);
+     if (align == SSD1306_ALIGN_RIGHT && textWidth < width) origin = width - textWidth;
  
-     sprintf(buffer, "Muestreo:");
-     SSD1306_SetCursor(0, 3);
-     SSD1306_WriteString(buffer);
+     for (uint8_t p = 0; p < font->pages; p++) {
  
-     sprintf(buffer, "%s",
-             (cal == 0x00) ? "Sin calibrar" :
-             (cal == 0x01) ? "Crosstalk calibrado" :
-             (cal == 0x02) ? "Offset calibrado" :
-             (cal == 0x03) ? "Calibracion completa" : "Desconocida");
-     SSD1306_SetCursor(0, 5);
-     SSD1306_WriteString(buffer);
+         uint16_t offset = origin;
  
+         memset(row, 0x00, width);
  
-     sprintf(buffer, "%s",
-             (port == 0x41) ? "UART+I2C" :
-             (port == 0x49) ? "Solo I2C" :
-             (port == 0x55) ? "Solo UART" : "Desconocido");
+         for (const char* c = str; *c != '\0' && offset < width; c++) {
  
-     SSD1306_SetCursor(0, 6);
-     SSD1306_WriteString(buffer);
+             uint8_t glyphWidth = SSD1306_GlyphWidth(font, *c);
  
- }
+             const uint8_t* glyph = fontGlyph(font, *c);
+             if (glyph != NULL) {
+                 glyph += p * font->width;
+                 for (uint8_t i = 0; i < glyphWidth && offset + i < width; i++) {
+                     row[offset + i] = glyph[i];
+                 }
+             }
  
+             offset += glyphWidth + font->spacing;
+         }
  
+         SSD1306_WriteBuffer(dev, page + p, x, row, width);
+     }
+ }
@@ -0,0 +1,135 @@
+/**
+ * @file SSD1306_Chart.c
+ * @brief Implementación del gráfico desplazable para el display SSD1306.
+ *
+ * El contenido ya dibujado nunca se reenvía: el panel lo desplaza con su comando
+ * de scroll de contenido y solo se transmite la columna de la muestra nueva.
+ * Las muestras que llegan juntas se agregan desplazando el framebuffer, y se envían
+ * las columnas que cambiaron.
+ *
+ */
+
+ #include "../../Drivers/API/Inc/SSD1306_Chart.h"
+ 
+ static uint8_t SSD1306_ChartRow(const SSD1306_Chart_t* chart, uint16_t value);
+ static void SSD1306_ChartColumn(SSD1306_Chart_t* chart, uint16_t value, uint8_t* column);
+ 
+ /**
+  * @brief Inicializa un gráfico sobre un rango de páginas.
+  *
+  * @param chart Puntero al gráfico.
+  * @param dev Display donde se dibuja el gráfico.
+  * @param pageStart Página superior.
+  * @param pageEnd Página inferior.
+  * @param min Valor correspondiente a la fila inferior.
+  * @param max Valor correspondiente a la fila superior.
+  */
+ void SSD1306_ChartInit(SSD1306_Chart_t* chart, SSD1306_t* dev, uint8_t pageStart, uint8_t pageEnd, uint16_t min, uint16_t max) {
+ 
+     assert(chart != NULL);
+     assert(dev != NULL);
+     assert(pageStart <= pageEnd);
+     assert(pageEnd < dev->pages);
+     assert(min < max);
+ 
+     chart->dev = dev;
+     chart->pageStart = pageStart;
+     chart->pageEnd = pageEnd;
+     chart->min = min;
+     chart->max = max;
+     chart->lastRow = 0;
+     chart->hasLast = false;
+ }
+ 
+ /**
+  * @brief Agrega una muestra en el borde derecho del gráfico.
+  *
+  * @param chart Puntero al gráfico.
+  * @param value Valor de la muestra; 0 deja la columna vacía.
+  *
+  * @note La columna nueva une la muestra anterior con la actual mediante un trazo
+  *       vertical, para que los saltos grandes no queden como puntos sueltos.
+  */
+ void SSD1306_ChartPush(SSD1306_Chart_t* chart, uint16_t value) {
+ 
+     assert(chart != NULL);
+ 
+     uint8_t column[SSD1306_PAGES];
+ 
+     SSD1306_ScrollLeft(chart->dev, chart->pageStart, chart->pageEnd, 0, chart->dev->width - 1);
+     SSD1306_ChartColumn(chart, value, column);
+     SSD1306_WriteColumn(chart->dev, chart->dev->width - 1, chart->pageStart, chart->pageEnd, column);
+ }
+ 
+ /**
+  * @brief Agrega varias muestras en el borde derecho del gráfico sin usar el scroll del panel.
+  *
+  * @param chart Puntero al gráfico.
+  * @param values Muestras, de la más antigua a la más nueva.
+  * @param count Cantidad de muestras.
+  *
+  * @note Sirve cuando se juntaron más muestras que scrolls de contenido admite un cuadro:
+  *       en lugar de un comando 2Dh por muestra se reenvía la región del gráfico que cambió.
+  */
+ void SSD1306_ChartAppend(SSD1306_Chart_t* chart, const uint16_t* values, uint8_t count) {
+ 
+     assert(chart != NULL);
+     assert(values != NULL || count == 0);
+     assert(count <= chart->dev->width);
+ 
+     uint8_t* rows[SSD1306_PAGES];
+     uint8_t column[SSD1306_PAGES];
+     uint8_t width = chart->dev->width;
+ 
+     if (count == 0) return;
+ 
+     for (uint8_t page = chart->pageStart; page <= chart->pageEnd; page++) {
+         rows[page] = SSD1306_EditRow(chart->dev, page, 0, width - 1);
+         memmove(rows[page], rows[page] + count, width - count);
+     }
+ 
+     for (uint8_t i = 0; i < count; i++) {
+         SSD1306_ChartColumn(chart, values[i], column);
+         for (uint8_t page = chart->pageStart; page <= chart->pageEnd; page++) {
+             rows[page][width - count + i] = column[page - chart->pageStart];
+         }
+     }
+ }
+ 
+ /**
+  * @brief Arma la columna de una muestra, un byte por página, y la recuerda para unir la siguiente.
+  */
+ static void SSD1306_ChartColumn(SSD1306_Chart_t* chart, uint16_t value, uint8_t* column) {
+ 
+     memset(column, 0, chart->pageEnd - chart->pageStart + 1);
+ 
+     if (value == 0) {
+         chart->hasLast = false;
+         return;
+     }
+ 
+     uint8_t row = SSD1306_ChartRow(chart, value);
+     uint8_t from = chart->hasLast ? chart->lastRow : row;
+     uint8_t top = (from < row) ? from : row;
+     uint8_t bottom = (from < row) ? row : from;
+ 
+     for (uint8_t y = top; y <= bottom; y++) {
+         column[y / 8] |= 1 << (y % 8);
+     }
+ 
+     chart->lastRow = row;
+     chart->hasLast = true;
+ }
+ 
+ /**
+  * @brief Convierte un valor en la fila del gráfico (0 es la fila superior).
+  */
+ static uint8_t SSD1306_ChartRow(const SSD1306_Chart_t* chart, uint16_t value) {
+ 
+     uint8_t height = (chart->pageEnd - chart->pageStart + 1) * 8;
+ 
+     if (value < chart->min) value = chart->min;
+     if (value > chart->max) value = chart->max;
+ 
+     return (height - 1) - (uint32_t)(value - chart->min) * (height - 1) / (chart->max - chart->min);
+ }
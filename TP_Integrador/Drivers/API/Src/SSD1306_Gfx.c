@@ -0,0 +1,383 @@
+/**
+ * @file SSD1306_Gfx.c
+ * @brief Implementación del dibujo en cualquier posición de píxel para el display SSD1306.
+ *
+ * Todo el dibujo pasa por SSD1306_GfxBlend(), que recorre el rectángulo destino página
+ * por página y de a 4 columnas: los 4 bytes de la fuente se cargan en una palabra de 32
+ * bits y el desplazamiento vertical, la máscara de filas y la operación de combinación
+ * se aplican a las 4 columnas a la vez. Cada byte de la palabra es una columna, por lo
+ * que los desplazamientos se enmascaran por byte para no mezclar columnas vecinas.
+ *
+ */
+
+ #include "../../Drivers/API/Inc/SSD1306_Gfx.h"
+ 
+ #ifdef SSD1306_GFX_BENCHMARK
+ #include "../../Drivers/API/Inc/API_cycles.h"
+ #endif
+ 
+ /// @brief Replica un byte en los 4 bytes de una palabra.
+ #define GFX_LANES(b)        (0x01010101u * (uint8_t)(b))
+ 
+ static void SSD1306_GfxBlend(SSD1306_t* dev, int16_t x, int16_t y, int16_t width, int16_t height,
+                              const uint8_t* data, uint16_t stride, SSD1306_Rop_t rop);
+ static uint8_t SSD1306_GfxRowMask(int16_t band, int16_t height);
+ static inline uint32_t SSD1306_GfxLoad(const uint8_t* src, uint8_t count);
+ static inline void SSD1306_GfxStore(uint8_t* dst, uint32_t word, uint8_t count);
+ 
+ /**
+  * @brief Dibuja un mapa de bits con su esquina superior izquierda en (x, y).
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina (puede ser negativa o exceder el panel: se recorta).
+  * @param y Fila de la esquina (ídem).
+  * @param bitmap Mapa de bits.
+  * @param rop Operación de combinación.
+  */
+ void SSD1306_GfxBlit(SSD1306_t* dev, int16_t x, int16_t y, const SSD1306_Bitmap_t* bitmap, SSD1306_Rop_t rop) {
+ 
+     assert(bitmap != NULL);
+     assert(bitmap->data != NULL);
+ 
+     SSD1306_GfxBlend(dev, x, y, bitmap->width, bitmap->height, bitmap->data, bitmap->width, rop);
+ }
+ 
+ /**
+  * @brief Dibuja un texto con cualquier fuente a partir de (x, y).
+  *
+  * @param dev Instancia del display.
+  * @param x Columna del primer glifo.
+  * @param y Fila superior de los glifos.
+  * @param str Texto nulo-terminado.
+  * @param font Fuente a utilizar.
+  * @param rop Operación de combinación.
+  * @return Columna siguiente al último glifo (con su espaciado).
+  *
+  * @note Cada glifo se dibuja directamente desde la tabla de la fuente (o desde el caché,
+  *       si está comprimida), con las bandas
+  *       de la fuente como alto (font->pages * 8 filas). Los caracteres que la fuente
+  *       no incluye dejan su lugar sin dibujar.
+  */
+ int16_t SSD1306_GfxText(SSD1306_t* dev, int16_t x, int16_t y, const char* str, const font_t* font, SSD1306_Rop_t rop) {
+ 
+     assert(str != NULL);
+     assert(font != NULL);
+ 
+     int16_t height = font->pages * 8;
+ 
+     for (; *str != '\0' && x < dev->width; str++) {
+ 
+         uint8_t glyphWidth = SSD1306_GlyphWidth(font, *str);
+ 
+         const uint8_t* glyph = fontGlyph(font, *str);
+ 
+         if (glyph != NULL) {
+             SSD1306_GfxBlend(dev, x, y, glyphWidth, height, glyph, font->width, rop);
+         } else if (rop == SSD1306_ROP_COPY) {
+             SSD1306_GfxBlend(dev, x, y, glyphWidth, height, NULL, 0, SSD1306_ROP_CLEAR);
+         }
+ 
+         //Con COPY el texto reemplaza también el espaciado entre glifos
+         if (rop == SSD1306_ROP_COPY && font->spacing > 0) {
+             SSD1306_GfxBlend(dev, x + glyphWidth, y, font->spacing, height, NULL, 0, SSD1306_ROP_CLEAR);
+         }
+ 
+         x += glyphWidth + font->spacing;
+     }
+ 
+     return x;
+ }
+ 
+ /**
+  * @brief Dibuja un píxel.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna.
+  * @param y Fila.
+  * @param rop Operación de combinación.
+  */
+ void SSD1306_GfxPixel(SSD1306_t* dev, int16_t x, int16_t y, SSD1306_Rop_t rop) {
+ 
+     if (x < 0 || y < 0 || x >= dev->width || y >= dev->height) return;
+ 
+     uint8_t* cell = SSD1306_EditRow(dev, y >> 3, x, x);
+     uint8_t bit = 1u << (y & 7);
+ 
+     switch (rop) {
+     case SSD1306_ROP_COPY:
+     case SSD1306_ROP_OR:    *cell |= bit;  break;
+     case SSD1306_ROP_XOR:   *cell ^= bit;  break;
+     case SSD1306_ROP_CLEAR: *cell &= ~bit; break;
+     }
+ }
+ 
+ /**
+  * @brief Dibuja una línea entre dos puntos, ambos incluidos.
+  *
+  * @param dev Instancia del display.
+  * @param x0 Columna inicial.
+  * @param y0 Fila inicial.
+  * @param x1 Columna final.
+  * @param y1 Fila final.
+  * @param rop Operación de combinación.
+  *
+  * @note Las líneas horizontales y verticales se rellenan como rectángulos de 1 píxel de
+  *       ancho (de a 4 columnas u 8 filas por operación); el resto usa Bresenham.
+  */
+ void SSD1306_GfxLine(SSD1306_t* dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1, SSD1306_Rop_t rop) {
+ 
+     int16_t dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+     int16_t dy = (y1 > y0) ? y0 - y1 : y1 - y0;
+     int16_t sx = (x0 < x1) ? 1 : -1;
+     int16_t sy = (y0 < y1) ? 1 : -1;
+     int16_t err = dx + dy;
+ 
+     if (dy == 0) {
+         SSD1306_GfxBlend(dev, (x0 < x1) ? x0 : x1, y0, dx + 1, 1, NULL, 0, rop);
+         return;
+     }
+     if (dx == 0) {
+         SSD1306_GfxBlend(dev, x0, (y0 < y1) ? y0 : y1, 1, 1 - dy, NULL, 0, rop);
+         return;
+     }
+ 
+     for (;;) {
+         SSD1306_GfxPixel(dev, x0, y0, rop);
+         if (x0 == x1 && y0 == y1) break;
+         int16_t e2 = 2 * err;
+         if (e2 >= dy) { err += dy; x0 += sx; }
+         if (e2 <= dx) { err += dx; y0 += sy; }
+     }
+ }
+ 
+ /**
+  * @brief Dibuja el contorno de un rectángulo.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina superior izquierda.
+  * @param y Fila de la esquina superior izquierda.
+  * @param width Ancho en columnas.
+  * @param height Alto en filas.
+  * @param rop Operación de combinación.
+  *
+  * @note Cada píxel del contorno se dibuja una sola vez, de modo que con
+  *       SSD1306_ROP_XOR las esquinas también se invierten.
+  */
+ void SSD1306_GfxRect(SSD1306_t* dev, int16_t x, int16_t y, uint8_t width, uint8_t height, SSD1306_Rop_t rop) {
+ 
+     if (width == 0 || height == 0) return;
+ 
+     SSD1306_GfxBlend(dev, x, y, width, 1, NULL, 0, rop);
+     if (height == 1) return;
+     SSD1306_GfxBlend(dev, x, y + height - 1, width, 1, NULL, 0, rop);
+     if (height == 2) return;
+     SSD1306_GfxBlend(dev, x, y + 1, 1, height - 2, NULL, 0, rop);
+     if (width == 1) return;
+     SSD1306_GfxBlend(dev, x + width - 1, y + 1, 1, height - 2, NULL, 0, rop);
+ }
+ 
+ /**
+  * @brief Rellena un rectángulo.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina superior izquierda.
+  * @param y Fila de la esquina superior izquierda.
+  * @param width Ancho en columnas.
+  * @param height Alto en filas.
+  * @param rop Operación de combinación.
+  */
+ void SSD1306_GfxFillRect(SSD1306_t* dev, int16_t x, int16_t y, uint8_t width, uint8_t height, SSD1306_Rop_t rop) {
+     SSD1306_GfxBlend(dev, x, y, width, height, NULL, 0, rop);
+ }
+ 
+ /**
+  * @brief Dibuja una barra horizontal con contorno, llena en proporción a un valor.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna de la esquina superior izquierda.
+  * @param y Fila de la esquina superior izquierda.
+  * @param width Ancho total en columnas (al menos 3).
+  * @param height Alto total en filas (al menos 3).
+  * @param value Valor mostrado (se limita a max).
+  * @param max Valor de la barra llena.
+  *
+  * @note Entre el contorno y el relleno queda una fila y una columna libres si la barra
+  *       tiene al menos 5 píxeles de alto y de ancho.
+  */
+ void SSD1306_GfxBar(SSD1306_t* dev, int16_t x, int16_t y, uint8_t width, uint8_t height, uint16_t value, uint16_t max) {
+ 
+     assert(width >= 3 && height >= 3);
+     assert(max > 0);
+ 
+     uint8_t gap = (width >= 5 && height >= 5) ? 2 : 1;
+     uint8_t inner = width - 2 * gap;
+     uint8_t filled;
+ 
+     if (value > max) value = max;
+     filled = (uint8_t)((uint32_t)inner * value / max);
+ 
+     SSD1306_GfxRect(dev, x, y, width, height, SSD1306_ROP_OR);
+     if (gap == 2) SSD1306_GfxRect(dev, x + 1, y + 1, width - 2, height - 2, SSD1306_ROP_CLEAR);
+ 
+     SSD1306_GfxBlend(dev, x + gap, y + gap, filled, height - 2 * gap, NULL, 0, SSD1306_ROP_OR);
+     SSD1306_GfxBlend(dev, x + gap + filled, y + gap, inner - filled, height - 2 * gap, NULL, 0, SSD1306_ROP_CLEAR);
+ }
+ 
+ /**
+  * @brief Combina un rectángulo de píxeles de la fuente con el framebuffer.
+  *
+  * @param dev Instancia del display.
+  * @param x Columna destino de la primera columna de la fuente.
+  * @param y Fila destino de la primera fila de la fuente.
+  * @param width Ancho en columnas.
+  * @param height Alto en filas.
+  * @param data Fuente en orden de página, o NULL para un rectángulo lleno.
+  * @param stride Bytes entre una banda de 8 filas de la fuente y la siguiente.
+  * @param rop Operación de combinación.
+  *
+  * @note La fila de destino y se descompone en una página y un desplazamiento s (0 a 7):
+  *       cada byte destino toma los 8 - s bits bajos de una banda de la fuente y los s
+  *       bits altos de la banda anterior. La máscara de filas de la página se calcula
+  *       una vez y deja fuera las filas que no son del rectángulo.
+  */
+ static void SSD1306_GfxBlend(SSD1306_t* dev, int16_t x, int16_t y, int16_t width, int16_t height,
+                              const uint8_t* data, uint16_t stride, SSD1306_Rop_t rop) {
+ 
+     int16_t colStart = (x < 0) ? 0 : x;
+     int16_t colEnd = x + width - 1;
+     int16_t pageStart = (y < 0) ? 0 : (y >> 3);
+     int16_t pageEnd = (y + height - 1) >> 3;
+     uint8_t shift = y & 7;
+     int16_t bandOffset = (y - shift) / 8;
+     uint32_t laneHigh = GFX_LANES(0xFF << shift);
+     uint32_t laneLow = GFX_LANES(0xFF >> (8 - shift));
+ 
+     if (width <= 0 || height <= 0) return;
+     if (colEnd >= dev->width) colEnd = dev->width - 1;
+     if (pageEnd >= dev->pages) pageEnd = dev->pages - 1;
+     if (colStart > colEnd || y + height <= 0 || pageStart > pageEnd) return;
+ 
+     uint8_t count = colEnd - colStart + 1;
+     uint16_t srcColumn = colStart - x;
+ 
+     for (int16_t page = pageStart; page <= pageEnd; page++) {
+ 
+         //Banda de la fuente que cae alineada en esta página y la anterior, que aporta los bits altos
+         int16_t band = page - bandOffset;
+         uint8_t rowMask = SSD1306_GfxRowMask(band, height) << shift;
+         const uint8_t* low = NULL;
+         const uint8_t* high = NULL;
+ 
+         if (shift > 0) rowMask |= SSD1306_GfxRowMask(band - 1, height) >> (8 - shift);
+         if (data != NULL) {
+             if (SSD1306_GfxRowMask(band, height)) low = &data[band * stride + srcColumn];
+             if (shift > 0 && SSD1306_GfxRowMask(band - 1, height)) high = &data[(band - 1) * stride + srcColumn];
+         }
+ 
+         uint32_t mask = GFX_LANES(rowMask);
+         uint8_t* row = SSD1306_EditRow(dev, page, colStart, colEnd);
+ 
+         for (uint8_t i = 0; i < count; i += 4) {
+ 
+             uint8_t n = (count - i < 4) ? count - i : 4;
+             uint32_t src = 0xFFFFFFFFu;
+ 
+             if (data != NULL) {
+                 uint32_t lowWord = (low != NULL) ? SSD1306_GfxLoad(&low[i], n) : 0;
+                 uint32_t highWord = (high != NULL) ? SSD1306_GfxLoad(&high[i], n) : 0;
+                 src = (shift == 0) ? lowWord
+                                    : ((lowWord << shift) & laneHigh) | ((highWord >> (8 - shift)) & laneLow);
+             }
+             src &= mask;
+ 
+             uint32_t dst = SSD1306_GfxLoad(&row[i], n);
+ 
+             switch (rop) {
+             case SSD1306_ROP_COPY:  dst = (dst & ~mask) | src; break;
+             case SSD1306_ROP_OR:    dst |= src;                break;
+             case SSD1306_ROP_XOR:   dst ^= src;                break;
+             case SSD1306_ROP_CLEAR: dst &= ~src;               break;
+             }
+ 
+             SSD1306_GfxStore(&row[i], dst, n);
+         }
+     }
+ }
+ 
+ /**
+  * @brief Devuelve las filas válidas de una banda de 8 filas de la fuente (0 si la banda no existe).
+  */
+ static uint8_t SSD1306_GfxRowMask(int16_t band, int16_t height) {
+ 
+     int16_t rows = height - band * 8;
+ 
+     if (band < 0 || rows <= 0) return 0x00;
+     if (rows >= 8) return 0xFF;
+     return (uint8_t)((1u << rows) - 1);
+ }
+ 
+ /**
+  * @brief Carga hasta 4 columnas consecutivas en una palabra, una por byte.
+  *
+  * @note Las 4 columnas se leen con un solo acceso (el Cortex-M4 admite accesos de 32 bits
+  *       no alineados); el resto de una fila se arma byte a byte. Ambos casos usan el mismo
+  *       orden que SSD1306_GfxStore(), que es lo único que importa al operar por byte.
+  */
+ static inline uint32_t SSD1306_GfxLoad(const uint8_t* src, uint8_t count) {
+ 
+     uint32_t word = 0;
+ 
+     if (count == 4) {
+         memcpy(&word, src, sizeof(word));
+         return word;
+     }
+     for (uint8_t i = 0; i < count; i++) word |= (uint32_t)src[i] << (8 * i);
+     return word;
+ }
+ 
+ /**
+  * @brief Guarda hasta 4 columnas cargadas con SSD1306_GfxLoad().
+  */
+ static inline void SSD1306_GfxStore(uint8_t* dst, uint32_t word, uint8_t count) {
+ 
+     if (count == 4) {
+         memcpy(dst, &word, sizeof(word));
+         return;
+     }
+     for (uint8_t i = 0; i < count; i++) dst[i] = (uint8_t)(word >> (8 * i));
+ }
+ 
+ #ifdef SSD1306_GFX_BENCHMARK
+ 
+ /**
+  * @brief Mide los ciclos de CPU de dibujar glifos de 15x21 en filas no alineadas.
+  *
+  * Dibuja los dígitos x3 con XOR recorriendo los 8 desplazamientos verticales.
+  * Pensado para inspeccionar el resultado desde el depurador.
+  *
+  * @param dev Display sobre cuyo framebuffer se dibuja; no se envía nada, pero el
+  *            contenido queda modificado (conviene llamar luego a SSD1306_Clear()).
+  * @param result Resultado de la medición.
+  * @param iterations Cantidad de glifos dibujados.
+  */
+ void SSD1306_GfxBenchmark(SSD1306_t* dev, SSD1306_GfxBenchmark_t* result, uint32_t iterations) {
+ 
+     const font_t* font = &FontDigits3x;
+     SSD1306_Bitmap_t glyph = { font->width, font->pages * 8, NULL };
+     uint32_t start;
+ 
+     if (result == NULL) return;
+ 
+     cyclesInit();
+     result->iterations = iterations;
+     result->pixels = iterations * glyph.width * glyph.height;
+ 
+     start = cyclesNow();
+     for (uint32_t i = 0; i < iterations; i++) {
+         glyph.data = fontGlyph(font, (char)('0' + i % 10));
+         SSD1306_GfxBlit(dev, (int16_t)((i * 7) % (dev->width - glyph.width)), (int16_t)(i % 8), &glyph, SSD1306_ROP_XOR);
+     }
+     result->cycles = cyclesNow() - start;
+ }
+ 
+ #endif /* SSD1306_GFX_BENCHMARK */
@@ -0,0 +1,205 @@
+/**
+ * @file SSD1306_Hud.c
+ * @brief Implementación de la pantalla de diagnóstico del display SSD1306.
+ *
+ * Las etiquetas se dibujan una sola vez al mostrar la pantalla y cada valor es un
+ * campo retenido alineado a la derecha, por lo que un valor que no cambia no genera
+ * tráfico en el bus.
+ *
+ */
+
+ #include "../../Drivers/API/Inc/SSD1306_Hud.h"
+ #include "../../Drivers/API/Inc/API_format.h"
+ 
+ /// @brief Celda donde comienzan los valores (después de la etiqueta más larga).
+ #define HUD_VALUE_X         10
+ 
+ /**
+  * @brief Filas de cada página: etiqueta, decimales del valor y unidad.
+  */
+ static const struct {
+     const char* label;
+     uint8_t decimals;
+     const char* unit;
+ } SSD1306_HudRows[SSD1306_HUD_PAGES][SSD1306_HUD_ROWS] = {
+     {
+         { "Muestreo",   1, "Hz"  },
+         { "Latencia",   0, "us"  },
+         { "Cuadros",    0, "fps" },
+         { "Bus",        0, "%"   },
+         { "Lazo",       0, "/s"  },
+         { "Invalidas",  0, ""    },
+         { "Perdidas",   0, ""    },
+         { "Pila libre", 0, "B"   },
+     },
+     {
+         { "Ventana",    0, ""    },
+         { "Media",      1, "mm"  },
+         { "Desvio",     1, "mm"  },
+         { "Minima",     0, "mm"  },
+         { "Maxima",     0, "mm"  },
+         { "Mediana",    0, "mm"  },
+         { "P95",        0, "mm"  },
+         { "Descartes",  0, ""    },
+     },
+ };
+ 
+ static void SSD1306_HudDrawValue(SSD1306_Hud_t* hud, uint8_t row);
+ static uint32_t SSD1306_HudRate(uint32_t count, uint32_t last, uint32_t scale, uint32_t elapsed);
+ 
+ /**
+  * @brief Inicializa la pantalla de diagnóstico, oculta.
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @param dev Display donde se muestra.
+  */
+ void SSD1306_HudInit(SSD1306_Hud_t* hud, SSD1306_t* dev) {
+ 
+     assert(hud != NULL);
+     assert(dev != NULL);
+ 
+     memset(hud, 0, sizeof(*hud));
+     hud->dev = dev;
+     hud->windowStart = SSD1306_Port_GetTick();
+ }
+ 
+ /**
+  * @brief Borra el display y muestra la página actual de la pantalla de diagnóstico con los últimos valores.
+  *
+  * @param hud Pantalla de diagnóstico.
+  *
+  * @note En paneles de menos de 8 páginas se muestran solo las primeras filas.
+  */
+ void SSD1306_HudShow(SSD1306_Hud_t* hud) {
+ 
+     SSD1306_t* dev = hud->dev;
+     uint8_t cells = dev->width / SSD1306_CHAR_CELL_WIDTH;
+     uint8_t rows = (dev->pages < SSD1306_HUD_ROWS) ? dev->pages : SSD1306_HUD_ROWS;
+ 
+     SSD1306_Clear(dev);
+ 
+     for (uint8_t row = 0; row < rows; row++) {
+         SSD1306_DrawText(dev, 0, row, HUD_VALUE_X, SSD1306_HudRows[hud->page][row].label, SSD1306_ALIGN_LEFT);
+         SSD1306_FieldInit(&hud->fields[row], dev, HUD_VALUE_X, row, cells - HUD_VALUE_X, SSD1306_ALIGN_RIGHT);
+         SSD1306_HudDrawValue(hud, row);
+     }
+ 
+     hud->visible = true;
+ }
+ 
+ /**
+  * @brief Pasa a la página siguiente de la pantalla de diagnóstico.
+  *
+  * @param hud Pantalla de diagnóstico.
+  */
+ void SSD1306_HudNextPage(SSD1306_Hud_t* hud) {
+ 
+     hud->page = (hud->page + 1) % SSD1306_HUD_PAGES;
+     if (hud->visible) SSD1306_HudShow(hud);
+ }
+ 
+ /**
+  * @brief Oculta la pantalla de diagnóstico.
+  *
+  * @param hud Pantalla de diagnóstico.
+  */
+ void SSD1306_HudHide(SSD1306_Hud_t* hud) {
+     hud->visible = false;
+ }
+ 
+ /**
+  * @brief Indica si la pantalla de diagnóstico está visible.
+  *
+  * @param hud Pantalla de diagnóstico.
+  */
+ bool SSD1306_HudVisible(const SSD1306_Hud_t* hud) {
+     return hud->visible;
+ }
+ 
+ /**
+  * @brief Indica si pasó el período y corresponde tomar las métricas.
+  *
+  * @param hud Pantalla de diagnóstico.
+  */
+ bool SSD1306_HudDue(const SSD1306_Hud_t* hud) {
+     return (SSD1306_Port_GetTick() - hud->windowStart) >= SSD1306_HUD_PERIOD_MS;
+ }
+ 
+ /**
+  * @brief Calcula las tasas del período y, si está visible, actualiza la pantalla.
+  *
+  * @param hud Pantalla de diagnóstico.
+  * @param metrics Métricas actuales.
+  *
+  * @note Las tasas se calculan con el tiempo realmente transcurrido, aunque la llamada
+  *       llegue después del período.
+  */
+ void SSD1306_HudUpdate(SSD1306_Hud_t* hud, const SSD1306_HudMetrics_t* metrics) {
+ 
+     assert(metrics != NULL);
+ 
+     uint32_t now = SSD1306_Port_GetTick();
+     uint32_t elapsed = now - hud->windowStart;
+     const SSD1306_HudMetrics_t* last = &hud->last;
+ 
+     if (elapsed == 0) return;
+ 
+     uint32_t* values = hud->values[0];
+     values[0] = SSD1306_HudRate(metrics->samples, last->samples, 10000u, elapsed);
+     values[1] = metrics->latencyUs;
+     values[2] = SSD1306_HudRate(metrics->frames, last->frames, 1000u, elapsed);
+     values[3] = metrics->busBusyPercent;
+     values[4] = SSD1306_HudRate(metrics->loops, last->loops, 1000u, elapsed);
+     values[5] = metrics->invalidFrames;
+     values[6] = metrics->droppedFrames;
+     values[7] = metrics->freeStack;
+ 
+     values = hud->values[1];
+     values[0] = metrics->windowSamples;
+     values[1] = metrics->meanTenths;
+     values[2] = metrics->stddevTenths;
+     values[3] = metrics->minDistance;
+     values[4] = metrics->maxDistance;
+     values[5] = metrics->median;
+     values[6] = metrics->p95;
+     values[7] = metrics->rejectedSamples;
+ 
+     hud->last = *metrics;
+     hud->windowStart = now;
+ 
+     if (!hud->visible) return;
+ 
+     for (uint8_t row = 0; row < SSD1306_HUD_ROWS && row < hud->dev->pages; row++) {
+         SSD1306_HudDrawValue(hud, row);
+     }
+ }
+ 
+ /**
+  * @brief Escribe el valor de una fila de la página actual con sus decimales y su unidad.
+  */
+ static void SSD1306_HudDrawValue(SSD1306_Hud_t* hud, uint8_t row) {
+ 
+     char buffer[SSD1306_FIELD_MAX_CHARS + 1];
+     size_t len;
+     uint32_t value = hud->values[hud->page][row];
+ 
+     if (SSD1306_HudRows[hud->page][row].decimals > 0) {
+         len = formatFixed(buffer, sizeof(buffer), (int32_t)value, SSD1306_HudRows[hud->page][row].decimals);
+     } else {
+         len = formatUint(buffer, sizeof(buffer), value);
+     }
+ 
+     if (SSD1306_HudRows[hud->page][row].unit[0] != '\0') {
+         len += formatString(&buffer[len], sizeof(buffer) - len, " ");
+         formatString(&buffer[len], sizeof(buffer) - len, SSD1306_HudRows[hud->page][row].unit);
+     }
+ 
+     SSD1306_FieldSetText(&hud->fields[row], buffer);
+ }
+ 
+ /**
+  * @brief Tasa de un contador acumulado en el período: (count - last) * scale / elapsed.
+  */
+ static uint32_t SSD1306_HudRate(uint32_t count, uint32_t last, uint32_t scale, uint32_t elapsed) {
+     return (uint32_t)((uint64_t)(count - last) * scale / elapsed);
+ }
@@ -3,8 +3,8 @@
  * @brief Implementación de funciones de bajo nivel para la comunicación con la pantalla SSD1306.
  *
  * Este archivo proporciona una capa de abstracción para la transmisión de comandos y datos
- * hacia la pantalla OLED SSD1306 a través del bus I2C u otros métodos de comunicación,
- * dependiendo de la plataforma utilizada.
+ * hacia la pantalla OLED SSD1306 a través del bus I2C o de SPI 4 hilos (según
+ * SSD1306_TRANSPORT), dependiendo de la plataforma utilizada.
  *
  * @details
  * Funciones principales:
@@ -19,22 +19,196 @@
  */
 
  #include "../../Drivers/API/Inc/SSD1306_Port.h"
+ 
+ #if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI && !defined(HAL_SPI_MODULE_ENABLED)
+ #error "SSD1306_TRANSPORT_SPI requiere habilitar el periférico SPI (HAL_SPI_MODULE_ENABLED)"
+ #endif
 
- extern I2C_HandleTypeDef hi2c1;
+ void SSD1306_Error_Handler(void);
  
- #define SSD1306_I2C_ADDR         0x78 // Dirección I2C (0x3C << 1)
+ extern void SSD1306_TxCpltCallback(SSD1306_Bus_t* bus);
  
- void SSD1306_Error_Handler(void);
+ /// @brief Buses registrados, para despachar los callbacks de la HAL al bus correspondiente.
+ static SSD1306_Bus_t* buses;
+ 
+ static SSD1306_Bus_t* SSD1306_Port_FindBus(void* handle);
+ 
+ /**
+  * @brief Inicializa un bus y lo registra para recibir los callbacks del periférico.
+  *
+  * @param[in] bus Bus a inicializar.
+  * @param[in] handle Handle del periférico I2C o SPI ya configurado (por ejemplo &hi2c1).
+  */
+ void SSD1306_Port_BusInit(SSD1306_Bus_t* bus, void* handle){
+ 
+	 memset(bus, 0, sizeof(*bus));
+	 bus->handle = handle;
+ 
+	 bus->next = buses;
+	 buses = bus;
+ 
+ }
+ 
+ /**
+  * @brief Asigna los pines D/C y CS de un bus SPI y los deja en reposo (CS en alto).
+  *
+  * @param[in] bus Bus ya inicializado.
+  * @param[in] dcPort Puerto del pin D/C.
+  * @param[in] dcPin Pin D/C.
+  * @param[in] csPort Puerto del pin CS.
+  * @param[in] csPin Pin CS.
+  */
+ void SSD1306_Port_SetPins(SSD1306_Bus_t* bus, void* dcPort, uint16_t dcPin, void* csPort, uint16_t csPin){
+ 
+	 bus->dcPort = dcPort;
+	 bus->dcPin = dcPin;
+	 bus->csPort = csPort;
+	 bus->csPin = csPin;
+ 
+	 HAL_GPIO_WritePin((GPIO_TypeDef *)bus->csPort, bus->csPin, GPIO_PIN_SET);
+ 
+ }
+ 
+ #if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+ 
+ /**
+  * @brief Selecciona comando o datos con el pin D/C y baja CS para iniciar una transacción SPI.
+  *
+  * @param[in] bus Bus del display.
+  * @param[in] control Byte de control I2C equivalente: con el bit D/C# (0x40) en uno se envían datos.
+  */
+ static void SSD1306_SPI_Begin(SSD1306_Bus_t* bus, uint8_t control){
+ 
+	 HAL_GPIO_WritePin((GPIO_TypeDef *)bus->dcPort, bus->dcPin, (control & 0x40) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+	 HAL_GPIO_WritePin((GPIO_TypeDef *)bus->csPort, bus->csPin, GPIO_PIN_RESET);
+ 
+ }
+ 
+ /**
+  * @brief Envía datos al display SSD1306 mediante SPI en modo bloqueante.
+  *
+  * @param[in] bus Bus del display.
+  * @param[in] address No se usa en SPI (el display se elige con el pin CS del bus).
+  * @param[in] control Byte de control I2C equivalente, traducido al pin D/C.
+  * @param[in] pData Puntero al buffer de datos a transmitir.
+  * @param[in] Size Cantidad de bytes a transmitir.
+  */
+ void SSD1306_I2C_Transmit(SSD1306_Bus_t* bus, uint8_t address, uint8_t control, const uint8_t *pData, uint16_t Size){
+ 
+	 (void)address;
+ 
+	 bus->stats.transactions++;
+	 bus->stats.bytes += Size;
+ 
+	 SSD1306_SPI_Begin(bus, control);
+	 HAL_StatusTypeDef err = HAL_SPI_Transmit((SPI_HandleTypeDef *)bus->handle, (uint8_t *)pData, Size, HAL_MAX_DELAY);
+	 HAL_GPIO_WritePin((GPIO_TypeDef *)bus->csPort, bus->csPin, GPIO_PIN_SET);
+ 
+	 if(err != HAL_OK){
+		 SSD1306_Error_Handler();
+	 }
+ 
+ }
+ 
+ /**
+  * @brief Inicia el envío de datos al display SSD1306 mediante SPI y DMA.
+  *
+  * @param[in] bus Bus del display.
+  * @param[in] address No se usa en SPI.
+  * @param[in] control Byte de control I2C equivalente, traducido al pin D/C.
+  * @param[in] pData Puntero al buffer de datos a transmitir.
+  * @param[in] Size Cantidad de bytes a transmitir.
+  *
+  * @note CS queda en bajo hasta HAL_SPI_TxCpltCallback().
+  */
+ void SSD1306_I2C_Transmit_DMA(SSD1306_Bus_t* bus, uint8_t address, uint8_t control, const uint8_t *pData, uint16_t Size){
+ 
+	 (void)address;
+ 
+	 bus->stats.transactions++;
+	 bus->stats.bytes += Size;
+ 
+	 SSD1306_SPI_Begin(bus, control);
+	 HAL_StatusTypeDef err = HAL_SPI_Transmit_DMA((SPI_HandleTypeDef *)bus->handle, (uint8_t *)pData, Size);
+ 
+	 if(err != HAL_OK){
+		 SSD1306_Error_Handler();
+	 }
+ 
+ }
+ 
+ /**
+  * @brief Callback de HAL llamado al completarse una transmisión SPI por DMA.
+  *
+  * @param[in] hspi Puntero a la estructura SPI_HandleTypeDef.
+  * @note Sube CS y avanza la cola de transferencias del bus que terminó.
+  */
+ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi){
+ 
+	 SSD1306_Bus_t* bus = SSD1306_Port_FindBus(hspi);
+ 
+	 if(bus != NULL){
+		 HAL_GPIO_WritePin((GPIO_TypeDef *)bus->csPort, bus->csPin, GPIO_PIN_SET);
+		 SSD1306_TxCpltCallback(bus);
+	 }
+ 
+ }
+ 
+ /**
+  * @brief Callback de HAL llamado ante un error en el bus SPI.
+  *
+  * @param[in] hspi Puntero a la estructura SPI_HandleTypeDef.
+  */
+ void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){
+ 
+	 if(SSD1306_Port_FindBus(hspi) != NULL){
+		 SSD1306_Error_Handler();
+	 }
+ 
+ }
+ 
+ #else
+ 
+ /**
+  * @brief Envía datos al display SSD1306 mediante I2C en modo bloqueante.
+  *
+  * @param[in] bus Bus del display.
+  * @param[in] address Dirección I2C de 7 bits del display.
+  * @param[in] control Byte de control (comando o datos) que precede al bloque.
+  * @param[in] pData Puntero al buffer de datos a transmitir.
+  * @param[in] Size Cantidad de bytes a transmitir.
+  *
+  * @note El byte de control se envía como "dirección de memoria" de 8 bits, de modo que
+  *       los datos se leen directamente del buffer del llamador sin copias intermedias.
+  */
+ void SSD1306_I2C_Transmit(SSD1306_Bus_t* bus, uint8_t address, uint8_t control, const uint8_t *pData, uint16_t Size){
+ 
+	 bus->stats.transactions++;
+	 bus->stats.bytes += Size + 1;
+ 
+	 HAL_StatusTypeDef err = HAL_I2C_Mem_Write((I2C_HandleTypeDef *)bus->handle, address << 1, control, I2C_MEMADD_SIZE_8BIT, (uint8_t *)pData, Size, HAL_MAX_DELAY);
+ 
+	 if(err != HAL_OK){
+		 SSD1306_Error_Handler();
+	 }
+ 
+ }
  
  /**
-  * @brief Envía datos al display SSD1306 mediante I2C.
+  * @brief Inicia el envío de datos al display SSD1306 mediante I2C y DMA.
   *
+  * @param[in] bus Bus del display.
+  * @param[in] address Dirección I2C de 7 bits del display.
+  * @param[in] control Byte de control (comando o datos) que precede al bloque.
   * @param[in] pData Puntero al buffer de datos a transmitir.
   * @param[in] Size Cantidad de bytes a transmitir.
   */
- void SSD1306_I2C_Transmit(uint8_t *pData, uint16_t Size){
+ void SSD1306_I2C_Transmit_DMA(SSD1306_Bus_t* bus, uint8_t address, uint8_t control, const uint8_t *pData, uint16_t Size){
+ 
+	 bus->stats.transactions++;
+	 bus->stats.bytes += Size + 1;
  
-	 HAL_StatusTypeDef err = HAL_I2C_Master_Transmit(&hi2c1, SSD1306_I2C_ADDR, pData, Size,  HAL_MAX_DELAY);
+	 HAL_StatusTypeDef err = HAL_I2C_Mem_Write_DMA((I2C_HandleTypeDef *)bus->handle, address << 1, control, I2C_MEMADD_SIZE_8BIT, (uint8_t *)pData, Size);
  
 	 if(err != HAL_OK){
 		 SSD1306_Error_Handler();
@@ -42,6 +216,85 @@
  
  }
  
+ /**
+  * @brief Callback de HAL llamado al completarse una escritura I2C por DMA.
+  *
+  * @param[in] hi2c Puntero a la estructura I2C_HandleTypeDef.
+  * @note Avanza la cola de transferencias de los displays del bus que terminó.
+  */
+ void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c){
+ 
+	 SSD1306_Bus_t* bus = SSD1306_Port_FindBus(hi2c);
+ 
+	 if(bus != NULL){
+		 SSD1306_TxCpltCallback(bus);
+	 }
+ 
+ }
+ 
+ /**
+  * @brief Callback de HAL llamado ante un error en el bus I2C.
+  *
+  * @param[in] hi2c Puntero a la estructura I2C_HandleTypeDef.
+  */
+ void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+ 
+	 if(SSD1306_Port_FindBus(hi2c) != NULL){
+		 SSD1306_Error_Handler();
+	 }
+ 
+ }
+ 
+ #endif /* SSD1306_TRANSPORT */
+ 
+ /**
+  * @brief Devuelve el tiempo transcurrido desde el arranque, en milisegundos.
+  */
+ uint32_t SSD1306_Port_GetTick(void){
+ 
+	 return HAL_GetTick();
+ 
+ }
+ 
+ /**
+  * @brief Devuelve los contadores de tráfico acumulados desde el último reinicio.
+  *
+  * @param[in] bus Bus consultado.
+  * @return Copia de los contadores de transacciones y bytes.
+  */
+ SSD1306_PortStats_t SSD1306_Port_GetStats(const SSD1306_Bus_t* bus){
+ 
+	 return bus->stats;
+ 
+ }
+ 
+ /**
+  * @brief Reinicia los contadores de tráfico del bus.
+  *
+  * @param[in] bus Bus a reiniciar.
+  */
+ void SSD1306_Port_ResetStats(SSD1306_Bus_t* bus){
+ 
+	 memset(&bus->stats, 0, sizeof(bus->stats));
+ 
+ }
+ 
+ /**
+  * @brief Busca el bus registrado para un periférico.
+  *
+  * @param[in] handle Handle del periférico que generó el callback.
+  * @return Bus asociado, o NULL si el periférico no pertenece a un display.
+  */
+ static SSD1306_Bus_t* SSD1306_Port_FindBus(void* handle){
+ 
+	 for(SSD1306_Bus_t* bus = buses; bus != NULL; bus = bus->next){
+		 if(bus->handle == handle) return bus;
+	 }
+ 
+	 return NULL;
+ 
+ }
+ 
  /**
   * @brief Manejador de errores para la comunicación I2C.
   *
@@ -0,0 +1,167 @@
+/**
+ * @file SSD1306_Refresh.c
+ * @brief Implementación del limitador de refresco del display SSD1306.
+ *
+ * La ocupación del bus se estima a partir de los contadores de transacciones y bytes
+ * del bus, con los bits por transacción y por byte del transporte elegido
+ * (SSD1306_PORT_FRAME_BITS y SSD1306_PORT_BYTE_BITS), por lo que incluye el tráfico
+ * de todos los displays conectados al mismo bus.
+ * El presupuesto funciona como un crédito de tiempo de bus que crece con el tiempo
+ * transcurrido y se consume con cada transferencia.
+ *
+ */
+
+ #include "../../Drivers/API/Inc/SSD1306_Refresh.h"
+ 
+ static void SSD1306_RefreshUpdateBus(SSD1306_Refresh_t* refresh, uint32_t now);
+ 
+ /**
+  * @brief Inicializa el limitador de un display.
+  *
+  * @param refresh Limitador a inicializar.
+  * @param dev Display ya inicializado.
+  * @param maxFps Tasa máxima de cuadros por segundo (1 a 1000).
+  * @param busBudget Porcentaje máximo del bus que puede ocupar el display (1 a 100).
+  * @param busClockHz Frecuencia del bus.
+  */
+ void SSD1306_RefreshInit(SSD1306_Refresh_t* refresh, SSD1306_t* dev, uint16_t maxFps, uint8_t busBudget, uint32_t busClockHz) {
+ 
+     assert(refresh != NULL);
+     assert(dev != NULL);
+     assert(busBudget > 0 && busBudget <= 100);
+     assert(busClockHz > 0);
+ 
+     SSD1306_PortStats_t stats = SSD1306_Port_GetStats(dev->bus);
+     uint32_t now = SSD1306_Port_GetTick();
+ 
+     memset(refresh, 0, sizeof(*refresh));
+     refresh->dev = dev;
+     refresh->busBudget = busBudget;
+     refresh->busClockHz = busClockHz;
+     refresh->lastTransactions = stats.transactions;
+     refresh->lastBytes = stats.bytes;
+     refresh->lastTick = now;
+     refresh->windowStart = now;
+     refresh->creditUs = (int32_t)(SSD1306_REFRESH_WINDOW_MS * 10u * busBudget);
+ 
+     SSD1306_RefreshSetFps(refresh, maxFps);
+ 
+     //El primer cuadro no espera el período
+     refresh->lastFrame = now - refresh->framePeriod;
+ }
+ 
+ /**
+  * @brief Cambia la tasa máxima de cuadros.
+  *
+  * @param refresh Limitador del display.
+  * @param maxFps Tasa máxima de cuadros por segundo (1 a 1000).
+  */
+ void SSD1306_RefreshSetFps(SSD1306_Refresh_t* refresh, uint16_t maxFps) {
+ 
+     assert(refresh != NULL);
+     assert(maxFps > 0 && maxFps <= 1000);
+ 
+     refresh->framePeriod = 1000u / maxFps;
+ }
+ 
+ /**
+  * @brief Indica que hay contenido nuevo para mostrar.
+  *
+  * @param refresh Limitador del display.
+  */
+ void SSD1306_RefreshRequest(SSD1306_Refresh_t* refresh) {
+ 
+     if (refresh->pending) refresh->stats.updatesCoalesced++;
+     refresh->pending = true;
+ }
+ 
+ /**
+  * @brief Indica si corresponde dibujar y enviar un cuadro.
+  *
+  * @param refresh Limitador del display.
+  * @return true si hay que dibujar los últimos valores y llamar a SSD1306_RefreshFlush().
+  */
+ bool SSD1306_RefreshDue(SSD1306_Refresh_t* refresh) {
+ 
+     uint32_t now = SSD1306_Port_GetTick();
+ 
+     SSD1306_RefreshUpdateBus(refresh, now);
+ 
+     if (!refresh->pending) return false;
+     if ((now - refresh->lastFrame) < refresh->framePeriod) return false;
+     if (SSD1306_FlushBusy(refresh->dev)) return false;
+ 
+     //Sin presupuesto de bus el cuadro se posterga, pero sigue pendiente con el último valor
+     if (refresh->creditUs <= 0) {
+         if (!refresh->deferred) refresh->stats.framesDeferred++;
+         refresh->deferred = true;
+         return false;
+     }
+ 
+     return true;
+ }
+ 
+ /**
+  * @brief Envía el cuadro dibujado y lo registra.
+  *
+  * @param refresh Limitador del display.
+  */
+ void SSD1306_RefreshFlush(SSD1306_Refresh_t* refresh) {
+ 
+     SSD1306_Flush(refresh->dev);
+ 
+     refresh->lastFrame = SSD1306_Port_GetTick();
+     refresh->pending = false;
+     refresh->deferred = false;
+     refresh->stats.framesDrawn++;
+ }
+ 
+ /**
+  * @brief Devuelve los contadores del limitador.
+  *
+  * @param refresh Limitador consultado.
+  */
+ SSD1306_RefreshStats_t SSD1306_RefreshGetStats(const SSD1306_Refresh_t* refresh) {
+     return refresh->stats;
+ }
+ 
+ /**
+  * @brief Descuenta del crédito el tiempo de bus usado desde la última llamada y cierra la ventana de ocupación.
+  *
+  * @param refresh Limitador del display.
+  * @param now Tick actual.
+  */
+ static void SSD1306_RefreshUpdateBus(SSD1306_Refresh_t* refresh, uint32_t now) {
+ 
+     SSD1306_PortStats_t stats = SSD1306_Port_GetStats(refresh->dev->bus);
+     uint32_t elapsed = now - refresh->lastTick;
+     uint32_t usedUs = 0;
+     int32_t maxCredit = (int32_t)(SSD1306_REFRESH_WINDOW_MS * 10u * refresh->busBudget);
+ 
+     //Si los contadores del bus se reiniciaron no se descuenta nada en esta llamada
+     if (stats.transactions >= refresh->lastTransactions && stats.bytes >= refresh->lastBytes) {
+         uint64_t bits = (uint64_t)(stats.transactions - refresh->lastTransactions) * SSD1306_PORT_FRAME_BITS
+                       + (uint64_t)(stats.bytes - refresh->lastBytes) * SSD1306_PORT_BYTE_BITS;
+         usedUs = (uint32_t)(bits * 1000000u / refresh->busClockHz);
+     }
+ 
+     refresh->lastTransactions = stats.transactions;
+     refresh->lastBytes = stats.bytes;
+     refresh->lastTick = now;
+ 
+     //El crédito crece con el porcentaje asignado del tiempo transcurrido, hasta una ventana
+     int64_t credit = (int64_t)refresh->creditUs + (int64_t)elapsed * 10 * refresh->busBudget - usedUs;
+     if (credit > maxCredit) credit = maxCredit;
+     if (credit < -maxCredit) credit = -maxCredit;
+     refresh->creditUs = (int32_t)credit;
+ 
+     refresh->windowBusyUs += usedUs;
+ 
+     uint32_t windowElapsed = now - refresh->windowStart;
+     if (windowElapsed >= SSD1306_REFRESH_WINDOW_MS) {
+         uint32_t percent = (uint32_t)((uint64_t)refresh->windowBusyUs * 100u / ((uint64_t)windowElapsed * 1000u));
+         refresh->stats.busBusyPercent = (uint8_t)(percent > 100 ? 100 : percent);
+         refresh->windowBusyUs = 0;
+         refresh->windowStart = now;
+     }
+ }
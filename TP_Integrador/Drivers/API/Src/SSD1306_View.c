@@ -0,0 +1,398 @@
+/**
+ * @file SSD1306_View.c
+ * @brief Implementación de las pantallas de medición y de gráfico sobre un display SSD1306.
+ *
+ * Las funciones Print* solo actualizan campos retenidos y el gráfico de la vista:
+ * el framebuffer del display cambia únicamente donde cambió el texto, y el
+ * contenido llega al panel con el próximo SSD1306_Flush().
+ * Las etiquetas fijas de la pantalla de medición no se dibujan: vienen en las
+ * imágenes generadas por Tools/splashgen.py (SSD1306_Splash.c), que se envían
+ * enteras al mostrar la pantalla.
+ *
+ */
+
+ #include "../../Drivers/API/Inc/SSD1306_View.h"
+ #include "../../Drivers/API/Inc/SSD1306_Splash.h"
+ #include "../../Drivers/API/Inc/API_format.h"
+ 
+ /// @brief Página que indica que un elemento no se muestra en la distribución.
+ #define LAYOUT_HIDDEN		0xFF
+ 
+ /// @brief Fuente y ancho en píxeles de la distancia actual.
+ #define DISTANCE_FONT		FontDigits2x
+ #define DISTANCE_WIDTH		(17 * SSD1306_CHAR_CELL_WIDTH)
+ 
+ /// @brief Pantalla de gráfico: celda donde comienza el tiempo de muestreo en la página 0.
+ #define CHART_SAMPLING_X	11
+ 
+ /// @brief Pantalla de gráfico: rango vertical en milímetros (alcance del TF-LC02).
+ #define CHART_MIN_MM		0
+ #define CHART_MAX_MM		2000
+ 
+ /**
+  * @brief Celda donde comienza el valor de cada etiqueta (0: sin campo de valor).
+  *
+  * La distancia actual se muestra con dígitos grandes debajo de su etiqueta, con la
+  * unidad en la celda 17. El resto de las etiquetas ocupa el inicio de su página y los
+  * valores numéricos se alinean a la derecha hasta el borde de la pantalla.
+  * Las etiquetas y la unidad están en la imagen de la distribución.
+  */
+ static const uint8_t SSD1306_ValueX[SSD1306_FIELD_VALUES_COUNT] = {
+     [SSD1306_FIELD_DISTANCIA] = 0,
+     [SSD1306_FIELD_MAXIMA]    = 7,
+     [SSD1306_FIELD_MINIMA]    = 7,
+     [SSD1306_FIELD_MUESTREO]  = 9,
+ };
+ 
+ /**
+  * @brief Páginas de cada elemento de las pantallas para una altura de panel.
+  *
+  * Las páginas de las etiquetas y de la unidad deben coincidir con las de Tools/splashgen.py.
+  */
+ struct SSD1306_Layout {
+     const SSD1306_Image_t* image;                   /**< Etiquetas fijas de la pantalla de medición. */
+     uint8_t fieldPage[SSD1306_FIELD_VALUES_COUNT];  /**< Página de cada etiqueta (LAYOUT_HIDDEN: no se muestra). */
+     uint8_t distancePage;                           /**< Página superior de los dígitos grandes. */
+     uint8_t calibPage;                              /**< Página del estado de calibración. */
+     uint8_t portPage;                               /**< Página del puerto configurado. */
+     uint8_t chartPageStart;                         /**< Primera página del gráfico (llega hasta la última). */
+ };
+ 
+ /// @brief Distribución para paneles de 64 filas: todos los elementos.
+ static const struct SSD1306_Layout SSD1306_Layout64 = {
+     .image = &SSD1306_SplashMeasure64,
+     .fieldPage = { 0, 3, 4, 5 },
+     .distancePage = 1,
+     .calibPage = 6,
+     .portPage = 7,
+     .chartPageStart = 1,
+ };
+ 
+ /// @brief Distribución para paneles de 32 filas: distancia, máxima y mínima.
+ static const struct SSD1306_Layout SSD1306_Layout32 = {
+     .image = &SSD1306_SplashMeasure32,
+     .fieldPage = { LAYOUT_HIDDEN, 2, 3, LAYOUT_HIDDEN },
+     .distancePage = 0,
+     .calibPage = LAYOUT_HIDDEN,
+     .portPage = LAYOUT_HIDDEN,
+     .chartPageStart = 1,
+ };
+ 
+ static void SSD1306_ViewPrepare(SSD1306_View_t* view);
+ static void SSD1306_ViewSetText(SSD1306_Field_t* field, uint8_t page, const char* str);
+ static void SSD1306_ViewSetSampling(SSD1306_View_t* view, const char* str);
+ static void SSD1306_FormatCm(char* buffer, size_t size, uint16_t mm);
+ 
+ /**
+  * @brief Asocia una vista a un display ya inicializado y muestra la pantalla de medición.
+  *
+  * @param view Vista a inicializar.
+  * @param dev Display de la vista.
+  *
+  * @note La distribución se elige por la altura del panel; los paneles de 32 filas
+  *       no muestran el muestreo ni la configuración en la pantalla de medición.
+  *       Reemplaza a SSD1306_Clear(): la imagen con las etiquetas fijas se envía
+  *       entera en una transacción y los valores se dibujan encima.
+  */
+ void SSD1306_ViewInit(SSD1306_View_t* view, SSD1306_t* dev) {
+ 
+     assert(view != NULL);
+     assert(dev != NULL);
+     assert(dev->pages >= 4);
+ 
+     view->dev = dev;
+     view->layout = (dev->pages >= 8) ? &SSD1306_Layout64 : &SSD1306_Layout32;
+     view->screen = SSD1306_SCREEN_MEASURE;
+     view->ready = false;
+     view->chartHead = 0;
+     view->chartCount = 0;
+ 
+     SSD1306_LoadImage(dev, view->layout->image);
+ }
+ 
+ /**
+  * @brief Inicializa los campos de la pantalla actual sobre su fondo (en blanco o la imagen de etiquetas).
+  */
+ static void SSD1306_ViewPrepare(SSD1306_View_t* view) {
+ 
+     const struct SSD1306_Layout* layout = view->layout;
+     SSD1306_t* dev = view->dev;
+     uint8_t cells = dev->width / SSD1306_CHAR_CELL_WIDTH;
+ 
+     if (view->ready) return;
+ 
+     if (view->screen == SSD1306_SCREEN_CHART) {
+         SSD1306_FieldInit(&view->chartValueField, dev, 0, 0, CHART_SAMPLING_X, SSD1306_ALIGN_LEFT);
+         SSD1306_FieldInit(&view->chartSamplingField, dev, CHART_SAMPLING_X, 0, cells - CHART_SAMPLING_X, SSD1306_ALIGN_RIGHT);
+         SSD1306_ChartInit(&view->chart, dev, layout->chartPageStart, dev->pages - 1, CHART_MIN_MM, CHART_MAX_MM);
+         view->ready = true;
+         return;
+     }
+ 
+     for (uint8_t i = 0; i < SSD1306_FIELD_VALUES_COUNT; i++) {
+         uint8_t page = layout->fieldPage[i];
+         uint8_t valueX = SSD1306_ValueX[i];
+         if (page == LAYOUT_HIDDEN || valueX == 0) continue;
+         SSD1306_FieldInit(&view->valueFields[i], dev, valueX, page, cells - valueX, SSD1306_ALIGN_RIGHT);
+     }
+ 
+     view->distanceText[0] = '\0';
+     if (layout->calibPage != LAYOUT_HIDDEN) {
+         SSD1306_FieldInit(&view->calibField, dev, 0, layout->calibPage, cells, SSD1306_ALIGN_LEFT);
+     }
+     if (layout->portPage != LAYOUT_HIDDEN) {
+         SSD1306_FieldInit(&view->portField, dev, 0, layout->portPage, cells, SSD1306_ALIGN_LEFT);
+     }
+ 
+     view->ready = true;
+ }
+ 
+ /**
+  * @brief Actualiza un campo de la pantalla de medición si la distribución lo muestra.
+  */
+ static void SSD1306_ViewSetText(SSD1306_Field_t* field, uint8_t page, const char* str) {
+ 
+     if (page == LAYOUT_HIDDEN) return;
+     SSD1306_FieldSetText(field, str);
+ }
+ 
+ /**
+  * @brief Actualiza el campo de muestreo de la pantalla actual.
+  */
+ static void SSD1306_ViewSetSampling(SSD1306_View_t* view, const char* str) {
+ 
+     if (view->screen == SSD1306_SCREEN_CHART) {
+         SSD1306_FieldSetText(&view->chartSamplingField, str);
+         return;
+     }
+ 
+     SSD1306_ViewSetText(&view->valueFields[SSD1306_FIELD_MUESTREO], view->layout->fieldPage[SSD1306_FIELD_MUESTREO], str);
+ }
+ 
+ /**
+  * @brief Arma el texto de una distancia: "%2d.%d[cm]" a partir de milímetros.
+  */
+ static void SSD1306_FormatCm(char* buffer, size_t size, uint16_t mm) {
+ 
+     size_t len = formatMmToCm(buffer, size, mm);
+     formatString(&buffer[len], size - len, "[cm]");
+ }
+ 
+ /**
+  * @brief Dibuja en el gráfico las muestras encoladas, con el scroll del panel solo si son pocas.
+  */
+ static void SSD1306_ViewDrainChart(SSD1306_View_t* view) {
+ 
+     uint8_t width = view->dev->width;
+ 
+     if (view->chartCount <= SSD1306_VIEW_CHART_SCROLLS) {
+         while (view->chartCount > 0) {
+             SSD1306_ChartPush(&view->chart, view->chartQueue[view->chartHead]);
+             view->chartHead = (view->chartHead + 1) % SSD1306_VIEW_CHART_QUEUE;
+             view->chartCount--;
+         }
+         return;
+     }
+ 
+     //Las muestras que no entran en el ancho del panel no se verían
+     if (view->chartCount > width) {
+         view->chartHead = (view->chartHead + view->chartCount - width) % SSD1306_VIEW_CHART_QUEUE;
+         view->chartCount = width;
+     }
+ 
+     //La cola es circular: se agrega en a lo sumo dos tramos contiguos
+     while (view->chartCount > 0) {
+         uint8_t run = SSD1306_VIEW_CHART_QUEUE - view->chartHead;
+         if (run > view->chartCount) run = view->chartCount;
+         SSD1306_ChartAppend(&view->chart, &view->chartQueue[view->chartHead], run);
+         view->chartHead = (view->chartHead + run) % SSD1306_VIEW_CHART_QUEUE;
+         view->chartCount -= run;
+     }
+ }
+ 
+ /**
+  * @brief Muestra las mediciones de distancia actual, máxima y mínima en el display OLED SSD1306.
+  *
+  * @param view Vista del display.
+  * @param Actual Medición actual en milímetros (dividido por 10 para mostrar en centímetros).
+  * @param Maxima Medición máxima registrada en milímetros.
+  * @param Minima Medición mínima registrada en milímetros.
+  *
+  * @note Solo se redibujan las celdas que cambiaron respecto del valor anterior de cada campo.
+  *       La distancia actual usa dígitos grandes y se redibuja solo si cambió su texto;
+  *       aun así, al bus llegan únicamente las columnas de los glifos que cambiaron.
+  *       En la pantalla de gráfico se dibujan todas las muestras encoladas con
+  *       SSD1306_PushSample() desde la llamada anterior. Hasta SSD1306_VIEW_CHART_SCROLLS
+  *       se agregan con el scroll del panel (una columna cada una); con más, el gráfico se
+  *       desplaza en el framebuffer y el flush envía lo que cambió, dentro del presupuesto
+  *       del bus y sin comandos 2Dh seguidos.
+  */
+ void SSD1306_PrintMesurement(SSD1306_View_t* view, uint16_t Actual, uint16_t Maxima, uint16_t Minima){
+ 
+     const struct SSD1306_Layout* layout = view->layout;
+     char buffer[SSD1306_VIEW_TEXT_LENGTH];
+ 
+     SSD1306_ViewPrepare(view);
+ 
+     if (view->screen == SSD1306_SCREEN_CHART) {
+         SSD1306_FormatCm(buffer, sizeof(buffer), Actual);
+         SSD1306_FieldSetText(&view->chartValueField, buffer);
+         SSD1306_ViewDrainChart(view);
+         return;
+     }
+ 
+     formatMmToCm(buffer, sizeof(buffer), Actual);
+     if (strcmp(buffer, view->distanceText) != 0) {
+         strcpy(view->distanceText, buffer);
+         SSD1306_DrawTextFont(view->dev, 0, layout->distancePage, DISTANCE_WIDTH, view->distanceText, &DISTANCE_FONT, SSD1306_ALIGN_RIGHT);
+     }
+ 
+     SSD1306_FormatCm(buffer, sizeof(buffer), Maxima);
+     SSD1306_ViewSetText(&view->valueFields[SSD1306_FIELD_MAXIMA], layout->fieldPage[SSD1306_FIELD_MAXIMA], buffer);
+ 
+     SSD1306_FormatCm(buffer, sizeof(buffer), Minima);
+     SSD1306_ViewSetText(&view->valueFields[SSD1306_FIELD_MINIMA], layout->fieldPage[SSD1306_FIELD_MINIMA], buffer);
+ 
+ }
+ 
+ /**
+  * @brief Encola una muestra para el gráfico.
+  *
+  * @param view Vista del display.
+  * @param value Distancia en milímetros.
+  *
+  * @note Con la cola llena sale la muestra más antigua: la cola tiene un ancho de panel,
+  *       por lo que al dibujarla esa muestra ya habría salido del gráfico por la izquierda.
+  */
+ void SSD1306_PushSample(SSD1306_View_t* view, uint16_t value){
+ 
+     if (view->screen != SSD1306_SCREEN_CHART) return;
+ 
+     if (view->chartCount == SSD1306_VIEW_CHART_QUEUE) {
+         view->chartHead = (view->chartHead + 1) % SSD1306_VIEW_CHART_QUEUE;
+         view->chartCount--;
+     }
+ 
+     view->chartQueue[(view->chartHead + view->chartCount) % SSD1306_VIEW_CHART_QUEUE] = value;
+     view->chartCount++;
+ }
+ 
+ 
+ /**
+  * @brief Muestra el tiempo de muestreo del sensor en el display OLED SSD1306.
+  *
+  * @param view Vista del display.
+  * @param muestreo Intervalo de muestreo en milisegundos.
+  */
+ void SSD1306_PrintMuestreo(SSD1306_View_t* view, uint32_t muestreo){
+ 
+     char buffer[SSD1306_VIEW_TEXT_LENGTH];
+     size_t len;
+ 
+     SSD1306_ViewPrepare(view);
+ 
+     len = formatUint(buffer, sizeof(buffer), muestreo);
+     formatString(&buffer[len], sizeof(buffer) - len, "[ms]");
+ 
+     SSD1306_ViewSetSampling(view, buffer);
+ }
+ 
+ /**
+  * @brief Muestra en el lugar del tiempo de muestreo la tasa lograda en modo continuo.
+  *
+  * @param view Vista del display.
+  * @param muestras Muestras por segundo.
+  */
+ void SSD1306_PrintRate(SSD1306_View_t* view, uint32_t muestras){
+ 
+     char buffer[SSD1306_VIEW_TEXT_LENGTH];
+     size_t len;
+ 
+     SSD1306_ViewPrepare(view);
+ 
+     len = formatUint(buffer, sizeof(buffer), muestras);
+     formatString(&buffer[len], sizeof(buffer) - len, "[/s]");
+ 
+     SSD1306_ViewSetSampling(view, buffer);
+ }
+ 
+ 
+ /**
+  * @brief Muestra la configuración del sensor (las etiquetas vienen en la imagen de la pantalla).
+  *
+  * @param view Vista del display.
+  * @param port Puerto configurado en el sensor.
+  * @param cal Estado de calibración del sensor.
+  */
+ void SSD1306_PrintSetup(SSD1306_View_t* view, uint8_t port, uint8_t cal){
+ 
+     const struct SSD1306_Layout* layout = view->layout;
+ 
+     SSD1306_ViewPrepare(view);
+ 
+     //La pantalla de gráfico no muestra etiquetas ni configuración
+     if (view->screen == SSD1306_SCREEN_CHART) return;
+ 
+     SSD1306_ViewSetText(&view->calibField, layout->calibPage,
+             (cal == 0x00) ? "Sin calibrar" :
+             (cal == 0x01) ? "Crosstalk calibrado" :
+             (cal == 0x02) ? "Offset calibrado" :
+             (cal == 0x03) ? "Calibracion completa" : "Desconocida");
+ 
+     SSD1306_ViewSetText(&view->portField, layout->portPage,
+             (port == 0x41) ? "UART+I2C" :
+             (port == 0x49) ? "Solo I2C" :
+             (port == 0x55) ? "Solo UART" : "Desconocido");
+ 
+ }
+ 
+ /**
+  * @brief Cambia la pantalla mostrada.
+  *
+  * @param view Vista del display.
+  * @param screen Pantalla a mostrar.
+  *
+  * @note Si la pantalla cambia se borra el display (la pantalla de medición se envía
+  *       con su imagen de etiquetas); el contenido se vuelve a dibujar con las
+  *       siguientes llamadas a SSD1306_PrintSetup(), SSD1306_PrintMuestreo()
+  *       y SSD1306_PrintMesurement().
+  */
+ void SSD1306_SetScreen(SSD1306_View_t* view, SSD1306_Screen_t screen){
+ 
+     if (screen == view->screen) return;
+ 
+     view->screen = screen;
+     SSD1306_ViewRedraw(view);
+ }
+ 
+ /**
+  * @brief Vuelve a dibujar el fondo de la pantalla actual.
+  *
+  * @param view Vista del display.
+  *
+  * @note Se usa cuando otra pantalla (por ejemplo la de diagnóstico) ocupó el display;
+  *       el contenido se vuelve a dibujar con las siguientes llamadas a las funciones Print*.
+  */
+ void SSD1306_ViewRedraw(SSD1306_View_t* view){
+ 
+     view->ready = false;
+ 
+     //Las muestras encoladas mientras otra pantalla ocupaba el display se descartan
+     view->chartHead = 0;
+     view->chartCount = 0;
+ 
+     if (view->screen == SSD1306_SCREEN_MEASURE) {
+         SSD1306_LoadImage(view->dev, view->layout->image);
+     } else {
+         SSD1306_Clear(view->dev);
+     }
+ }
+ 
+ /**
+  * @brief Devuelve la pantalla mostrada actualmente.
+  *
+  * @param view Vista del display.
+  */
+ SSD1306_Screen_t SSD1306_GetScreen(const SSD1306_View_t* view){
+     return view->screen;
+ }
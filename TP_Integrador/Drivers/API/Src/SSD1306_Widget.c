@@ -0,0 +1,121 @@
+/**
+ * @file SSD1306_Widget.c
+ * @brief Implementación de campos de texto retenidos para el display SSD1306.
+ *
+ * Cada campo guarda las celdas que muestra (texto alineado y rellenado con espacios).
+ * Al recibir un texto nuevo se compara celda por celda y solo los tramos distintos
+ * se rasterizan en el framebuffer; los valores sin cambios no cuestan bytes en el bus.
+ *
+ */
+
+ #include "../../Drivers/API/Inc/SSD1306_Widget.h"
+ 
+ static void SSD1306_FieldLayout(const SSD1306_Field_t* field, const char* str, char* cells);
+ 
+ /**
+  * @brief Inicializa un campo sobre un rango de celdas de una página.
+  *
+  * @param field Puntero al campo.
+  * @param dev Display donde se muestra el campo.
+  * @param x Celda inicial.
+  * @param page Página del display.
+  * @param width Ancho del campo en caracteres.
+  * @param align Alineación del texto dentro del campo.
+  */
+ void SSD1306_FieldInit(SSD1306_Field_t* field, SSD1306_t* dev, uint8_t x, uint8_t page, uint8_t width, SSD1306_Align_t align) {
+ 
+     assert(field != NULL);
+     assert(dev != NULL);
+ 
+     uint8_t cells = dev->width / SSD1306_CHAR_CELL_WIDTH;
+ 
+     assert(x < cells);
+     assert(page < dev->pages);
+ 
+     if (width > cells - x) width = cells - x;
+ 
+     field->dev = dev;
+     field->x = x;
+     field->page = page;
+     field->width = width;
+     field->align = align;
+ 
+     //Un rango en blanco equivale a un campo lleno de espacios
+     memset(field->shown, ' ', width);
+     field->shown[width] = '\0';
+     field->valid = true;
+ }
+ 
+ /**
+  * @brief Actualiza el texto de un campo redibujando solo las celdas que cambiaron.
+  *
+  * @param field Puntero al campo.
+  * @param str Texto nuevo, nulo-terminado.
+  *
+  * @note Las celdas distintas y contiguas se agrupan en un único tramo, que se
+  *       rasteriza con SSD1306_DrawText().
+  */
+ void SSD1306_FieldSetText(SSD1306_Field_t* field, const char* str) {
+ 
+     assert(field != NULL);
+     assert(str != NULL);
+ 
+     char cells[SSD1306_FIELD_MAX_CHARS + 1];
+     char run[SSD1306_FIELD_MAX_CHARS + 1];
+     uint8_t i = 0;
+ 
+     SSD1306_FieldLayout(field, str, cells);
+ 
+     while (i < field->width) {
+ 
+         if (field->valid && cells[i] == field->shown[i]) {
+             i++;
+             continue;
+         }
+ 
+         //Se agrupan las celdas contiguas que cambiaron
+         uint8_t start = i;
+         while (i < field->width && (!field->valid || cells[i] != field->shown[i])) {
+             run[i - start] = cells[i];
+             i++;
+         }
+         run[i - start] = '\0';
+ 
+         SSD1306_DrawText(field->dev, field->x + start, field->page, i - start, run, SSD1306_ALIGN_LEFT);
+     }
+ 
+     memcpy(field->shown, cells, field->width + 1);
+     field->valid = true;
+ }
+ 
+ /**
+  * @brief Fuerza el redibujado completo del campo en la próxima actualización.
+  *
+  * @param field Puntero al campo.
+  */
+ void SSD1306_FieldInvalidate(SSD1306_Field_t* field) {
+ 
+     assert(field != NULL);
+ 
+     field->valid = false;
+ }
+ 
+ /**
+  * @brief Distribuye un texto en las celdas del campo según su alineación.
+  *
+  * @param field Puntero al campo.
+  * @param str Texto nulo-terminado.
+  * @param cells Salida: width celdas rellenadas con espacios y terminadas en nulo.
+  */
+ static void SSD1306_FieldLayout(const SSD1306_Field_t* field, const char* str, char* cells) {
+ 
+     size_t length = strlen(str);
+     uint8_t offset = 0;
+ 
+     if (length > field->width) length = field->width;
+     if (field->align == SSD1306_ALIGN_RIGHT) offset = field->width - length;
+ 
+     memset(cells, ' ', field->width);
+     memcpy(&cells[offset], str, length);
+     cells[field->width] = '\0';
+ }
@@ -9,6 +9,8 @@
 #include "../../Drivers/API/Inc/TF-LC02.h"
 #include "../../Drivers/API/Inc/TF-LC02_Port.h"
 #include "../../Drivers/API/Inc/API_delay.h"
+#include "../../Drivers/API/Inc/API_cycles.h"
+#include "../../Drivers/API/Inc/API_ring.h"
 
 
 
@@ -17,6 +19,10 @@
 #define LIDAR_FRAME_HEADER1 0x55 /**< Primer byte de cabecera de la trama */
 #define LIDAR_FRAME_HEADER2 0xAA /**< Segundo byte de cabecera de la trama */
 #define LIDAR_FRAME_END   	0xFA    /**< Byte de fin de trama */
+#define LIDAR_RX_DMA_LEN    64    /**< Tamaño del buffer circular de recepción por DMA */
+#define LIDAR_RX_RING_LEN   128   /**< Bytes entre la interrupción y el parser (potencia de dos, 16 tramas de medición) */
+#define LIDAR_CMD_LEN       5     /**< Longitud de una trama de comando */
+#define LIDAR_RX_MARKS      32    /**< Bloques recibidos con fin de trama que conservan su instante hasta procesarse (potencia de dos) */
 
 /**
  * @brief Protocolos soportados por el sensor.
@@ -49,6 +55,23 @@ typedef enum {
     STATE_END
 } ParserState;
 
+/**
+ * @brief Resultado de pasar un byte al parser.
+ */
+typedef enum {
+    FRAME_INCOMPLETE,   /**< La trama en armado necesita más bytes */
+    FRAME_COMPLETE,     /**< La trama en rx_buffer está completa y verificada */
+    FRAME_MISMATCH      /**< El byte no corresponde a la trama en armado: hay que resincronizar */
+} FrameResult;
+
+/**
+ * @brief Instante de llegada de un bloque de bytes recibido que contiene un fin de trama.
+ */
+typedef struct {
+    uint32_t end;       /**< Bytes pasados al buffer circular hasta el final del bloque inclusive */
+    uint32_t cycles;    /**< Ciclo del DWT en que la interrupción recibió el bloque */
+} RxMark;
+
 /**
  * @brief Comandos disponibles del sensor TF-LC02.
  */
@@ -61,6 +84,20 @@ typedef enum {
     Get_Prod_info                  /**< Obtención de información del producto */
 } TF_CMD;
 
+/**
+ * @brief Tramas de comando armadas de antemano, indexadas por (comando - Measure).
+ * @note Están en flash y no cambian, por lo que la UART puede enviarlas por
+ *       interrupción sin copiarlas.
+ */
+static const uint8_t command_frames[Get_Prod_info - Measure + 1][LIDAR_CMD_LEN] = {
+    {LIDAR_FRAME_HEADER1, LIDAR_FRAME_HEADER2, Measure, 0x00, LIDAR_FRAME_END},
+    {LIDAR_FRAME_HEADER1, LIDAR_FRAME_HEADER2, Crosstalk_correction, 0x00, LIDAR_FRAME_END},
+    {LIDAR_FRAME_HEADER1, LIDAR_FRAME_HEADER2, Offset_correction, 0x00, LIDAR_FRAME_END},
+    {LIDAR_FRAME_HEADER1, LIDAR_FRAME_HEADER2, TFLC02_Reset, 0x00, LIDAR_FRAME_END},
+    {LIDAR_FRAME_HEADER1, LIDAR_FRAME_HEADER2, Get_Factory_default_settings, 0x00, LIDAR_FRAME_END},
+    {LIDAR_FRAME_HEADER1, LIDAR_FRAME_HEADER2, Get_Prod_info, 0x00, LIDAR_FRAME_END},
+};
+
 /**
  * @brief Códigos de error reportados por el sensor.
  */
@@ -94,44 +131,258 @@ typedef struct {
 } TF_t;
 
 /* Variables internas */
+#if TFLC02_USE_RX_DMA
+static uint8_t rx_dma[LIDAR_RX_DMA_LEN];          /**< Buffer circular que escribe el DMA */
+static uint16_t rx_dma_tail;                      /**< Próximo byte del buffer circular a procesar */
+#else
 static uint8_t rx_byte;                           /**< Byte de recepción */
-static uint8_t rx_buffer[LIDAR_FRAME_LEN];         /**< Buffer de recepción */
-static uint8_t rx_index = 0;                       /**< Índice del buffer de recepción */
-static bool frame_present;                         /**< Indica si una trama completa está disponible */
+#endif
+static uint8_t rx_ring_buffer[LIDAR_RX_RING_LEN];  /**< Memoria del buffer circular de recepción */
+static ring_t rx_ring;                             /**< Bytes recibidos: los agrega la interrupción y los extrae el lazo principal */
+static uint8_t rx_buffer[LIDAR_FRAME_LEN];         /**< Trama en armado (solo la usa el lazo principal) */
+static uint8_t rx_index = 0;                       /**< Índice de la trama en armado */
+static ParserState parser_state = STATE_WAIT_HEADER_1; /**< Estado del parser (se conserva entre llamadas) */
+static uint8_t rx_replay[LIDAR_FRAME_LEN];         /**< Bytes a volver a examinar después de una resincronización */
+static uint8_t replay_len;                         /**< Cantidad de bytes en rx_replay */
+static uint8_t replay_pos;                         /**< Próximo byte de rx_replay a examinar */
+static RxMark rx_marks[LIDAR_RX_MARKS];            /**< Instantes de los bloques con fin de trama (los agrega la interrupción) */
+static atomic_uint_fast32_t rx_marks_head;         /**< Próxima marca a escribir (lo escribe la interrupción) */
+static atomic_uint_fast32_t rx_marks_tail;         /**< Marca más antigua sin descartar (lo escribe el lazo principal) */
+static uint32_t rx_pushed;                         /**< Bytes pasados al buffer circular (solo la interrupción) */
+static uint32_t rx_pulled;                         /**< Bytes extraídos del buffer circular (solo el lazo principal) */
+static uint32_t frame_end_cycles;                  /**< Ciclo del DWT en que llegó el fin de la trama completada */
+static uint8_t tx_queue_buffer[TFLC02_TX_QUEUE_LEN]; /**< Memoria de la cola de transmisión */
+static ring_t tx_queue;                            /**< Comandos a enviar: los agrega el lazo principal y los extrae quien tiene tx_busy */
+static atomic_bool tx_busy;                        /**< Hay un comando enviándose (o por enviarse) por la UART */
+static uint8_t tx_current;                         /**< Comando que se está enviando */
+static TFLC02_TxCallback_t tx_callback;            /**< Función a llamar al terminar de enviar cada comando */
 
 volatile TF_t lidar = {0};                         /**< Variable global de estado del sensor */
 
+static TFLC02_Stats_t stats;                       /**< Contadores de la comunicación */
+static bool request_pending;                       /**< Hay un pedido de medición sin respuesta */
+static atomic_uint_fast32_t request_end_cycles;    /**< Ciclo del DWT en que terminó de enviarse el último pedido de medición (lo escribe la interrupción) */
+
+static TFLC02_Sample_t sample_ring[TFLC02_SAMPLE_RING_LEN]; /**< Mediciones sin leer */
+static uint8_t sample_head;                        /**< Próxima posición de sample_ring a escribir */
+static uint8_t sample_count;                       /**< Mediciones sin leer en sample_ring */
+static TFLC02_Timing_t timing;                     /**< Estadísticas de tiempo (la media y el jitter se completan al leerlas) */
+static uint64_t latency_sum_us;                    /**< Suma de las latencias, para la media */
+static uint32_t last_frame_end;                    /**< frameEndTime de la medición anterior */
+static uint32_t last_interval_us;                  /**< Intervalo anterior entre mediciones */
+static uint32_t jitter_x16;                        /**< Jitter multiplicado por 16 */
+
+static bool freerun_active;                        /**< Modo continuo activo */
+static uint8_t freerun_misses;                     /**< Pedidos seguidos sin respuesta en modo continuo */
+static bool freerun_backoff;                       /**< El sensor no responde: se espera antes de volver a pedir */
+static delay_t freerun_timer;                      /**< Timeout del pedido en curso o espera tras varios sin respuesta */
+static delay_t freerun_rate_timer;                 /**< Ventana de un segundo para medir la tasa lograda */
+static uint32_t freerun_rate_start;                /**< Mediciones al comenzar la ventana */
+static uint32_t freerun_rate;                      /**< Mediciones en la última ventana completa */
+
 /* Prototipos de funciones privadas */
 bool TFLC02_Parse_Packet(void);
+static FrameResult TFLC02_Parse_Byte(uint8_t byte);
+static int8_t TFLC02_Payload_Len(uint8_t cmd);
+static void TFLC02_Resync(void);
+static void TFLC02_Rx_Arm(void);
+static void TFLC02_Rx_Push(const uint8_t *data, uint16_t size);
+static void TFLC02_Tx_Kick(void);
+static void TFLC02_Rx_Mark(void);
+static uint32_t TFLC02_Rx_EndCycles(void);
+static void TFLC02_Push_Sample(const TFLC02_Sample_t *sample, bool answered);
+static uint32_t TFLC02_Cycles_To_Us(uint32_t cycles);
 bool ParserInfo(uint8_t *buffer, uint8_t size);
 void TFLC02_Send_Command(uint8_t cmd);
 
 /**
- * @brief Envía un comando al sensor.
+ * @brief Encola un comando para el sensor y, si la UART está libre, comienza a enviarlo.
  * @param cmd Comando a enviar (ver @ref TF_CMD)
+ * @note No espera la transmisión: la trama sale por interrupción. Si la cola está
+ *       llena el comando se descarta y se cuenta en txOverflows.
  */
 void TFLC02_Send_Command(uint8_t cmd) {
     assert(cmd >= Measure && cmd <= Get_Prod_info);
 
-    uint8_t frame[5] = {0x55, 0xAA, cmd, 0x00, 0xFA};
-    TFLC02_Port_Transmit(frame, sizeof(frame), HAL_MAX_DELAY);
+    if (!ringPut(&tx_queue, cmd)) {
+        return;
+    }
+
+    uint32_t depth = ringCount(&tx_queue);
+    if (depth > stats.txQueueMax) {
+        stats.txQueueMax = depth;
+    }
+
+    TFLC02_Tx_Kick();
 }
 
+/**
+ * @brief Comienza a enviar el próximo comando de la cola si la UART está libre.
+ * @note Se llama desde el lazo principal al encolar y desde la interrupción al terminar
+ *       cada envío. Solo extrae de la cola quien logra tomar tx_busy, por lo que hay un
+ *       único consumidor a la vez. Si la cola está vacía se suelta tx_busy y se vuelve a
+ *       mirar la cola, por si se encoló un comando mientras tanto.
+ */
+static void TFLC02_Tx_Kick(void) {
+    uint8_t cmd;
+
+    while (!atomic_exchange(&tx_busy, true)) {
+        if (ringGet(&tx_queue, &cmd)) {
+            tx_current = cmd;
+            TFLC02_Port_Transmit_IT(command_frames[cmd - Measure], LIDAR_CMD_LEN);
+            return;
+        }
+
+        atomic_store(&tx_busy, false);
+        if (ringCount(&tx_queue) == 0) {
+            return;
+        }
+    }
+}
 
 /**
- * @brief Inicia la recepción UART por interrupción.
+ * @brief Registra la función a llamar al terminar de enviar cada comando.
+ * @param callback Función a llamar, o NULL para no llamar a ninguna.
+ */
+void TFLC02_SetTxCallback(TFLC02_TxCallback_t callback) {
+    tx_callback = callback;
+}
+
+
+/**
+ * @brief Vacía el buffer de recepción e inicia la recepción UART.
  */
 void TFLC02_Start(void){
+    ringInit(&tx_queue, tx_queue_buffer, sizeof(tx_queue_buffer));
+    atomic_store(&tx_busy, false);
+    ringInit(&rx_ring, rx_ring_buffer, sizeof(rx_ring_buffer));
+    atomic_store(&rx_marks_head, 0);
+    atomic_store(&rx_marks_tail, 0);
+    rx_pushed = 0;
+    rx_pulled = 0;
+    sample_count = 0;
+    TFLC02_ResetTiming();
+    rx_index = 0;
+    parser_state = STATE_WAIT_HEADER_1;
+    replay_len = 0;
+    replay_pos = 0;
+    TFLC02_Rx_Arm();
+}
+
+/**
+ * @brief Arma la recepción UART, por DMA circular o por interrupción según TFLC02_USE_RX_DMA.
+ */
+static void TFLC02_Rx_Arm(void){
+#if TFLC02_USE_RX_DMA
+    rx_dma_tail = 0;
+    TFLC02_Port_ReceiveToIdle_DMA(rx_dma, sizeof(rx_dma));
+#else
     TFLC02_Port_Receive_IT(&rx_byte, 1);
+#endif
 }
 
 /**
  * @brief Solicita una medición de distancia al sensor.
+ * @note Si el pedido anterior no tuvo respuesta se cuenta como perdido.
  */
 void TFLC02_Mesure(void){
+    if(request_pending){
+        stats.droppedRequests++;
+    }
+    request_pending = true;
+    stats.requests++;
+
     TFLC02_Send_Command(Measure);
 }
 
+/**
+ * @brief Inicia el modo continuo: cada medición se pide en cuanto llega la respuesta a la anterior.
+ */
+void TFLC02_FreeRunStart(void){
+    freerun_active = true;
+    freerun_misses = 0;
+    freerun_backoff = false;
+    freerun_rate = 0;
+    freerun_rate_start = stats.measurements;
+    delayInit(&freerun_rate_timer, 1000);
+    delayInit(&freerun_timer, TFLC02_FREERUN_TIMEOUT_MS);
+
+    // Un pedido de antes del modo continuo se trata como el primero del modo
+    if(!request_pending){
+        TFLC02_Mesure();
+    }
+}
+
+/**
+ * @brief Detiene el modo continuo.
+ */
+void TFLC02_FreeRunStop(void){
+    freerun_active = false;
+}
+
+/**
+ * @brief Indica si el modo continuo está activo.
+ */
+bool TFLC02_FreeRunActive(void){
+    return freerun_active;
+}
+
+/**
+ * @brief Avanza el modo continuo: envía el pedido siguiente o repite uno vencido.
+ * @return true si se envió un pedido de medición.
+ */
+bool TFLC02_FreeRunUpdate(void){
+    if(!freerun_active){
+        return false;
+    }
+
+    if(delayRead(&freerun_rate_timer)){
+        freerun_rate = stats.measurements - freerun_rate_start;
+        freerun_rate_start = stats.measurements;
+    }
+
+    if(request_pending){
+        if(!delayRead(&freerun_timer)){
+            return false;
+        }
+
+        stats.timeouts++;
+        if(++freerun_misses >= TFLC02_FREERUN_MAX_RETRIES){
+            // El sensor no responde: se abandona el pedido y se espera antes de volver a pedir
+            request_pending = false;
+            stats.droppedRequests++;
+            freerun_misses = 0;
+            freerun_backoff = true;
+            delayWrite(&freerun_timer, TFLC02_FREERUN_BACKOFF_MS);
+            return false;
+        }
+        // El reintento reemplaza al pedido sin respuesta: solo el abandono cuenta como perdido
+        request_pending = false;
+        stats.retries++;
+    }
+    else if(freerun_backoff){
+        if(!delayRead(&freerun_timer)){
+            return false;
+        }
+        freerun_backoff = false;
+    }
+    else{
+        freerun_misses = 0;
+    }
+
+    TFLC02_Mesure();
+    delayWrite(&freerun_timer, TFLC02_FREERUN_TIMEOUT_MS);
+    return true;
+}
+
+/**
+ * @brief Obtiene las mediciones válidas recibidas en el último segundo del modo continuo.
+ * @return Muestras por segundo logradas.
+ */
+uint32_t TFLC02_FreeRunRate(void){
+    return freerun_rate;
+}
+
 /**
  * @brief Solicita información del producto al sensor.
  */
@@ -195,128 +446,380 @@ uint8_t TFLC02_GetCalib(void) {
 }
 
 /**
- * @brief Verifica si existe una trama pendiente para procesar.
- * @return true si existe una nueva trama, false en caso contrario.
+ * @brief Pasa los bytes recibidos al parser hasta completar una trama.
+ * @return true si se completó una trama (queda en rx_buffer), false si no hay más bytes.
+ * @note El estado del parser se conserva entre llamadas; las siguientes tramas
+ *       esperan en el buffer circular.
  */
 bool TFLC02_FramePresent(void) {
-    if(frame_present){
-        frame_present = false;
-        return true;
+    uint8_t byte;
+
+    for(;;){
+        // Primero los bytes que quedaron por examinar de una resincronización
+        if(replay_pos < replay_len){
+            byte = rx_replay[replay_pos++];
+        }
+        else if(ringGet(&rx_ring, &byte)){
+            rx_pulled++;
+        }
+        else{
+            return false;
+        }
+
+        switch(TFLC02_Parse_Byte(byte)){
+            case FRAME_COMPLETE:
+                frame_end_cycles = TFLC02_Rx_EndCycles();
+                return true;
+
+            case FRAME_MISMATCH:
+                TFLC02_Resync();
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Obtiene los contadores de la comunicación con el sensor.
+ * @return Copia de los contadores.
+ */
+TFLC02_Stats_t TFLC02_GetStats(void) {
+    TFLC02_Stats_t copy = stats;
+
+    copy.rxOverflows = ringOverflows(&rx_ring);
+    copy.txOverflows = ringOverflows(&tx_queue);
+    return copy;
+}
+
+/**
+ * @brief Extrae las mediciones recibidas, de la más antigua a la más reciente.
+ * @param samples Destino de las mediciones.
+ * @param max Cantidad máxima de mediciones a extraer.
+ * @return Mediciones extraídas.
+ */
+uint16_t TFLC02_ReadSamples(TFLC02_Sample_t *samples, uint16_t max) {
+    assert(samples != NULL);
+
+    uint16_t count = (max < sample_count) ? max : sample_count;
+    uint8_t tail = (uint8_t)((sample_head + TFLC02_SAMPLE_RING_LEN - sample_count) % TFLC02_SAMPLE_RING_LEN);
+
+    for(uint16_t i = 0; i < count; i++){
+        samples[i] = sample_ring[(tail + i) % TFLC02_SAMPLE_RING_LEN];
+    }
+    sample_count -= count;
+    return count;
+}
+
+/**
+ * @brief Obtiene las estadísticas de tiempo de las mediciones recibidas.
+ * @return Copia de las estadísticas.
+ */
+TFLC02_Timing_t TFLC02_GetTiming(void) {
+    TFLC02_Timing_t copy = timing;
+
+    copy.latencyMeanUs = (timing.answered > 0) ? (uint32_t)(latency_sum_us / timing.answered) : 0;
+    copy.jitterUs = jitter_x16 >> 4;
+    return copy;
+}
+
+/**
+ * @brief Pone en cero las estadísticas de tiempo.
+ */
+void TFLC02_ResetTiming(void) {
+    timing = (TFLC02_Timing_t){0};
+    latency_sum_us = 0;
+    jitter_x16 = 0;
+}
+
+/**
+ * @brief Cuenta una interrupción de recepción del sensor y su duración.
+ * @param cycles Ciclos de CPU que llevó atender la interrupción.
+ */
+void TFLC02_CountInterrupt(uint32_t cycles) {
+    stats.rxInterrupts++;
+    stats.rxCycles += cycles;
+}
+
+/**
+ * @brief Pasa bytes recibidos al buffer circular (desde la interrupción).
+ * @param data Bytes recibidos.
+ * @param size Cantidad de bytes.
+ * @note Si el lazo principal no alcanza a extraerlos, los que no entran se descartan
+ *       y se cuentan en rxOverflows.
+ */
+static void TFLC02_Rx_Push(const uint8_t *data, uint16_t size) {
+    uint32_t written = ringWrite(&rx_ring, data, size);
+
+    rx_pushed += written;
+    if(memchr(data, LIDAR_FRAME_END, written) != NULL){
+        TFLC02_Rx_Mark();
     }
-    return false;
 }
 
 /**
- * @brief Callback de recepción de UART.
+ * @brief Registra el instante de llegada del bloque recién pasado al buffer circular (desde la interrupción).
+ * @note Si no hay lugar la marca se descarta y las tramas del bloque toman el instante
+ *       del bloque siguiente con fin de trama.
+ */
+static void TFLC02_Rx_Mark(void) {
+    uint32_t head = (uint32_t)atomic_load_explicit(&rx_marks_head, memory_order_relaxed);
+    uint32_t tail = (uint32_t)atomic_load_explicit(&rx_marks_tail, memory_order_acquire);
+
+    if((uint32_t)(head - tail) >= LIDAR_RX_MARKS){
+        return;
+    }
+
+    rx_marks[head & (LIDAR_RX_MARKS - 1)] = (RxMark){ .end = rx_pushed, .cycles = cyclesNow() };
+    atomic_store_explicit(&rx_marks_head, (uint32_t)(head + 1), memory_order_release);
+}
+
+/**
+ * @brief Instante de llegada del último byte extraído del buffer circular (el fin de la trama completada).
+ * @return Ciclo del DWT registrado por la interrupción que recibió el bloque de ese byte.
+ * @note Se descartan las marcas de los bloques anteriores; la del bloque se conserva
+ *       porque puede contener más tramas. Si la trama se completó con bytes vueltos a
+ *       examinar tras una resincronización, se toma el instante del último byte extraído.
+ */
+static uint32_t TFLC02_Rx_EndCycles(void) {
+    uint32_t last = rx_pulled - 1;
+    uint32_t tail = (uint32_t)atomic_load_explicit(&rx_marks_tail, memory_order_relaxed);
+    uint32_t head = (uint32_t)atomic_load_explicit(&rx_marks_head, memory_order_acquire);
+
+    while(tail != head && (int32_t)(rx_marks[tail & (LIDAR_RX_MARKS - 1)].end - last) <= 0){
+        tail++;
+    }
+    atomic_store_explicit(&rx_marks_tail, tail, memory_order_release);
+
+    // Sin marca (se descartó por falta de lugar): el bloque llegó hace poco
+    return (tail != head) ? rx_marks[tail & (LIDAR_RX_MARKS - 1)].cycles : cyclesNow();
+}
+
+/**
+ * @brief Callback de fin de transmisión de UART: avisa el comando enviado y envía el siguiente.
+ * @param huart Puntero a la estructura UART_HandleTypeDef.
+ * @note Esta función debe ser llamada dentro del callback de transmisión de HAL. El
+ *       siguiente comando sale antes de avisar, para no demorarlo con la función
+ *       registrada.
+ */
+void TFLC02__TxCpltCallback(UART_HandleTypeDef *huart) {
+    assert(huart != NULL);
+
+    if (huart->Instance == UART4) {
+        uint8_t cmd = tx_current;
+
+        if (cmd == Measure) {
+            atomic_store_explicit(&request_end_cycles, cyclesNow(), memory_order_relaxed);
+        }
+        stats.txCommands++;
+        atomic_store(&tx_busy, false);
+        TFLC02_Tx_Kick();
+
+        if (tx_callback != NULL) {
+            tx_callback(cmd);
+        }
+    }
+}
+
+/**
+ * @brief Callback de recepción de UART (recepción byte por byte).
  * @param huart Puntero a la estructura UART_HandleTypeDef.
  * @note Esta función debe ser llamada dentro del callback de recepción de HAL.
  */
 void TFLC02__RxCpltCallback(UART_HandleTypeDef *huart) {
     assert(huart != NULL);
 
+#if !TFLC02_USE_RX_DMA
     if (huart->Instance == UART4) {
-        rx_buffer[rx_index] = rx_byte;
-        rx_index++;
+        TFLC02_Rx_Push(&rx_byte, 1);
+        TFLC02_Rx_Arm(); // Reinicia la recepción
+    }
+#endif
+}
 
-        if(rx_index >= LIDAR_FRAME_LEN){
-            rx_index = 0;
-            frame_present = false;
-        }
+/**
+ * @brief Callback de recepción por DMA circular: procesa los bytes nuevos del buffer.
+ * @param huart Puntero a la estructura UART_HandleTypeDef.
+ * @param size Posición de escritura del DMA (LIDAR_RX_DMA_LEN al dar la vuelta).
+ * @note Esta función debe ser llamada dentro de HAL_UARTEx_RxEventCallback(). Se llama
+ *       al quedar inactiva la línea (fin de trama) y al completarse el buffer, por lo que
+ *       el fin de trama se registra una duración de carácter después de su llegada.
+ */
+void TFLC02__RxEventCallback(UART_HandleTypeDef *huart, uint16_t size) {
+    assert(huart != NULL);
+
+#if TFLC02_USE_RX_DMA
+    if (huart->Instance == UART4) {
+        uint16_t head = (size >= LIDAR_RX_DMA_LEN) ? 0 : size;
 
-        if(rx_byte == LIDAR_FRAME_END){
-            frame_present = true;
+        // Los bytes nuevos pueden estar partidos en el final y el comienzo del buffer; con el
+        // buffer completo llegan hasta el final (todo el buffer si la lectura estaba al comienzo)
+        if (size >= LIDAR_RX_DMA_LEN || head < rx_dma_tail) {
+            TFLC02_Rx_Push(&rx_dma[rx_dma_tail], LIDAR_RX_DMA_LEN - rx_dma_tail);
+            rx_dma_tail = 0;
+        }
+        if (head > rx_dma_tail) {
+            TFLC02_Rx_Push(&rx_dma[rx_dma_tail], head - rx_dma_tail);
         }
+        rx_dma_tail = head;
+    }
+#endif
+}
 
-        TFLC02_Start(); // Reinicia la recepción
+/**
+ * @brief Callback de error de UART: cuenta el error y reinicia la recepción.
+ * @param huart Puntero a la estructura UART_HandleTypeDef.
+ * @note HAL aborta la recepción ante un desborde (con DMA, ante cualquier error); sin
+ *       este reinicio el sensor dejaría de escucharse. La trama afectada la descarta
+ *       el parser al no validarla.
+ */
+void TFLC02__ErrorCallback(UART_HandleTypeDef *huart) {
+    assert(huart != NULL);
+
+    if (huart->Instance == UART4) {
+        stats.rxErrors++;
+        if (huart->RxState == HAL_UART_STATE_READY) {
+            TFLC02_Rx_Arm();
+        }
     }
 }
 
 /**
- * @brief Máquina de estados que verifica la integridad de la trama recibida.
- * @return true si la trama fue validada y procesada correctamente, false en caso contrario.
+ * @brief Procesa la trama completada por TFLC02_FramePresent(), contando las descartadas.
+ * @return true si la trama fue procesada correctamente, false en caso contrario.
  */
 bool TFLC02_Parse_Packet(void) {
-    uint8_t i = 0;
-    ParserState parser_state = STATE_WAIT_HEADER_1;
-    uint8_t expected_length = 0;
-    uint8_t byte;
-    uint8_t size = rx_index;
-    uint8_t byte_index = 0;
-
-    while (i < size) {
-        byte = rx_buffer[i];
-        switch (parser_state) {
-            case STATE_WAIT_HEADER_1:
-                if (byte == LIDAR_FRAME_HEADER1) {
-                    byte_index++;
-                    parser_state = STATE_WAIT_HEADER_2;
-                } else {
-                    parser_state = STATE_WAIT_HEADER_1;
-                    rx_index = 0;
-                    return false;
-                }
-                break;
+    if(parser_state != STATE_WAIT_HEADER_1 || rx_index == 0){
+        return false;
+    }
 
-            case STATE_WAIT_HEADER_2:
-                if (byte == LIDAR_FRAME_HEADER2) {
-                    parser_state = STATE_CMD;
-                    byte_index++;
-                } else {
-                    parser_state = STATE_WAIT_HEADER_1;
-                    rx_index = 0;
-                    return false;
-                }
-                break;
+    bool valid = ParserInfo(rx_buffer, rx_index);
 
-            case STATE_CMD:
-                byte_index++;
-                parser_state = STATE_LEN;
-                break;
+    lidar.receiveComplete = valid;
+    if(!valid){
+        stats.invalidFrames++;
+    }
+    rx_index = 0;
+    return valid;
+}
 
-            case STATE_LEN:
-                expected_length = byte;
-                if ((expected_length + 5) <= LIDAR_FRAME_LEN) {
-                    parser_state = (expected_length > 0) ? STATE_DATA : STATE_END;
-                    byte_index++;
-                } else {
-                    parser_state = STATE_WAIT_HEADER_1;
-                    rx_index = 0;
-                }
-                break;
+/**
+ * @brief Máquina de estados que verifica la trama byte por byte.
+ * @param byte Próximo byte recibido; se agrega a rx_buffer.
+ * @return Resultado de la verificación (ver @ref FrameResult).
+ * @note Cabecera, comando conocido y largo (el esperado para el comando y que entre
+ *       en rx_buffer) se verifican al llegar, por lo que una trama inválida se detecta
+ *       en el primer byte que no corresponde.
+ */
+static FrameResult TFLC02_Parse_Byte(uint8_t byte) {
+    if (parser_state == STATE_WAIT_HEADER_1) {
+        rx_index = 0;
+    }
+    rx_buffer[rx_index++] = byte;
+
+    switch (parser_state) {
+        case STATE_WAIT_HEADER_1:
+            if (byte != LIDAR_FRAME_HEADER1) {
+                return FRAME_MISMATCH;
+            }
+            parser_state = STATE_WAIT_HEADER_2;
+            break;
 
-            case STATE_DATA:
-                byte_index++;
-                if (byte_index == (4 + expected_length)) {
-                    parser_state = STATE_END;
-                }
-                break;
+        case STATE_WAIT_HEADER_2:
+            if (byte != LIDAR_FRAME_HEADER2) {
+                return FRAME_MISMATCH;
+            }
+            parser_state = STATE_CMD;
+            break;
 
-            case STATE_END:
-                if (byte == LIDAR_FRAME_END) {
-                    if (ParserInfo(rx_buffer, byte_index + 1)) {
-                        lidar.receiveComplete = true;
-                        rx_index = 0;
-                        return true;
-                    } else {
-                        lidar.receiveComplete = false;
-                        rx_index = 0;
-                        return false;
-                    }
-                }
-                parser_state = STATE_WAIT_HEADER_1;
-                rx_index = 0;
-                break;
+        case STATE_CMD:
+            if (byte < Measure || byte > Get_Prod_info) {
+                return FRAME_MISMATCH;
+            }
+            parser_state = STATE_LEN;
+            break;
 
-            default:
-                parser_state = STATE_WAIT_HEADER_1;
-                rx_index = 0;
-                break;
+        case STATE_LEN: {
+            int8_t expected_length = TFLC02_Payload_Len(rx_buffer[2]);
+
+            if ((expected_length >= 0 && byte != expected_length) || (byte + LIDAR_FRAME_MIN) > LIDAR_FRAME_LEN) {
+                return FRAME_MISMATCH;
+            }
+            parser_state = (byte > 0) ? STATE_DATA : STATE_END;
+            break;
         }
-        i++;
+
+        case STATE_DATA:
+            // El fin de trama puede aparecer dentro de los datos: solo cuenta el largo
+            if (rx_index == (4 + rx_buffer[3])) {
+                parser_state = STATE_END;
+            }
+            break;
+
+        case STATE_END:
+            if (byte != LIDAR_FRAME_END) {
+                return FRAME_MISMATCH;
+            }
+            parser_state = STATE_WAIT_HEADER_1;
+            return FRAME_COMPLETE;
+
+        default:
+            return FRAME_MISMATCH;
     }
 
+    return FRAME_INCOMPLETE;
+}
+
+/**
+ * @brief Largo de los datos de la respuesta a un comando.
+ * @param cmd Comando (ver @ref TF_CMD).
+ * @return Bytes de datos, o -1 si no está documentado (se acepta cualquiera que entre en la trama).
+ */
+static int8_t TFLC02_Payload_Len(uint8_t cmd) {
+    switch (cmd) {
+        case Measure:
+        case Get_Prod_info:
+            return 3;
+
+        case Get_Factory_default_settings:
+            return 7;
+
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Resincroniza el parser después de un byte que no corresponde a la trama en armado.
+ * @note Se descarta solo hasta la próxima cabecera posible dentro de la trama en armado;
+ *       desde ahí, sus bytes (incluido el que no correspondía) se vuelven a examinar antes
+ *       que los del buffer circular, por lo que una trama válida que empezó dentro de la
+ *       descartada no se pierde.
+ */
+static void TFLC02_Resync(void) {
+    uint8_t pending[LIDAR_FRAME_LEN];
+    uint8_t count = 0;
+    const uint8_t *next = memchr(&rx_buffer[1], LIDAR_FRAME_HEADER1, rx_index - 1);
+    uint8_t start = (next != NULL) ? (uint8_t)(next - rx_buffer) : rx_index;
+
+    if (rx_index > 1) {
+        stats.invalidFrames++;
+    }
+    stats.discardedBytes += start;
+
+    // Los bytes de la trama descartada estaban antes que los que quedaban por examinar
+    memcpy(pending, &rx_buffer[start], rx_index - start);
+    count = rx_index - start;
+    assert(count + (replay_len - replay_pos) <= LIDAR_FRAME_LEN);
+    memcpy(&pending[count], &rx_replay[replay_pos], replay_len - replay_pos);
+    count += replay_len - replay_pos;
+
+    memcpy(rx_replay, pending, count);
+    replay_len = count;
+    replay_pos = 0;
     rx_index = 0;
-    return false;
+    parser_state = STATE_WAIT_HEADER_1;
 }
 
 /**
@@ -330,10 +833,36 @@ bool ParserInfo(uint8_t *buffer, uint8_t size) {
     cmd = buffer[2];
 
     switch(cmd) {
-        case Measure:
-            lidar.distance = (rx_buffer[4] << 8) | rx_buffer[5];
-            lidar.errorCode = rx_buffer[6];
+        case Measure: {
+            TFLC02_Sample_t sample = {
+                .distance = (rx_buffer[4] << 8) | rx_buffer[5],
+                .errorCode = rx_buffer[6],
+                .requestTime = frame_end_cycles,
+                .frameEndTime = frame_end_cycles
+            };
+            bool answered = false;
+
+            lidar.distance = sample.distance;
+            lidar.errorCode = sample.errorCode;
+            if(request_pending){
+                uint32_t request_time = (uint32_t)atomic_load_explicit(&request_end_cycles, memory_order_relaxed);
+
+                // Una respuesta tardía puede terminar de llegar antes que el envío de un reintento:
+                // no responde a ese pedido, que sigue pendiente
+                if((int32_t)(sample.frameEndTime - request_time) >= 0){
+                    sample.requestTime = request_time;
+                    stats.latencyUs = TFLC02_Cycles_To_Us(sample.frameEndTime - sample.requestTime);
+                    request_pending = false;
+                    answered = true;
+                }
+            }
+            TFLC02_Push_Sample(&sample, answered);
+            // Las lecturas con código de error del sensor no cuentan para la tasa lograda
+            if(sample.errorCode == 0){
+                stats.measurements++;
+            }
             break;
+        }
 
         case TFLC02_Reset:
             // No hay payload
@@ -360,3 +889,60 @@ bool ParserInfo(uint8_t *buffer, uint8_t size) {
 
     return true;
 }
+
+/**
+ * @brief Guarda una medición para TFLC02_ReadSamples() y actualiza las estadísticas de tiempo.
+ * @param sample Medición con sus instantes.
+ * @param answered La medición respondía a un pedido pendiente (cuenta para la latencia).
+ * @note Si el buffer está lleno se descarta la medición más antigua.
+ */
+static void TFLC02_Push_Sample(const TFLC02_Sample_t *sample, bool answered) {
+    sample_ring[sample_head] = *sample;
+    sample_head = (sample_head + 1) % TFLC02_SAMPLE_RING_LEN;
+    if(sample_count < TFLC02_SAMPLE_RING_LEN){
+        sample_count++;
+    }
+    else{
+        stats.sampleOverflows++;
+    }
+
+    if(answered){
+        uint32_t latency = TFLC02_Cycles_To_Us(sample->frameEndTime - sample->requestTime);
+
+        if(timing.answered == 0 || latency < timing.latencyMinUs){
+            timing.latencyMinUs = latency;
+        }
+        if(latency > timing.latencyMaxUs){
+            timing.latencyMaxUs = latency;
+        }
+        latency_sum_us += latency;
+        timing.answered++;
+    }
+
+    if(timing.samples > 0){
+        uint32_t interval = TFLC02_Cycles_To_Us(sample->frameEndTime - last_frame_end);
+
+        if(timing.samples == 1 || interval < timing.intervalMinUs){
+            timing.intervalMinUs = interval;
+        }
+        if(interval > timing.intervalMaxUs){
+            timing.intervalMaxUs = interval;
+        }
+
+        // Promedio móvil de |D| con peso 1/16, en dieciseisavos de us
+        if(timing.samples > 1){
+            uint32_t d = (interval > last_interval_us) ? interval - last_interval_us : last_interval_us - interval;
+            jitter_x16 += d - ((jitter_x16 + 8) >> 4);
+        }
+        last_interval_us = interval;
+    }
+    last_frame_end = sample->frameEndTime;
+    timing.samples++;
+}
+
+/**
+ * @brief Convierte una diferencia de ciclos del DWT a microsegundos.
+ */
+static uint32_t TFLC02_Cycles_To_Us(uint32_t cycles) {
+    return cycles / (SystemCoreClock / 1000000u);
+}
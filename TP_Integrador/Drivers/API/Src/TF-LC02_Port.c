@@ -6,12 +6,15 @@
  * tanto en modo bloqueante como por interrupción, además del manejo básico de errores.
  */
 
-
+ 
  #include "../../Drivers/API/Inc/TF-LC02.h"
-
+ 
  extern UART_HandleTypeDef huart4;
  
+ extern void TFLC02__TxCpltCallback(UART_HandleTypeDef *huart);
  extern void TFLC02__RxCpltCallback(UART_HandleTypeDef *huart);
+ extern void TFLC02__RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+ extern void TFLC02__ErrorCallback(UART_HandleTypeDef *huart);
  
  /**
   * @brief Manejador de errores en la comunicación con el sensor TF-LC02.
@@ -55,7 +58,14 @@
  
  }
  
- void TFLC02_Port_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size){
+ /**
+  * @brief Envía datos al sensor TF-LC02 utilizando UART en modo interrupción.
+  *
+  * @param[in] pData Puntero al buffer de datos a transmitir; debe seguir válido hasta
+  *                  que se llame a HAL_UART_TxCpltCallback().
+  * @param[in] Size Cantidad de bytes a transmitir.
+  */
+ void TFLC02_Port_Transmit_IT(const uint8_t *pData, uint16_t Size){
  
 	 HAL_StatusTypeDef status = HAL_UART_Transmit_IT(&huart4, pData, Size);
  
@@ -66,11 +76,10 @@
  }
  
  /**
-  * @brief Envía datos al sensor TF-LC02 utilizando UART en modo interrupción.
+  * @brief Recibe datos del sensor TF-LC02 utilizando UART en modo interrupción.
   *
-  * @param[in] huart Puntero a la estructura UART (no utilizado, siempre se usa huart4).
-  * @param[in] pData Puntero al buffer de datos a transmitir.
-  * @param[in] Size Cantidad de bytes a transmitir.
+  * @param[out] pData Puntero al buffer donde se almacenarán los datos recibidos.
+  * @param[in] Size Cantidad de bytes a recibir.
   */
  void TFLC02_Port_Receive_IT(uint8_t *pData, uint16_t Size){
  
@@ -82,6 +91,37 @@
  
  }
  
+ /**
+  * @brief Inicia la recepción continua del sensor TF-LC02 en un buffer circular por DMA.
+  *
+  * @param[out] pData Buffer circular donde el DMA escribe los datos recibidos.
+  * @param[in] Size Tamaño del buffer.
+  */
+ void TFLC02_Port_ReceiveToIdle_DMA(uint8_t *pData, uint16_t Size){
+ 
+	 HAL_StatusTypeDef status = HAL_UARTEx_ReceiveToIdle_DMA(&huart4, pData, Size);
+ 
+	 if(status != HAL_OK){
+		 TFLC02_Error_Handler();
+	 }
+ 
+	 //Solo interesan el fin de trama (línea inactiva) y la vuelta del buffer
+	 __HAL_DMA_DISABLE_IT(huart4.hdmarx, DMA_IT_HT);
+ 
+ }
+ 
+ /**
+  * @brief Callback de HAL llamado al completarse la transmisión UART.
+  *
+  * @param[in] huart Puntero a la estructura UART_HandleTypeDef.
+  * @note Llama a la función que envía el próximo comando de la cola del módulo TF-LC02.
+  */
+ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+ 
+	 TFLC02__TxCpltCallback(huart);
+ 
+ }
+ 
  /**
   * @brief Callback de HAL llamado al completarse la recepción UART.
   *
@@ -94,6 +134,30 @@
  
  }
  
+ /**
+  * @brief Callback de HAL llamado al detectarse la línea inactiva o completarse el buffer circular.
+  *
+  * @param[in] huart Puntero a la estructura UART_HandleTypeDef.
+  * @param[in] Size Posición de escritura del DMA en el buffer.
+  */
+ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
+ 
+	 TFLC02__RxEventCallback(huart, Size);
+ 
+ }
+ 
+ /**
+  * @brief Callback de HAL llamado ante un error de recepción (ruido, trama, desborde).
+  *
+  * @param[in] huart Puntero a la estructura UART_HandleTypeDef.
+  * @note HAL aborta la recepción en curso; el módulo TF-LC02 la vuelve a iniciar.
+  */
+ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+ 
+	 TFLC02__ErrorCallback(huart);
+ 
+ }
+ 
  /**
   * @brief Manejador de error específico del sensor TF-LC02.
   *
@@ -110,6 +174,3 @@
 	 }
  
  }
- 
- 
- 
@@ -103,3 +103,13 @@ const uint8_t Font5x7[][5] = {
     {0x00,0x41,0x36,0x08,0x00}, //125 }
     {0x10,0x08,0x08,0x10,0x08}, //126 ~
 };
+
+const font_t FontSmall = {
+    .width = 5,
+    .pages = 1,
+    .first = ASCII_MIN,
+    .last = ASCII_MAX,
+    .spacing = 1,
+    .glyphs = &Font5x7[0][0],
+    .widths = NULL,
+};
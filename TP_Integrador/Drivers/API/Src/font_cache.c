@@ -0,0 +1,144 @@
+/**
+ * @file font_cache.c
+ * @brief Acceso a los glifos de las fuentes y caché de glifos comprimidos.
+ *
+ * Las fuentes comprimidas por Tools/fontgen.py guardan cada columna como un código
+ * de 2 bits (vacía o igual a la anterior) o como 1 bit seguido de rows bits. Un glifo
+ * se descomprime la primera vez que se usa en una de FONT_CACHE_ENTRIES entradas en
+ * RAM; cuando no hay lugar se descarta el usado hace más tiempo. Cada fuente guarda
+ * en RAM la entrada de cada uno de sus glifos, por lo que encontrar un glifo en el
+ * caché no requiere buscarlo.
+ */
+#include "../../Drivers/API/Inc/font.h"
+#include <assert.h>
+
+/**
+ * @brief Entrada del caché: un glifo descomprimido en orden de página.
+ */
+typedef struct {
+    const font_t* font;                         /**< Fuente del glifo, o NULL si la entrada está libre. */
+    uint8_t index;                              /**< Posición del glifo en la fuente (c - first). */
+    uint32_t lastUse;                           /**< Valor de fontCacheClock en el último uso. */
+    uint8_t data[FONT_CACHE_GLYPH_BYTES];       /**< Glifo descomprimido. */
+} fontCacheEntry_t;
+
+static fontCacheEntry_t fontCache[FONT_CACHE_ENTRIES];
+static uint32_t fontCacheClock;
+static fontCacheStats_t fontCacheStats;
+
+static const uint8_t* fontCacheLoad(const font_t* font, uint8_t index);
+static uint32_t fontUnpack(const font_t* font, uint32_t bit, uint8_t* out);
+static uint32_t fontReadBits(const uint8_t* data, uint32_t* bit, uint8_t count);
+
+/**
+ * @brief Devuelve el glifo de un carácter en orden de página.
+ *
+ * @param font Fuente.
+ * @param c Carácter.
+ * @return width * pages bytes del glifo, o NULL si la fuente no incluye el carácter.
+ */
+const uint8_t* fontGlyph(const font_t* font, char c) {
+
+    if (c < font->first || c > font->last) return NULL;
+
+    uint8_t index = (uint8_t)(c - font->first);
+
+    if (font->packed == NULL) return &font->glyphs[index * font->width * font->pages];
+
+    uint8_t slot = font->cacheSlots[index];
+    if (slot != 0) {
+        fontCache[slot - 1].lastUse = ++fontCacheClock;
+        fontCacheStats.hits++;
+        return fontCache[slot - 1].data;
+    }
+
+    return fontCacheLoad(font, index);
+}
+
+/**
+ * @brief Devuelve los contadores del caché de glifos.
+ */
+fontCacheStats_t fontCacheGetStats(void) {
+    return fontCacheStats;
+}
+
+/**
+ * @brief Pone en cero los contadores del caché de glifos (no vacía el caché).
+ */
+void fontCacheResetStats(void) {
+    fontCacheStats = (fontCacheStats_t){0};
+}
+
+/**
+ * @brief Descomprime un glifo en la entrada libre o usada hace más tiempo.
+ */
+static const uint8_t* fontCacheLoad(const font_t* font, uint8_t index) {
+
+    assert(font->width * font->pages <= FONT_CACHE_GLYPH_BYTES);
+
+    fontCacheEntry_t* entry = &fontCache[0];
+    for (uint8_t i = 1; i < FONT_CACHE_ENTRIES && entry->font != NULL; i++) {
+        if (fontCache[i].font == NULL || fontCache[i].lastUse < entry->lastUse) entry = &fontCache[i];
+    }
+
+    if (entry->font != NULL) {
+        entry->font->cacheSlots[entry->index] = 0;
+        fontCacheStats.evictions++;
+    }
+
+    /* Se avanza desde la entrada del índice anterior al glifo, recorriendo los intermedios */
+    uint32_t bit = font->packedIndex[index / FONT_PACK_INDEX_STEP];
+    for (uint8_t i = index - index % FONT_PACK_INDEX_STEP; i < index; i++) {
+        bit = fontUnpack(font, bit, NULL);
+    }
+    fontUnpack(font, bit, entry->data);
+
+    entry->font = font;
+    entry->index = index;
+    entry->lastUse = ++fontCacheClock;
+    font->cacheSlots[index] = (uint8_t)(entry - fontCache) + 1;
+    fontCacheStats.misses++;
+
+    return entry->data;
+}
+
+/**
+ * @brief Descomprime el glifo que empieza en un bit del flujo.
+ *
+ * @param out Destino en orden de página, o NULL para solo saltear el glifo.
+ * @return Bit donde empieza el glifo siguiente.
+ */
+static uint32_t fontUnpack(const font_t* font, uint32_t bit, uint8_t* out) {
+
+    uint32_t column = 0;
+
+    for (uint8_t x = 0; x < font->width; x++) {
+
+        if (fontReadBits(font->packed, &bit, 1)) {
+            column = fontReadBits(font->packed, &bit, font->rows);
+        } else if (!fontReadBits(font->packed, &bit, 1)) {
+            column = 0;
+        }
+
+        if (out == NULL) continue;
+        for (uint8_t p = 0; p < font->pages; p++) {
+            out[p * font->width + x] = (uint8_t)(column >> (8 * p));
+        }
+    }
+
+    return bit;
+}
+
+/**
+ * @brief Lee count bits del flujo (el bit 0 de cada byte primero) y avanza la posición.
+ */
+static uint32_t fontReadBits(const uint8_t* data, uint32_t* bit, uint8_t count) {
+
+    uint32_t value = 0;
+
+    for (uint8_t i = 0; i < count; i++, (*bit)++) {
+        value |= (uint32_t)((data[*bit >> 3] >> (*bit & 7)) & 1u) << i;
+    }
+
+    return value;
+}
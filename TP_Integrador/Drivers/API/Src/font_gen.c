@@ -0,0 +1,130 @@
+/*
+ * @file font_gen.c
+ *
+ * Archivo generado por Tools/fontgen.py a partir de Font5x7. No editar.
+ */
+#include "../../Drivers/API/Inc/font.h"
+
+/* FontDigits2x: 260 bytes sin comprimir, 115 comprimidos (flujo e índice), '-' a '9' */
+static const uint8_t FontDigits2xPacked[] = {
+    0x81,0x01,0x55,0x55,0x21,0x00,0xAF,0x02,0x04,0x60,0x0C,0x30,0x18,0x18,0x30,0x0C,
+    0x60,0x06,0xC0,0xFC,0x8F,0x07,0x66,0x0F,0xC3,0x9E,0x81,0xCD,0xFF,0x08,0x19,0x60,
+    0xFF,0xFF,0x06,0x80,0x85,0x0C,0xB0,0x07,0x78,0x0F,0xCC,0x1E,0x86,0xCD,0x03,0x7B,
+    0x80,0xF1,0x00,0xEC,0x19,0xD8,0xCF,0xB0,0x07,0x1E,0x03,0x0F,0x86,0x19,0xCC,0x30,
+    0xF8,0xFF,0x37,0xC0,0xE0,0x1F,0xC6,0x33,0xB0,0xAA,0x87,0x1F,0xC3,0x3F,0x66,0x86,
+    0x3D,0x0C,0xAB,0x01,0x1E,0x0F,0x00,0x1E,0xF8,0x3D,0x0C,0x78,0x06,0xF0,0x03,0x60,
+    0x9E,0xC7,0xC3,0xB0,0xAA,0x79,0x1E,0xF3,0x00,0x1E,0x86,0xD5,0xC3,0x8C,0xF9,0x07,
+    0x01,
+};
+
+static const uint16_t FontDigits2xIndex[] = {
+    0,
+};
+
+static uint8_t FontDigits2xSlots[13];
+
+const font_t FontDigits2x = {
+    .width = 10,
+    .pages = 2,
+    .first = '-',
+    .last = '9',
+    .spacing = 2,
+    .widths = NULL,
+    .glyphs = NULL,
+    .rows = 14,
+    .packed = FontDigits2xPacked,
+    .packedIndex = FontDigits2xIndex,
+    .cacheSlots = FontDigits2xSlots,
+};
+
+/* FontDigits3x: 585 bytes sin comprimir, 174 comprimidos (flujo e índice), '-' a '9' */
+static const uint8_t FontDigits3xPacked[] = {
+    0x01,0x1C,0x80,0xAA,0xAA,0xAA,0x02,0x01,0x00,0xBF,0xAA,0x00,0x10,0x00,0x70,0x68,
+    0x00,0x38,0xA0,0x01,0x1C,0x80,0x06,0x0E,0x00,0x1A,0x07,0x00,0x68,0xFC,0xFF,0xA1,
+    0x0F,0xE0,0xB8,0x3E,0x70,0xE0,0xFA,0x38,0x80,0x6B,0xFC,0xFF,0xA1,0x40,0x1C,0x00,
+    0xAE,0xFF,0xFF,0xBF,0x06,0x00,0xE0,0x0A,0xC4,0x01,0xE0,0xFA,0x00,0xF0,0xEB,0x03,
+    0x38,0xAE,0x0F,0x1C,0xB8,0xC6,0x0F,0xE0,0xFA,0x00,0x70,0xE8,0x03,0x00,0xAE,0x8F,
+    0x03,0xB8,0xFE,0x71,0xE0,0xFA,0x00,0x7E,0x68,0x00,0x3F,0xA0,0x81,0xE3,0x80,0xC6,
+    0x81,0x03,0xFA,0xFF,0xFF,0x6B,0x00,0x38,0xA0,0xFF,0x03,0x87,0x3E,0x0E,0xE0,0xAA,
+    0xAA,0x0F,0xFC,0x87,0x06,0xFE,0x1F,0x1A,0xC7,0x81,0xEB,0x03,0x07,0xAE,0x6A,0x00,
+    0xF8,0xA1,0x0F,0x00,0x80,0x3E,0x80,0xFF,0xFA,0xC0,0x01,0xE8,0xE3,0x00,0xA0,0x7F,
+    0x00,0x80,0xC6,0x8F,0x1F,0xFA,0xC0,0x81,0xAB,0xAA,0xC6,0x8F,0x1F,0x1A,0x3F,0x00,
+    0xE8,0x03,0x07,0xAE,0xEA,0x03,0xC7,0xA1,0xF1,0xFF,0x80,0x02,
+};
+
+static const uint16_t FontDigits3xIndex[] = {
+    0,
+};
+
+static uint8_t FontDigits3xSlots[13];
+
+const font_t FontDigits3x = {
+    .width = 15,
+    .pages = 3,
+    .first = '-',
+    .last = '9',
+    .spacing = 3,
+    .widths = NULL,
+    .glyphs = NULL,
+    .rows = 21,
+    .packed = FontDigits3xPacked,
+    .packedIndex = FontDigits3xIndex,
+    .cacheSlots = FontDigits3xSlots,
+};
+
+/* FontProportional: 475 bytes sin comprimir, 388 comprimidos (flujo e índice), ' ' a '~' */
+static const uint8_t FontProportionalPacked[] = {
+    0x00,0xFC,0x02,0x3C,0xF0,0x00,0x29,0xFF,0x29,0xFF,0x29,0x49,0x55,0xFF,0x55,0x25,
+    0x47,0x27,0x11,0xC9,0xC5,0x6D,0x93,0xAB,0x45,0xA1,0x0B,0x07,0x40,0x4E,0xD1,0x20,
+    0x0C,0x16,0xE5,0x40,0x4A,0x44,0x5F,0x44,0x4A,0x84,0x7D,0x11,0x86,0x86,0x01,0x11,
+    0xAA,0xC1,0x02,0x41,0x21,0x11,0x09,0x05,0x7D,0xA3,0x93,0x8B,0x7D,0x85,0xFF,0x81,
+    0x50,0x38,0x3C,0x3A,0xD9,0x38,0x34,0xB8,0x78,0x39,0x16,0x93,0x52,0xF2,0x1F,0xF2,
+    0xB4,0xA8,0x73,0x79,0x95,0x93,0x86,0x0D,0x8C,0x4F,0x2C,0x1C,0xB4,0x4D,0x6A,0x5B,
+    0xC3,0xA4,0x53,0x3D,0x6D,0x02,0xAD,0x6D,0x40,0x44,0x4A,0xD1,0x20,0x29,0xAA,0x83,
+    0x45,0x29,0x11,0x14,0x0C,0x8C,0x4E,0x34,0x94,0x4D,0xCE,0x0F,0xF6,0xF5,0x8F,0x68,
+    0xFF,0xFF,0xA4,0xB6,0xF5,0x0D,0x6A,0xD1,0xFF,0xA0,0x45,0x39,0xFF,0x93,0x3A,0xF8,
+    0x3F,0xA1,0x03,0x7D,0x83,0x93,0xD6,0xFF,0x47,0xE8,0xFF,0xE0,0xFF,0x20,0x04,0x05,
+    0x0E,0xFE,0x0D,0xFC,0x47,0xA4,0x14,0x0D,0xFE,0x07,0xAA,0xFF,0x05,0x19,0x05,0xFF,
+    0xFF,0x09,0x11,0x21,0xFF,0x7D,0x83,0xDA,0xF7,0x3F,0xA1,0x0D,0x7D,0x83,0xA3,0x43,
+    0xBD,0xFF,0x13,0x33,0x53,0x8D,0x8D,0x93,0x3A,0x36,0xE0,0xFF,0x80,0x7F,0x81,0xFA,
+    0xF7,0x13,0x14,0x18,0xF4,0xF3,0x17,0x18,0x17,0xF8,0x77,0x9C,0x12,0x91,0x72,0xFC,
+    0x10,0x11,0x1E,0xF1,0x30,0x3C,0x3A,0xB9,0x78,0xF8,0x3F,0x28,0x14,0x24,0x44,0x84,
+    0x04,0x0D,0xFA,0x0F,0x09,0x05,0x03,0x05,0x09,0x81,0xAA,0x03,0x05,0x09,0x10,0x94,
+    0xAA,0xF1,0xFF,0x91,0x89,0xC6,0xC5,0x25,0x6A,0x50,0x5C,0xA2,0x91,0xFF,0x71,0xA9,
+    0x1A,0x13,0xD1,0x3F,0x31,0x50,0x90,0x51,0xAA,0x7D,0xFF,0x11,0x09,0xC6,0x27,0xEE,
+    0x07,0x42,0x50,0x60,0xE2,0x1E,0xFF,0x21,0x51,0x89,0x0C,0xFE,0x07,0x42,0x7E,0x42,
+    0x4C,0x42,0x7C,0x7E,0x44,0x82,0xF1,0x71,0x89,0x1A,0x97,0x9F,0xA2,0x11,0x11,0x29,
+    0xC6,0xE4,0xE7,0x47,0x24,0x18,0x11,0x99,0xAA,0x41,0x09,0x7F,0x89,0x81,0x41,0x79,
+    0x81,0x06,0xE5,0xE7,0x04,0x05,0x06,0xE5,0xE4,0x05,0x86,0x05,0xE6,0x25,0x46,0x85,
+    0x44,0x25,0x66,0x84,0x6A,0x5E,0x62,0x72,0x6A,0x66,0x62,0x44,0xDB,0x20,0xFC,0x03,
+    0x0C,0xB6,0x45,0x40,0x48,0x84,0x21,0x11,
+};
+
+static const uint16_t FontProportionalIndex[] = {
+    0,448,962,1476,2008,2516,
+};
+
+static uint8_t FontProportionalSlots[95];
+
+static const uint8_t FontProportionalWidths[] = {
+    3,1,3,5,5,5,5,2,3,3,5,5,2,5,2,5,
+    5,3,5,5,5,5,5,5,5,5,2,2,4,5,4,5,
+    5,5,5,5,5,5,5,5,5,3,5,5,5,5,5,5,
+    5,5,5,5,5,5,5,5,5,5,5,3,5,3,5,5,
+    3,5,5,5,5,5,5,5,5,3,4,4,3,5,5,5,
+    5,5,5,5,5,5,5,5,5,5,5,3,1,3,5,
+};
+
+const font_t FontProportional = {
+    .width = 5,
+    .pages = 1,
+    .first = ASCII_MIN,
+    .last = ASCII_MAX,
+    .spacing = 1,
+    .widths = FontProportionalWidths,
+    .glyphs = NULL,
+    .rows = 7,
+    .packed = FontProportionalPacked,
+    .packedIndex = FontProportionalIndex,
+    .cacheSlots = FontProportionalSlots,
+};
@@ -0,0 +1,280 @@
+/**
+ * @file filter_trace.c
+ * @brief Ejecuta la cadena de filtros de API_filter sobre una traza de mediciones en una PC.
+ *
+ * La traza es un archivo de texto con una medición por línea: distancia [mm], código
+ * de error del sensor y, opcionalmente, la distancia real [mm] si se conoce. Sin
+ * archivo se genera una traza sintética de TRAZA_LARGO mediciones: un objetivo que se
+ * queda quieto y se mueve con distintas velocidades, con ruido de medición, picos
+ * aislados, mediciones con código de error (LOW_SIGNAL, LOW_SN, TOO_MUCH_AMB, WAF) y
+ * lecturas en 0 sin error.
+ *
+ * Cada configuración de la cadena filtra la traza completa y se informa:
+ * - mediciones aceptadas y descartadas por la compuerta;
+ * - con la distancia real: error cuadrático medio, error máximo y salidas que se
+ *   apartan más de PICO_MM (picos que pasaron), después de las primeras ARRANQUE;
+ * - sin ella: desvío de la diferencia entre salidas consecutivas (ruido de la salida).
+ *
+ * Con la traza sintética se verifica que ninguna medición con error o en 0 llegue a la
+ * salida, que la configuración por defecto no deje pasar picos y que reduzca el error
+ * de la medición sin filtrar a menos de la mitad. Devuelve 0 si se cumplen todas las
+ * verificaciones.
+ *
+ * Uso: filter_trace [traza.txt [salida.txt]]
+ *      salida.txt recibe, por línea, la medición y la salida de la configuración por defecto.
+ *
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include <math.h>
+ #include <time.h>
+ #include "../../Drivers/API/Inc/API_filter.h"
+ 
+ /// @brief Mediciones de la traza sintética.
+ #define TRAZA_LARGO         20000
+ 
+ /// @brief Mediciones iniciales que no cuentan para el error (la ventana se está llenando).
+ #define ARRANQUE            10
+ 
+ /// @brief Apartamiento de la distancia real a partir del cual una salida es un pico (mm).
+ #define PICO_MM             60
+ 
+ /// @brief Mediciones sintéticas con pico (%).
+ #define PICOS_PCT           2
+ 
+ /// @brief Mediciones sintéticas con código de error (%).
+ #define ERRORES_PCT         3
+ 
+ /// @brief Lecturas sintéticas en 0 sin código de error (%).
+ #define CEROS_PCT           1
+ 
+ /**
+  * @brief Medición de la traza.
+  */
+ typedef struct {
+     uint16_t distance;
+     uint8_t errorCode;
+     int32_t real;           /**< Distancia real [mm], o -1 si no se conoce. */
+ } medicion_t;
+ 
+ /**
+  * @brief Configuración evaluada.
+  */
+ typedef struct {
+     const char* nombre;
+     filterConfig_t config;
+ } prueba_t;
+ 
+ static medicion_t* traza;
+ static uint32_t largo;
+ 
+ /**
+  * @brief Generador pseudoaleatorio (congruencial lineal) para que cada corrida sea igual.
+  */
+ static uint32_t aleatorio(void) {
+ 
+     static uint32_t estado = 12345u;
+ 
+     estado = estado * 1103515245u + 12345u;
+     return estado >> 8;
+ }
+ 
+ /**
+  * @brief Genera la traza sintética.
+  */
+ static void generar(void) {
+ 
+     //Tramos de la distancia real: mediciones y velocidad (mm/medición)
+     static const struct { uint16_t n; int8_t v; } tramos[] = {
+         {400, 0}, {300, 2}, {200, 0}, {100, -8}, {300, 0}, {600, 1}, {150, -4}, {250, 0}, {50, 6}, {100, 0},
+     };
+     static const uint8_t errores[] = {0x02, 0x04, 0x08, 0x10};
+     const uint8_t cantTramos = sizeof(tramos) / sizeof(tramos[0]);
+     uint8_t tramo = 0;
+     uint16_t resto = tramos[0].n;
+     int32_t real = 500;
+ 
+     largo = TRAZA_LARGO;
+     traza = malloc(largo * sizeof(*traza));
+ 
+     for (uint32_t i = 0; i < largo; i++) {
+ 
+         //Los tramos se repiten; la distancia se mantiene entre 100 y 1900 mm
+         if (resto == 0) {
+             tramo = (tramo + 1) % cantTramos;
+             resto = tramos[tramo].n;
+         }
+         resto--;
+         real += tramos[tramo].v;
+         if (real < 100 || real > 1900) real -= tramos[tramo].v;
+ 
+         //Ruido aproximadamente gaussiano: suma de cuatro uniformes, desvío de unos 7 mm
+         int32_t ruido = 0;
+         for (uint8_t j = 0; j < 4; j++) ruido += (int32_t)(aleatorio() % 25) - 12;
+ 
+         medicion_t m = { (uint16_t)(real + ruido), 0, real };
+         uint32_t r = aleatorio() % 100;
+         if (r < PICOS_PCT) {
+             m.distance = (uint16_t)(real + ((aleatorio() & 1) ? 1 : -1) * (int32_t)(150 + aleatorio() % 400));
+         } else if (r < PICOS_PCT + ERRORES_PCT) {
+             m.errorCode = errores[aleatorio() % sizeof(errores)];
+             m.distance = (uint16_t)(aleatorio() % 3000);
+         } else if (r < PICOS_PCT + ERRORES_PCT + CEROS_PCT) {
+             m.distance = 0;
+         }
+         traza[i] = m;
+     }
+ }
+ 
+ /**
+  * @brief Lee una traza de un archivo de texto.
+  *
+  * @return false si no se pudo abrir o no tiene mediciones.
+  */
+ static bool leer(const char* archivo) {
+ 
+     FILE* f = fopen(archivo, "r");
+     char linea[128];
+     uint32_t capacidad = 1024;
+ 
+     if (f == NULL) return false;
+ 
+     traza = malloc(capacidad * sizeof(*traza));
+     largo = 0;
+     while (fgets(linea, sizeof(linea), f) != NULL) {
+         unsigned distancia, codigo;
+         int real = -1;
+         if (sscanf(linea, "%u %u %d", &distancia, &codigo, &real) < 2) continue;
+         if (largo == capacidad) {
+             capacidad *= 2;
+             traza = realloc(traza, capacidad * sizeof(*traza));
+         }
+         traza[largo++] = (medicion_t){ (uint16_t)distancia, (uint8_t)codigo, real };
+     }
+     fclose(f);
+ 
+     return largo > 0;
+ }
+ 
+ /**
+  * @brief Filtra la traza con una configuración e imprime sus resultados.
+  *
+  * @param salida Archivo donde escribir la medición y la salida de cada línea, o NULL.
+  * @param picos Destino de las salidas apartadas más de PICO_MM (si hay distancia real).
+  * @param rms Destino del error cuadrático medio (si hay distancia real).
+  * @param filtradas Destino de las mediciones con error o en 0 que cambiaron la salida.
+  */
+ static void probar(const prueba_t* p, FILE* salida, uint32_t* picos, double* rms, uint32_t* filtradas) {
+ 
+     filter_t filtro;
+     double suma = 0, sumaDif = 0, sumaDif2 = 0;
+     uint32_t n = 0, nDif = 0, maximo = 0;
+     uint16_t anterior = 0;
+     struct timespec inicio, fin;
+ 
+     *picos = 0;
+     *filtradas = 0;
+     filterInit(&filtro, &p->config);
+ 
+     clock_gettime(CLOCK_MONOTONIC, &inicio);
+     for (uint32_t i = 0; i < largo; i++) {
+ 
+         const medicion_t* m = &traza[i];
+         bool aceptada = filterUpdate(&filtro, m->distance, m->errorCode);
+         uint16_t salidaMm = filterValue(&filtro);
+ 
+         if (aceptada && (m->errorCode != 0 || m->distance == 0)) (*filtradas)++;
+         if (salida != NULL) fprintf(salida, "%u %u %u\n", m->distance, m->errorCode, salidaMm);
+         if (!aceptada || filterGetStats(&filtro).accepted <= ARRANQUE) continue;
+ 
+         if (m->real >= 0) {
+             uint32_t error = (uint32_t)abs((int32_t)salidaMm - m->real);
+             suma += (double)error * error;
+             if (error > maximo) maximo = error;
+             if (error > PICO_MM) (*picos)++;
+             n++;
+         } else {
+             double dif = (double)salidaMm - anterior;
+             sumaDif += dif;
+             sumaDif2 += dif * dif;
+             nDif++;
+         }
+         anterior = salidaMm;
+     }
+     clock_gettime(CLOCK_MONOTONIC, &fin);
+ 
+     filterStats_t s = filterGetStats(&filtro);
+     double ns = ((fin.tv_sec - inicio.tv_sec) * 1e9 + (fin.tv_nsec - inicio.tv_nsec)) / largo;
+ 
+     printf("%-22s aceptadas %6u  por error %5u  fuera de rango %5u", p->nombre, s.accepted, s.rejectedError, s.rejectedRange);
+     if (n > 0) {
+         *rms = sqrt(suma / n);
+         printf("  error rms %6.2f mm  max %4u mm  picos %4u", *rms, maximo, *picos);
+     } else if (nDif > 1) {
+         double media = sumaDif / nDif;
+         printf("  ruido de la salida %6.2f mm", sqrt(sumaDif2 / nDif - media * media));
+     }
+     printf("  %.0f ns/medicion en la PC\n", ns);
+ }
+ 
+ int main(int argc, char** argv) {
+ 
+     const prueba_t pruebas[] = {
+         { "compuerta",             { 0xFF, 1, FILTER_DISTANCE_MAX, 1, FILTER_Q15_ONE,  false, 0, 0 } },
+         { "mediana 5",             { 0xFF, 1, FILTER_DISTANCE_MAX, 5, FILTER_Q15_ONE,  false, 0, 0 } },
+         { "mediana 5 + EMA 0,25",  { 0xFF, 1, FILTER_DISTANCE_MAX, 5, FILTER_Q15(0.25), false, 0, 0 } },
+         { "por defecto (Kalman)",  FILTER_CONFIG_DEFAULT },
+         { "mediana 7 + Kalman",    { 0xFF, 1, FILTER_DISTANCE_MAX, 7, FILTER_Q15_ONE,  true, FILTER_Q16(25.0), FILTER_Q16(0.05) } },
+     };
+     const uint8_t porDefecto = 3;
+     bool sintetica = (argc < 2);
+     FILE* salida = NULL;
+     bool ok = true;
+     double rmsCompuerta = 0, rmsPorDefecto = 0;
+ 
+     if (sintetica) {
+         generar();
+         printf("Traza sintetica de %u mediciones (%u%% picos, %u%% con codigo de error, %u%% en 0)\n",
+                largo, PICOS_PCT, ERRORES_PCT, CEROS_PCT);
+     } else if (!leer(argv[1])) {
+         fprintf(stderr, "No se pudo leer la traza %s\n", argv[1]);
+         return 1;
+     } else {
+         printf("Traza %s: %u mediciones\n", argv[1], largo);
+     }
+     if (argc > 2) salida = fopen(argv[2], "w");
+ 
+     for (uint8_t i = 0; i < sizeof(pruebas) / sizeof(pruebas[0]); i++) {
+ 
+         uint32_t picos, filtradas;
+         double rms = 0;
+ 
+         probar(&pruebas[i], (i == porDefecto) ? salida : NULL, &picos, &rms, &filtradas);
+ 
+         if (filtradas > 0) {
+             printf("        ERROR: %u mediciones con error o en 0 llegaron a la salida\n", filtradas);
+             ok = false;
+         }
+         if (i == 0) rmsCompuerta = rms;
+         if (i == porDefecto) {
+             rmsPorDefecto = rms;
+             if (sintetica && picos > 0) {
+                 printf("        ERROR: la configuracion por defecto dejo pasar %u picos\n", picos);
+                 ok = false;
+             }
+         }
+     }
+ 
+     if (sintetica && !(rmsPorDefecto < rmsCompuerta / 2)) {
+         printf("        ERROR: la configuracion por defecto no reduce el error a menos de la mitad\n");
+         ok = false;
+     }
+ 
+     if (salida != NULL) fclose(salida);
+     free(traza);
+     printf("%s\n", ok ? "OK" : "FALLO");
+ 
+     return ok ? 0 : 1;
+ }
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""
+@file fontgen.py
+@brief Genera las fuentes derivadas de Font5x7 para el display SSD1306.
+
+Lee la tabla Font5x7 de Drivers/API/Src/font.c y escribe
+Drivers/API/Src/font_gen.c con:
+
+  - FontDigits2x: dígitos escalados x2 (10x14 px, 2 páginas).
+  - FontDigits3x: dígitos escalados x3 (15x21 px, 3 páginas).
+  - FontProportional: Font5x7 con el ancho recortado de cada carácter.
+
+Los glifos se comprimen por columnas (ver pack_glyph) en un flujo de bits
+con un índice cada PACK_INDEX_STEP glifos; el driver los descomprime al
+usarlos por primera vez en un caché en RAM (font_cache.c), ya en orden de
+página: width * pages bytes, primero todas las columnas de la página
+superior. Así el escalado nunca se hace al dibujar.
+
+Uso (paso previo a la compilación, desde la carpeta del proyecto):
+    python3 Tools/fontgen.py
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+FONT_SRC = os.path.join(ROOT, "Drivers", "API", "Src", "font.c")
+FONT_OUT = os.path.join(ROOT, "Drivers", "API", "Src", "font_gen.c")
+
+ASCII_OFFSET = 32
+FONT_HEIGHT = 7
+
+# Caracteres incluidos en las fuentes de dígitos (rango contiguo).
+DIGITS_FIRST = "-"
+DIGITS_LAST = "9"
+
+# Ancho del espacio en la fuente proporcional.
+PROPORTIONAL_SPACE_WIDTH = 3
+
+# Glifos entre entradas del índice del flujo comprimido (FONT_PACK_INDEX_STEP en font.h).
+PACK_INDEX_STEP = 16
+
+# Bytes de cada entrada del caché de glifos (FONT_CACHE_GLYPH_BYTES en font.h).
+CACHE_GLYPH_BYTES = 48
+
+
+def read_font5x7(path):
+    """Devuelve la lista de glifos (5 columnas cada uno) desde ASCII 32."""
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    body = text[text.index("Font5x7"):]
+    glyphs = []
+    for row in re.findall(r"\{([^{}]*)\}", body):
+        values = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", row)]
+        if len(values) == 5:
+            glyphs.append(values)
+    return glyphs
+
+
+def scale_glyph(columns, factor):
+    """Escala un glifo 5x7 y lo devuelve en orden de página."""
+    height = FONT_HEIGHT * factor
+    pages = (height + 7) // 8
+    scaled = []
+    for column in columns:
+        bits = 0
+        for y in range(FONT_HEIGHT):
+            if column & (1 << y):
+                for k in range(factor):
+                    bits |= 1 << (y * factor + k)
+        scaled.extend([bits] * factor)
+    out = []
+    for page in range(pages):
+        out.extend((bits >> (8 * page)) & 0xFF for bits in scaled)
+    return out, len(scaled), pages
+
+
+def trim_glyph(columns):
+    """Quita las columnas vacías a izquierda y derecha de un glifo."""
+    used = [i for i, c in enumerate(columns) if c]
+    if not used:
+        return [0] * 5, PROPORTIONAL_SPACE_WIDTH
+    start, end = used[0], used[-1]
+    trimmed = columns[start:end + 1]
+    return trimmed + [0] * (5 - len(trimmed)), len(trimmed)
+
+
+def glyph_columns(data, width, pages):
+    """Devuelve las columnas de un glifo en orden de página como enteros de pages * 8 bits."""
+    return [sum(data[p * width + c] << (8 * p) for p in range(pages)) for c in range(width)]
+
+
+def pack_glyph(bits, columns, rows):
+    """
+    Agrega las columnas de un glifo al flujo de bits (el bit 0 de cada byte primero).
+
+    Cada columna se codifica como:
+      1 + rows bits   columna literal (la fila superior primero)
+      0 1             repite la columna anterior
+      0 0             columna vacía
+    Los dígitos escalados repiten cada columna 2 o 3 veces y los glifos de 5x7
+    tienen columnas vacías, por lo que casi todas las columnas no literales
+    cuestan 2 bits.
+    """
+    previous = 0
+    for column in columns:
+        if column == 0:
+            bits += [0, 0]
+        elif column == previous:
+            bits += [0, 1]
+        else:
+            bits.append(1)
+            bits += [(column >> y) & 1 for y in range(rows)]
+        previous = column
+
+
+def pack_font(glyphs, width, pages, rows):
+    """Comprime los glifos y devuelve (bytes del flujo, índice en bits)."""
+    bits, index = [], []
+    for i, data in enumerate(glyphs):
+        if i % PACK_INDEX_STEP == 0:
+            index.append(len(bits))
+        pack_glyph(bits, glyph_columns(data, width, pages), rows)
+    bits += [0] * (-len(bits) % 8)
+    data = [sum(bits[i + k] << k for k in range(8)) for i in range(0, len(bits), 8)]
+    return data, index
+
+
+def char_comment(code):
+    ch = chr(code)
+    return ch if ch not in "\\" else "backslash"
+
+
+def emit_packed(lines, name, glyphs, codes, width, pages, rows, sizes):
+    """Escribe el flujo comprimido, su índice y los índices del caché de una fuente."""
+    if width * pages > CACHE_GLYPH_BYTES:
+        sys.exit("fontgen: el glifo de %s no entra en el caché" % name)
+    data, index = pack_font(glyphs, width, pages, rows)
+    raw = len(glyphs) * width * pages
+    packed = len(data) + 2 * len(index)
+    sizes.append((name, width, rows, raw, packed))
+    lines.append("/* %s: %d bytes sin comprimir, %d comprimidos (flujo e índice), '%s' a '%s' */"
+                 % (name, raw, packed, char_comment(codes[0]), char_comment(codes[-1])))
+    lines.append("static const uint8_t %sPacked[] = {" % name)
+    for i in range(0, len(data), 16):
+        lines.append("    " + ",".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const uint16_t %sIndex[] = {" % name)
+    lines.append("    " + ",".join("%d" % b for b in index) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static uint8_t %sSlots[%d];" % (name, len(glyphs)))
+    lines.append("")
+
+
+def emit_descriptor_packed(lines, name, rows):
+    lines += [
+        "    .glyphs = NULL,",
+        "    .rows = %d," % rows,
+        "    .packed = %sPacked," % name,
+        "    .packedIndex = %sIndex," % name,
+        "    .cacheSlots = %sSlots," % name,
+    ]
+
+
+def main():
+    font = read_font5x7(FONT_SRC)
+    if len(font) != 126 - ASCII_OFFSET + 1:
+        sys.exit("fontgen: Font5x7 incompleta en %s" % FONT_SRC)
+
+    lines = [
+        "/*",
+        " * @file font_gen.c",
+        " *",
+        " * Archivo generado por Tools/fontgen.py a partir de Font5x7. No editar.",
+        " */",
+        '#include "../../Drivers/API/Inc/font.h"',
+        "",
+    ]
+
+    sizes = []
+    digit_codes = list(range(ord(DIGITS_FIRST), ord(DIGITS_LAST) + 1))
+    for factor in (2, 3):
+        name = "FontDigits%dx" % factor
+        glyphs = []
+        for code in digit_codes:
+            data, width, pages = scale_glyph(font[code - ASCII_OFFSET], factor)
+            glyphs.append(data)
+        emit_packed(lines, name, glyphs, digit_codes, width, pages, FONT_HEIGHT * factor, sizes)
+        lines += [
+            "const font_t %s = {" % name,
+            "    .width = %d," % width,
+            "    .pages = %d," % pages,
+            "    .first = '%s'," % DIGITS_FIRST,
+            "    .last = '%s'," % DIGITS_LAST,
+            "    .spacing = %d," % factor,
+            "    .widths = NULL,",
+        ]
+        emit_descriptor_packed(lines, name, FONT_HEIGHT * factor)
+        lines += [
+            "};",
+            "",
+        ]
+
+    prop_codes = list(range(ASCII_OFFSET, 126 + 1))
+    glyphs, widths = [], []
+    for code in prop_codes:
+        data, width = trim_glyph(font[code - ASCII_OFFSET])
+        glyphs.append(data)
+        widths.append(width)
+    emit_packed(lines, "FontProportional", glyphs, prop_codes, 5, 1, FONT_HEIGHT, sizes)
+    lines.append("static const uint8_t FontProportionalWidths[] = {")
+    for i in range(0, len(widths), 16):
+        lines.append("    " + ",".join("%d" % w for w in widths[i:i + 16]) + ",")
+    lines += [
+        "};",
+        "",
+        "const font_t FontProportional = {",
+        "    .width = 5,",
+        "    .pages = 1,",
+        "    .first = ASCII_MIN,",
+        "    .last = ASCII_MAX,",
+        "    .spacing = 1,",
+        "    .widths = FontProportionalWidths,",
+    ]
+    emit_descriptor_packed(lines, "FontProportional", FONT_HEIGHT)
+    lines.append("};")
+
+    with open(FONT_OUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(lines) + "\n")
+
+    for name, width, rows, raw, packed in sizes:
+        print("%-18s %2dx%-2d %4d bytes -> %4d bytes (%d%% menos)"
+              % (name, width, rows, raw, packed, 100 * (raw - packed) // raw))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,177 @@
+/**
+ * @file HAL_Stub.c
+ * @brief HAL simulada: envía al emulador las transferencias I2C y SPI de SSD1306_Port.c.
+ *
+ * Permite compilar en la PC la capa de puerto real, con cualquiera de los dos
+ * transportes. En I2C el panel se elige por la dirección de la transacción; en SPI,
+ * por el handle (HAL_Stub_SpiAttach()), y el byte de control se reconstruye a partir
+ * del pin D/C. Por defecto las transferencias "DMA" se completan en el momento, antes
+ * de que el driver retome el control. Con HAL_Stub_SetDeferred(true) quedan en curso
+ * hasta que se llama a HAL_Stub_Run(), como en el hardware, lo que permite ver cómo se
+ * intercalan las tramas de varios displays.
+ *
+ */
+
+ #include "HAL_Stub.h"
+ #include "SSD1306_Emu.h"
+ #include <string.h>
+ 
+ /// @brief Transferencias DMA en curso como máximo (una por bus).
+ #define STUB_MAX_PENDING    4
+ 
+ GPIO_TypeDef HAL_Stub_GPIOA;
+ GPIO_TypeDef HAL_Stub_GPIOB;
+ GPIO_TypeDef HAL_Stub_GPIOC;
+ 
+ /**
+  * @brief Transferencia DMA cuyo fin todavía no se avisó.
+  */
+ typedef struct {
+     I2C_HandleTypeDef* hi2c;    /**< Bus I2C, o NULL si es SPI. */
+     SPI_HandleTypeDef* hspi;    /**< Bus SPI, o NULL si es I2C. */
+ } HAL_StubPending_t;
+ 
+ static HAL_StubPending_t pending[STUB_MAX_PENDING];
+ static uint8_t pendingCount;
+ 
+ /// @brief Tiempo simulado (ms).
+ static uint32_t tick;
+ 
+ /// @brief Las transferencias se completan solo desde HAL_Stub_Run().
+ static bool deferred;
+ 
+ /// @brief Indica que se están despachando completados (evita la recursión callback -> DMA -> callback).
+ static bool running;
+ 
+ static uint32_t spiErrors;
+ 
+ static void HAL_Stub_SpiWrite(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size);
+ static void HAL_Stub_Queue(I2C_HandleTypeDef *hi2c, SPI_HandleTypeDef *hspi);
+ 
+ uint32_t HAL_GetTick(void) {
+     return tick;
+ }
+ 
+ void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+ 
+     if (PinState == GPIO_PIN_SET) GPIOx->ODR |= GPIO_Pin;
+     else GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+ }
+ 
+ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+ 
+     (void)hi2c;
+     (void)MemAddSize;
+     (void)Timeout;
+ 
+     SSD1306_Emu_Write((uint8_t)(DevAddress >> 1), (uint8_t)MemAddress, pData, Size);
+     return HAL_OK;
+ }
+ 
+ HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+ 
+     HAL_I2C_Mem_Write(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, HAL_MAX_DELAY);
+     HAL_Stub_Queue(hi2c, NULL);
+     return HAL_OK;
+ }
+ 
+ HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+ 
+     (void)Timeout;
+ 
+     HAL_Stub_SpiWrite(hspi, pData, Size);
+     return HAL_OK;
+ }
+ 
+ HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size) {
+ 
+     HAL_Stub_SpiWrite(hspi, pData, Size);
+     HAL_Stub_Queue(NULL, hspi);
+     return HAL_OK;
+ }
+ 
+ /// @brief Callbacks por defecto, como los "weak" de la HAL: la capa de puerto define los de su transporte.
+ __attribute__((weak)) void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) { (void)hi2c; }
+ __attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) { (void)hi2c; }
+ __attribute__((weak)) void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) { (void)hspi; }
+ __attribute__((weak)) void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi) { (void)hspi; }
+ 
+ /**
+  * @brief Conecta un panel del emulador a un bus SPI con sus pines D/C y CS.
+  */
+ void HAL_Stub_SpiAttach(SPI_HandleTypeDef* hspi, uint8_t address, GPIO_TypeDef* dcPort, uint16_t dcPin, GPIO_TypeDef* csPort, uint16_t csPin) {
+ 
+     hspi->stubAddress = address;
+     hspi->stubDcPort = dcPort;
+     hspi->stubDcPin = dcPin;
+     hspi->stubCsPort = csPort;
+     hspi->stubCsPin = csPin;
+ }
+ 
+ /**
+  * @brief Completa las transferencias DMA en curso hasta que no queda ninguna.
+  */
+ void HAL_Stub_Run(void) {
+ 
+     running = true;
+ 
+     while (pendingCount > 0) {
+         HAL_StubPending_t done = pending[0];
+         pendingCount--;
+         memmove(&pending[0], &pending[1], pendingCount * sizeof(pending[0]));
+ 
+         if (done.hi2c != NULL) HAL_I2C_MemTxCpltCallback(done.hi2c);
+         else HAL_SPI_TxCpltCallback(done.hspi);
+     }
+ 
+     running = false;
+ }
+ 
+ /**
+  * @brief Selecciona si las transferencias DMA se completan en el momento o desde HAL_Stub_Run().
+  */
+ void HAL_Stub_SetDeferred(bool enable) {
+     deferred = enable;
+ }
+ 
+ /**
+  * @brief Avanza el tiempo simulado que devuelve HAL_GetTick().
+  */
+ void HAL_Stub_Advance(uint32_t ms) {
+     tick += ms;
+ }
+ 
+ /**
+  * @brief Devuelve la cantidad de transferencias SPI hechas con CS en alto.
+  */
+ uint32_t HAL_Stub_SpiErrors(void) {
+     return spiErrors;
+ }
+ 
+ /**
+  * @brief Entrega una transferencia SPI al panel conectado, con el byte de control que indica el pin D/C.
+  */
+ static void HAL_Stub_SpiWrite(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size) {
+ 
+     if (hspi->stubCsPort == NULL || (hspi->stubCsPort->ODR & hspi->stubCsPin) != 0) {
+         spiErrors++;
+         return;
+     }
+ 
+     uint8_t control = (hspi->stubDcPort->ODR & hspi->stubDcPin) ? 0x40 : 0x00;
+     SSD1306_Emu_Write(hspi->stubAddress, control, pData, Size);
+ }
+ 
+ /**
+  * @brief Deja pendiente el aviso de fin de una transferencia DMA y, si no está diferido, lo despacha.
+  */
+ static void HAL_Stub_Queue(I2C_HandleTypeDef *hi2c, SPI_HandleTypeDef *hspi) {
+ 
+     if (pendingCount < STUB_MAX_PENDING) {
+         pending[pendingCount].hi2c = hi2c;
+         pending[pendingCount].hspi = hspi;
+         pendingCount++;
+     }
+ 
+     if (!deferred && !running) HAL_Stub_Run();
+ }
@@ -0,0 +1,39 @@
+/**
+ * @file HAL_Stub.h
+ * @brief Control de la HAL simulada (tiempo, transferencias DMA y conexión de paneles SPI).
+ *
+ */
+
+ #ifndef TOOLS_HOST_HAL_STUB_H_
+ #define TOOLS_HOST_HAL_STUB_H_
+ 
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include "stm32f4xx_hal.h"
+ 
+ /**
+  * @brief Conecta un panel del emulador a un bus SPI con sus pines D/C y CS.
+  */
+ void HAL_Stub_SpiAttach(SPI_HandleTypeDef* hspi, uint8_t address, GPIO_TypeDef* dcPort, uint16_t dcPin, GPIO_TypeDef* csPort, uint16_t csPin);
+ 
+ /**
+  * @brief Completa las transferencias DMA en curso hasta que no queda ninguna.
+  */
+ void HAL_Stub_Run(void);
+ 
+ /**
+  * @brief Selecciona si las transferencias DMA se completan en el momento o desde HAL_Stub_Run().
+  */
+ void HAL_Stub_SetDeferred(bool enable);
+ 
+ /**
+  * @brief Avanza el tiempo simulado que devuelve HAL_GetTick().
+  */
+ void HAL_Stub_Advance(uint32_t ms);
+ 
+ /**
+  * @brief Devuelve la cantidad de transferencias SPI hechas con CS en alto (debe ser 0).
+  */
+ uint32_t HAL_Stub_SpiErrors(void);
+ 
+ #endif /* TOOLS_HOST_HAL_STUB_H_ */
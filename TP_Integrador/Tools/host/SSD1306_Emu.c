@@ -0,0 +1,402 @@
+/**
+ * @file SSD1306_Emu.c
+ * @brief Emulador del controlador SSD1306 para ejecutar el driver en una PC.
+ *
+ * Emula dos paneles en el mismo bus (0x3C y 0x3D) e implementa el subconjunto de
+ * comandos que usa el driver y los que afectan a la imagen: modos de direccionamiento,
+ * ventanas de columna/página, punteros del modo por páginas, scroll de contenido,
+ * contraste, inversión, línea de inicio, multiplexado y encendido. Los comandos de configuración del panel (multiplexado, reloj, bomba
+ * de carga, etc.) se aceptan con sus argumentos y no modifican la imagen.
+ *
+ */
+
+ #include "SSD1306_Emu.h"
+ #include <stdio.h>
+ #include <string.h>
+ 
+ /// @brief Cantidad máxima de argumentos de un comando (2Ch/2Dh).
+ #define EMU_MAX_ARGS        7
+ 
+ /// @brief Bits de una transacción sin contar los bytes de control y datos: START, dirección + ACK, STOP.
+ #define EMU_FRAME_BITS      (1 + 9 + 1)
+ 
+ /// @brief Bits por byte en el bus (8 de datos + ACK).
+ #define EMU_BYTE_BITS       9
+ 
+ /**
+  * @brief Panel emulado: estado visible y comando en curso.
+  *
+  * Un comando puede partirse entre transacciones, por lo que sus argumentos
+  * pendientes se guardan con el panel.
+  */
+ typedef struct {
+     SSD1306_EmuState_t state;
+     uint8_t pendingCommand;
+     uint8_t pendingArgs[EMU_MAX_ARGS];
+     uint8_t pendingCount;
+     uint8_t pendingNeeded;
+ } SSD1306_EmuPanel_t;
+ 
+ static SSD1306_EmuPanel_t panels[SSD1306_EMU_PANELS];
+ static SSD1306_EmuStats_t stats;
+ static uint64_t busBits;
+ 
+ /// @brief Panel de la transacción en curso y dirección de la transacción anterior.
+ static SSD1306_EmuPanel_t* panel;
+ static uint8_t lastAddress;
+ 
+ static SSD1306_EmuPanel_t* SSD1306_Emu_Panel(uint8_t address);
+ 
+ static uint8_t SSD1306_Emu_ArgCount(uint8_t command);
+ static void SSD1306_Emu_Command(uint8_t byte);
+ static void SSD1306_Emu_Execute(uint8_t command, const uint8_t* args);
+ static void SSD1306_Emu_Data(uint8_t byte);
+ static void SSD1306_Emu_ContentScroll(bool left, const uint8_t* args);
+ 
+ /**
+  * @brief Lleva los paneles emulados al estado de reset y borra los contadores.
+  *
+  * @note Como el panel real, la GDDRAM queda con contenido indefinido; aquí se usa
+  *       un patrón alternado para detectar regiones que el driver nunca escribe.
+  */
+ void SSD1306_Emu_Reset(void) {
+ 
+     memset(panels, 0, sizeof(panels));
+ 
+     for (uint8_t i = 0; i < SSD1306_EMU_PANELS; i++) {
+ 
+         SSD1306_EmuState_t* reset = &panels[i].state;
+ 
+         for (uint8_t page = 0; page < SSD1306_EMU_PAGES; page++) {
+             memset(reset->gddram[page], (page & 1) ? 0xAA : 0x55, SSD1306_EMU_WIDTH);
+         }
+ 
+         reset->addressingMode = 2;
+         reset->colEnd = SSD1306_EMU_WIDTH - 1;
+         reset->pageEnd = SSD1306_EMU_PAGES - 1;
+         reset->contrast = 0x7F;
+         reset->multiplex = SSD1306_EMU_HEIGHT - 1;
+     }
+ 
+     lastAddress = 0;
+     SSD1306_Emu_ResetStats();
+ }
+ 
+ /**
+  * @brief Procesa una transacción I2C.
+  *
+  * @param address Dirección de 7 bits; las que no corresponden a un panel no reciben ACK.
+  * @param control Byte de control que sigue a la dirección (00h comandos, 40h datos;
+  *        con el bit Co en 1 solo aplica al byte siguiente).
+  * @param data Bytes que siguen al byte de control.
+  * @param size Cantidad de bytes.
+  */
+ void SSD1306_Emu_Write(uint8_t address, uint8_t control, const uint8_t* data, uint16_t size) {
+ 
+     uint16_t i = 0;
+ 
+     panel = SSD1306_Emu_Panel(address);
+     if (panel == NULL) {
+         stats.nacks++;
+         busBits += EMU_FRAME_BITS;
+         return;
+     }
+ 
+     stats.transactions++;
+     stats.bytes += size + 1;
+     busBits += EMU_FRAME_BITS + (uint64_t)EMU_BYTE_BITS * (size + 1);
+ 
+     if (lastAddress != 0 && lastAddress != address) stats.panelSwitches++;
+     lastAddress = address;
+ 
+     while (i < size) {
+ 
+         if (control & 0x40) {
+             SSD1306_Emu_Data(data[i++]);
+         } else {
+             SSD1306_Emu_Command(data[i++]);
+         }
+ 
+         //Co = 1: el byte siguiente es un nuevo byte de control
+         if ((control & 0x80) && i < size) control = data[i++];
+     }
+ }
+ 
+ /**
+  * @brief Devuelve el estado actual de un panel emulado.
+  *
+  * @param address Dirección de 7 bits del panel.
+  * @return Estado del panel, o NULL si la dirección no corresponde a un panel.
+  */
+ const SSD1306_EmuState_t* SSD1306_Emu_GetState(uint8_t address) {
+ 
+     SSD1306_EmuPanel_t* found = SSD1306_Emu_Panel(address);
+ 
+     return (found != NULL) ? &found->state : NULL;
+ }
+ 
+ /**
+  * @brief Busca el panel emulado que responde a una dirección.
+  */
+ static SSD1306_EmuPanel_t* SSD1306_Emu_Panel(uint8_t address) {
+ 
+     if (address < SSD1306_EMU_ADDRESS || address >= SSD1306_EMU_ADDRESS + SSD1306_EMU_PANELS) return NULL;
+     return &panels[address - SSD1306_EMU_ADDRESS];
+ }
+ 
+ /**
+  * @brief Devuelve los contadores de tráfico acumulados.
+  */
+ SSD1306_EmuStats_t SSD1306_Emu_GetStats(void) {
+     return stats;
+ }
+ 
+ /**
+  * @brief Reinicia los contadores de tráfico y de tiempo de bus.
+  */
+ void SSD1306_Emu_ResetStats(void) {
+     memset(&stats, 0, sizeof(stats));
+     busBits = 0;
+ }
+ 
+ /**
+  * @brief Estima el tiempo de bus del tráfico acumulado.
+  *
+  * @param clockHz Frecuencia de SCL (por ejemplo 100000 o 400000).
+  * @return Tiempo en microsegundos: 9 bits por byte (con ACK) más START, dirección y STOP
+  *         por transacción. No incluye los tiempos muertos entre transacciones.
+  */
+ uint32_t SSD1306_Emu_BusTimeUs(uint32_t clockHz) {
+ 
+     if (clockHz == 0) return 0;
+     return (uint32_t)(busBits * 1000000u / clockHz);
+ }
+ 
+ /**
+  * @brief Devuelve un píxel tal como se ve en un panel.
+  *
+  * @param address Dirección de 7 bits del panel.
+  * @param x Columna (0 a 127).
+  * @param y Fila (0 a la cantidad de filas del multiplexado menos 1).
+  * @return true si el píxel está encendido.
+  *
+  * @note Se aplican encendido, A5h, inversión, línea de inicio y multiplexado (A8h).
+  *       Las inversiones de segmento y de barrido COM no se aplican: la imagen queda en
+  *       coordenadas de GDDRAM, que con la inicialización del driver coincide con la
+  *       orientación de lectura.
+  */
+ bool SSD1306_Emu_GetPixel(uint8_t address, uint8_t x, uint8_t y) {
+ 
+     const SSD1306_EmuState_t* view = SSD1306_Emu_GetState(address);
+     uint8_t row;
+     bool lit;
+ 
+     if (view == NULL) return false;
+     if (x >= SSD1306_EMU_WIDTH || y > view->multiplex) return false;
+     if (!view->displayOn) return false;
+     if (view->entireOn) return true;
+ 
+     row = (y + view->startLine) % SSD1306_EMU_HEIGHT;
+     lit = (view->gddram[row / 8][x] >> (row % 8)) & 1;
+ 
+     return lit != view->inverted;
+ }
+ 
+ /**
+  * @brief Guarda la imagen visible de un panel en un archivo PBM binario (P4).
+  *
+  * @param address Dirección de 7 bits del panel.
+  * @param path Ruta del archivo.
+  * @return true si se pudo escribir. La altura de la imagen es la del multiplexado
+  *         configurado; los píxeles encendidos se guardan como negro (1).
+  */
+ bool SSD1306_Emu_SavePBM(uint8_t address, const char* path) {
+ 
+     const SSD1306_EmuState_t* view = SSD1306_Emu_GetState(address);
+     FILE* file;
+ 
+     if (view == NULL) return false;
+ 
+     file = fopen(path, "wb");
+     if (file == NULL) return false;
+ 
+     fprintf(file, "P4\n%d %d\n", SSD1306_EMU_WIDTH, view->multiplex + 1);
+ 
+     for (uint8_t y = 0; y <= view->multiplex; y++) {
+         for (uint8_t x = 0; x < SSD1306_EMU_WIDTH; x += 8) {
+             uint8_t packed = 0;
+             for (uint8_t bit = 0; bit < 8; bit++) {
+                 if (SSD1306_Emu_GetPixel(address, x + bit, y)) packed |= 0x80 >> bit;
+             }
+             fputc(packed, file);
+         }
+     }
+ 
+     return fclose(file) == 0;
+ }
+ 
+ /**
+  * @brief Cantidad de bytes de argumento que sigue a cada comando.
+  */
+ static uint8_t SSD1306_Emu_ArgCount(uint8_t command) {
+ 
+     switch (command) {
+     case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+     case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+         return 1;
+     case 0x21: case 0x22: case 0xA3:
+         return 2;
+     case 0x29: case 0x2A:
+         return 5;
+     case 0x26: case 0x27:
+         return 6;
+     case 0x2C: case 0x2D:
+         return 7;
+     default:
+         return 0;
+     }
+ }
+ 
+ /**
+  * @brief Agrega un byte al comando en curso y lo ejecuta cuando está completo.
+  */
+ static void SSD1306_Emu_Command(uint8_t byte) {
+ 
+     stats.commandBytes++;
+ 
+     if (panel->pendingNeeded > 0) {
+         panel->pendingArgs[panel->pendingCount++] = byte;
+         if (panel->pendingCount == panel->pendingNeeded) {
+             panel->pendingNeeded = 0;
+             SSD1306_Emu_Execute(panel->pendingCommand, panel->pendingArgs);
+         }
+         return;
+     }
+ 
+     panel->pendingNeeded = SSD1306_Emu_ArgCount(byte);
+     if (panel->pendingNeeded > 0) {
+         panel->pendingCommand = byte;
+         panel->pendingCount = 0;
+         return;
+     }
+ 
+     SSD1306_Emu_Execute(byte, NULL);
+ }
+ 
+ /**
+  * @brief Ejecuta un comando completo.
+  */
+ static void SSD1306_Emu_Execute(uint8_t command, const uint8_t* args) {
+ 
+     if (command <= 0x0F) {
+         panel->state.pageModeColumn = (panel->state.pageModeColumn & 0xF0) | command;
+         if (panel->state.addressingMode == 2) panel->state.column = panel->state.pageModeColumn;
+         return;
+     }
+     if (command <= 0x1F) {
+         panel->state.pageModeColumn = ((command & 0x07) << 4) | (panel->state.pageModeColumn & 0x0F);
+         if (panel->state.addressingMode == 2) panel->state.column = panel->state.pageModeColumn;
+         return;
+     }
+     if (command >= 0x40 && command <= 0x7F) {
+         panel->state.startLine = command & 0x3F;
+         return;
+     }
+     if (command >= 0xB0 && command <= 0xB7) {
+         if (panel->state.addressingMode == 2) panel->state.page = command & 0x07;
+         return;
+     }
+ 
+     switch (command) {
+     case 0x20:
+         if ((args[0] & 0x03) != 0x03) panel->state.addressingMode = args[0] & 0x03;
+         break;
+     case 0x21:
+         panel->state.colStart = args[0] & 0x7F;
+         panel->state.colEnd = args[1] & 0x7F;
+         panel->state.column = panel->state.colStart;
+         break;
+     case 0x22:
+         panel->state.pageStart = args[0] & 0x07;
+         panel->state.pageEnd = args[1] & 0x07;
+         panel->state.page = panel->state.pageStart;
+         break;
+     case 0x2C:
+     case 0x2D:
+         SSD1306_Emu_ContentScroll(command == 0x2D, args);
+         break;
+     case 0x2E: panel->state.scrollActive = false; break;
+     case 0x2F: panel->state.scrollActive = true; break;
+     case 0x81: panel->state.contrast = args[0]; break;
+     case 0xA4: panel->state.entireOn = false; break;
+     case 0xA5: panel->state.entireOn = true; break;
+     case 0xA6: panel->state.inverted = false; break;
+     case 0xA7: panel->state.inverted = true; break;
+     case 0xAE: panel->state.displayOn = false; break;
+     case 0xAF: panel->state.displayOn = true; break;
+     case 0xA8: panel->state.multiplex = args[0] & 0x3F; break;
+     case 0x26: case 0x27: case 0x29: case 0x2A: case 0xA3:
+     case 0x8D: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+     case 0xA0: case 0xA1: case 0xC0: case 0xC8: case 0xE3:
+         break;
+     default:
+         stats.unknownCommands++;
+         break;
+     }
+ }
+ 
+ /**
+  * @brief Escribe un byte en la GDDRAM y avanza los punteros según el modo.
+  */
+ static void SSD1306_Emu_Data(uint8_t byte) {
+ 
+     stats.dataBytes++;
+     panel->state.gddram[panel->state.page][panel->state.column] = byte;
+ 
+     switch (panel->state.addressingMode) {
+     case 0:
+         if (panel->state.column++ >= panel->state.colEnd) {
+             panel->state.column = panel->state.colStart;
+             if (panel->state.page++ >= panel->state.pageEnd) panel->state.page = panel->state.pageStart;
+         }
+         break;
+     case 1:
+         if (panel->state.page++ >= panel->state.pageEnd) {
+             panel->state.page = panel->state.pageStart;
+             if (panel->state.column++ >= panel->state.colEnd) panel->state.column = panel->state.colStart;
+         }
+         break;
+     default:
+         if (panel->state.column++ >= SSD1306_EMU_WIDTH - 1) panel->state.column = panel->state.pageModeColumn;
+         break;
+     }
+ }
+ 
+ /**
+  * @brief Desplaza una columna el rectángulo indicado por un comando 2Ch/2Dh.
+  *
+  * @note La columna que sale por un borde entra por el otro.
+  */
+ static void SSD1306_Emu_ContentScroll(bool left, const uint8_t* args) {
+ 
+     uint8_t pageStart = args[1] & 0x07;
+     uint8_t pageEnd = args[3] & 0x07;
+     uint8_t colStart = args[5] & 0x7F;
+     uint8_t colEnd = args[6] & 0x7F;
+ 
+     if (pageStart > pageEnd || colStart >= colEnd) return;
+ 
+     for (uint8_t page = pageStart; page <= pageEnd; page++) {
+         uint8_t* row = &panel->state.gddram[page][colStart];
+         uint8_t width = colEnd - colStart + 1;
+         if (left) {
+             uint8_t first = row[0];
+             memmove(row, row + 1, width - 1);
+             row[width - 1] = first;
+         } else {
+             uint8_t last = row[width - 1];
+             memmove(row + 1, row, width - 1);
+             row[0] = last;
+         }
+     }
+ }
@@ -0,0 +1,70 @@
+/**
+ * @file SSD1306_Emu.h
+ * @brief Emulador del controlador SSD1306 para ejecutar el driver en una PC.
+ *
+ * Decodifica el flujo de bytes I2C (byte de control, comandos y datos) sobre un
+ * modelo de la GDDRAM de 128x64 de cada panel del bus, lleva la cuenta de bytes y transacciones y
+ * estima el tiempo de bus a una frecuencia de reloj I2C dada.
+ *
+ */
+
+ #ifndef TOOLS_HOST_SSD1306_EMU_H_
+ #define TOOLS_HOST_SSD1306_EMU_H_
+ 
+ #include <stdint.h>
+ #include <stdbool.h>
+ 
+ /// @brief Dimensiones de la GDDRAM emulada.
+ #define SSD1306_EMU_WIDTH       128
+ #define SSD1306_EMU_PAGES       8
+ #define SSD1306_EMU_HEIGHT      (SSD1306_EMU_PAGES * 8)
+ 
+ /// @brief Paneles emulados en el bus y dirección de 7 bits del primero (los siguientes, consecutivas).
+ #define SSD1306_EMU_PANELS      2
+ #define SSD1306_EMU_ADDRESS     0x3C
+ 
+ /**
+  * @brief Contadores de tráfico del bus emulado.
+  */
+ typedef struct {
+     uint32_t transactions;      /**< Transacciones I2C (START ... STOP). */
+     uint32_t bytes;             /**< Bytes de control, comando y datos (sin la dirección). */
+     uint32_t commandBytes;      /**< Bytes de comando recibidos. */
+     uint32_t dataBytes;         /**< Bytes escritos en la GDDRAM. */
+     uint32_t unknownCommands;   /**< Comandos no reconocidos por el emulador. */
+     uint32_t nacks;             /**< Transacciones a direcciones sin panel. */
+     uint32_t panelSwitches;     /**< Transacciones dirigidas a un panel distinto del de la anterior. */
+ } SSD1306_EmuStats_t;
+ 
+ /**
+  * @brief Estado visible de un panel emulado.
+  */
+ typedef struct {
+     uint8_t gddram[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH];   /**< Contenido de la GDDRAM. */
+     uint8_t addressingMode;     /**< 0 horizontal, 1 vertical, 2 por páginas. */
+     uint8_t column;             /**< Puntero de columna. */
+     uint8_t page;               /**< Puntero de página. */
+     uint8_t colStart;           /**< Ventana de columnas (modos horizontal y vertical). */
+     uint8_t colEnd;
+     uint8_t pageStart;          /**< Ventana de páginas (modos horizontal y vertical). */
+     uint8_t pageEnd;
+     uint8_t pageModeColumn;     /**< Columna inicial en modo por páginas (00h-1Fh). */
+     uint8_t contrast;           /**< Valor de contraste (81h). */
+     uint8_t startLine;          /**< Línea de inicio de la pantalla (40h-7Fh). */
+     uint8_t multiplex;          /**< Filas activas menos 1 (A8h). */
+     bool displayOn;             /**< AEh/AFh. */
+     bool inverted;              /**< A6h/A7h. */
+     bool entireOn;              /**< A4h/A5h. */
+     bool scrollActive;          /**< 2Eh/2Fh (el scroll continuo no se anima). */
+ } SSD1306_EmuState_t;
+ 
+ void SSD1306_Emu_Reset(void);
+ void SSD1306_Emu_Write(uint8_t address, uint8_t control, const uint8_t* data, uint16_t size);
+ const SSD1306_EmuState_t* SSD1306_Emu_GetState(uint8_t address);
+ SSD1306_EmuStats_t SSD1306_Emu_GetStats(void);
+ void SSD1306_Emu_ResetStats(void);
+ uint32_t SSD1306_Emu_BusTimeUs(uint32_t clockHz);
+ bool SSD1306_Emu_GetPixel(uint8_t address, uint8_t x, uint8_t y);
+ bool SSD1306_Emu_SavePBM(uint8_t address, const char* path);
+ 
+ #endif /* TOOLS_HOST_SSD1306_EMU_H_ */
@@ -0,0 +1,46 @@
+/**
+ * @file stm32f4xx.h
+ * @brief Registros mínimos del dispositivo para compilar los módulos de Drivers/API en una PC.
+ *
+ * Reemplaza al header CMSIS del STM32F4 cuando Tools/host/hal está primero en el
+ * camino de inclusión: el contador de ciclos del DWT (API_cycles.h), la frecuencia
+ * del núcleo y la instancia de UART4 que compara el driver TF-LC02. Las variables
+ * y HAL_Stub_Dwt(), que devuelve el DWT con el contador de ciclos al día, las define
+ * la HAL simulada de cada herramienta.
+ *
+ */
+
+ #ifndef TOOLS_HOST_HAL_STM32F4XX_H_
+ #define TOOLS_HOST_HAL_STM32F4XX_H_
+ 
+ #include <stdint.h>
+ 
+ typedef struct {
+     volatile uint32_t CTRL;
+     volatile uint32_t CYCCNT;
+ } DWT_Type;
+ 
+ typedef struct {
+     volatile uint32_t DEMCR;
+ } CoreDebug_Type;
+ 
+ /**
+  * @brief UART: solo se modela la identidad de la instancia.
+  */
+ typedef struct {
+     volatile uint32_t SR;
+ } USART_TypeDef;
+ 
+ DWT_Type* HAL_Stub_Dwt(void);
+ extern CoreDebug_Type HAL_Stub_CoreDebug;
+ extern USART_TypeDef HAL_Stub_UART4;
+ extern uint32_t SystemCoreClock;
+ 
+ #define DWT                             (HAL_Stub_Dwt())
+ #define CoreDebug                       (&HAL_Stub_CoreDebug)
+ #define UART4                           (&HAL_Stub_UART4)
+ 
+ #define DWT_CTRL_CYCCNTENA_Msk          0x00000001U
+ #define CoreDebug_DEMCR_TRCENA_Msk      0x01000000U
+ 
+ #endif /* TOOLS_HOST_HAL_STM32F4XX_H_ */
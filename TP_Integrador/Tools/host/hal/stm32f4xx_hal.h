@@ -0,0 +1,147 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief HAL mínima para compilar el driver SSD1306 y su capa de puerto en una PC.
+ *
+ * Reemplaza al header de la HAL de STM32 cuando Tools/host/hal está primero en el
+ * camino de inclusión. Declara solo los tipos y funciones que usan SSD1306_Port.c,
+ * TF-LC02_Port.c y main.h; la implementación de I2C y SPI (HAL_Stub.c) envía cada
+ * transferencia al emulador y la de UART (Tools/lidar/UART_Stub.c) la recibe de un
+ * sensor simulado.
+ *
+ */
+
+ #ifndef TOOLS_HOST_HAL_STM32F4XX_HAL_H_
+ #define TOOLS_HOST_HAL_STM32F4XX_HAL_H_
+ 
+ #include <stdint.h>
+ #include <stddef.h>
+ #include "stm32f4xx.h"
+ 
+ #define HAL_I2C_MODULE_ENABLED
+ #define HAL_SPI_MODULE_ENABLED
+ #define HAL_UART_MODULE_ENABLED
+ 
+ #define HAL_MAX_DELAY           0xFFFFFFFFU
+ #define I2C_MEMADD_SIZE_8BIT    0x00000001U
+ 
+ typedef enum {
+     HAL_OK = 0x00U,
+     HAL_ERROR = 0x01U,
+     HAL_BUSY = 0x02U,
+     HAL_TIMEOUT = 0x03U
+ } HAL_StatusTypeDef;
+ 
+ /**
+  * @brief Puerto GPIO: solo se modela el registro de salida.
+  */
+ typedef struct {
+     volatile uint32_t ODR;
+ } GPIO_TypeDef;
+ 
+ typedef enum {
+     GPIO_PIN_RESET = 0,
+     GPIO_PIN_SET
+ } GPIO_PinState;
+ 
+ extern GPIO_TypeDef HAL_Stub_GPIOA;
+ extern GPIO_TypeDef HAL_Stub_GPIOB;
+ extern GPIO_TypeDef HAL_Stub_GPIOC;
+ 
+ #define GPIOA                   (&HAL_Stub_GPIOA)
+ #define GPIOB                   (&HAL_Stub_GPIOB)
+ #define GPIOC                   (&HAL_Stub_GPIOC)
+ 
+ #define GPIO_PIN_0              ((uint16_t)0x0001)
+ #define GPIO_PIN_1              ((uint16_t)0x0002)
+ #define GPIO_PIN_2              ((uint16_t)0x0004)
+ #define GPIO_PIN_3              ((uint16_t)0x0008)
+ #define GPIO_PIN_4              ((uint16_t)0x0010)
+ #define GPIO_PIN_5              ((uint16_t)0x0020)
+ #define GPIO_PIN_6              ((uint16_t)0x0040)
+ #define GPIO_PIN_7              ((uint16_t)0x0080)
+ #define GPIO_PIN_8              ((uint16_t)0x0100)
+ #define GPIO_PIN_9              ((uint16_t)0x0200)
+ #define GPIO_PIN_10             ((uint16_t)0x0400)
+ #define GPIO_PIN_11             ((uint16_t)0x0800)
+ #define GPIO_PIN_12             ((uint16_t)0x1000)
+ #define GPIO_PIN_13             ((uint16_t)0x2000)
+ #define GPIO_PIN_14             ((uint16_t)0x4000)
+ #define GPIO_PIN_15             ((uint16_t)0x8000)
+ 
+ typedef struct {
+     uint32_t ClockSpeed;
+ } I2C_InitTypeDef;
+ 
+ /**
+  * @brief Handle I2C: cada dirección del bus se atiende con un panel del emulador.
+  */
+ typedef struct {
+     I2C_InitTypeDef Init;
+ } I2C_HandleTypeDef;
+ 
+ typedef struct {
+     uint32_t BaudRatePrescaler;
+ } SPI_InitTypeDef;
+ 
+ /**
+  * @brief Handle SPI: los campos del stub indican qué panel y qué pines D/C y CS usa.
+  */
+ typedef struct {
+     SPI_InitTypeDef Init;
+     uint8_t stubAddress;        /**< Panel del emulador conectado al bus. */
+     GPIO_TypeDef* stubDcPort;   /**< Puerto del pin D/C. */
+     uint16_t stubDcPin;         /**< Pin D/C. */
+     GPIO_TypeDef* stubCsPort;   /**< Puerto del pin CS. */
+     uint16_t stubCsPin;         /**< Pin CS. */
+ } SPI_HandleTypeDef;
+ 
+ typedef enum {
+     HAL_UART_STATE_RESET = 0x00U,
+     HAL_UART_STATE_READY = 0x20U,
+     HAL_UART_STATE_BUSY_RX = 0x22U
+ } HAL_UART_StateTypeDef;
+ 
+ #define DMA_IT_HT               0x00000008U
+ 
+ /**
+  * @brief Stream DMA: solo se modelan sus interrupciones habilitadas.
+  */
+ typedef struct {
+     uint32_t stubInterrupts;    /**< Interrupciones habilitadas (DMA_IT_*). */
+ } DMA_HandleTypeDef;
+ 
+ #define __HAL_DMA_DISABLE_IT(__HANDLE__, __INTERRUPT__)   ((__HANDLE__)->stubInterrupts &= ~(__INTERRUPT__))
+ 
+ /**
+  * @brief Handle UART: la recepción armada se guarda en los campos del stub.
+  */
+ typedef struct {
+     USART_TypeDef* Instance;
+     volatile HAL_UART_StateTypeDef RxState;
+     DMA_HandleTypeDef* hdmarx;
+ } UART_HandleTypeDef;
+ 
+ uint32_t HAL_GetTick(void);
+ void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+ 
+ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+ HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+ void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+ void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+ 
+ HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+ HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+ void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+ 
+ HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+ HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+ HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+ HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+ HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+ 
+ #endif /* TOOLS_HOST_HAL_STM32F4XX_HAL_H_ */
@@ -0,0 +1,443 @@
+/**
+ * @file ssd1306_host.c
+ * @brief Ejecuta las pantallas del driver SSD1306 sobre el emulador y reporta su costo.
+ *
+ * Se compila con la capa de puerto real (SSD1306_Port.c) sobre la HAL simulada de
+ * Tools/host/hal, con el transporte elegido por SSD1306_TRANSPORT. Para cada paso
+ * imprime transacciones, bytes y tiempo estimado de bus a dos frecuencias del
+ * transporte (100/400 kHz en I2C, 5,25/10 MHz en SPI), y guarda la imagen del panel
+ * en un archivo PBM dentro del directorio indicado (por defecto, el directorio
+ * actual). Se usan dos paneles: uno de 128x64 en 0x3C y otro de 128x32 en 0x3D, en
+ * el mismo bus I2C o en dos buses SPI (uno por pin CS).
+ *
+ * Uso: ssd1306_host [directorio_de_salida]
+ *
+ */
+
+ #include <stdio.h>
+ #include <time.h>
+ #include "../../Drivers/API/Inc/SSD1306.h"
+ #include "../../Drivers/API/Inc/SSD1306_View.h"
+ #include "../../Drivers/API/Inc/SSD1306_Refresh.h"
+ #include "../../Drivers/API/Inc/SSD1306_Gfx.h"
+ #include "../../Drivers/API/Inc/SSD1306_Hud.h"
+ #include "SSD1306_Emu.h"
+ #include "HAL_Stub.h"
+ 
+ static const char* outputDir = ".";
+ 
+ #if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+ static const uint32_t busClocks[2] = {5250000, 10000000};
+ static SPI_HandleTypeDef handle64;
+ static SPI_HandleTypeDef handle32;
+ static SSD1306_Bus_t bus;
+ static SSD1306_Bus_t bus32;
+ #else
+ static const uint32_t busClocks[2] = {100000, 400000};
+ static I2C_HandleTypeDef handle64;
+ static SSD1306_Bus_t bus;
+ #define bus32 bus
+ #endif
+ 
+ static SSD1306_t oled64;
+ static SSD1306_t oled32;
+ static SSD1306_View_t view64;
+ static SSD1306_View_t view32;
+ static SSD1306_Refresh_t refresh;
+ 
+ /// @brief Traza de distancias (mm) de un objeto que se acerca y se aleja del sensor, con ruido de medición.
+ static const uint16_t distanceTrace[] = {
+     1501, 1495, 1490, 1469, 1449, 1430, 1392, 1360, 1314, 1278, 1224, 1169, 1116, 1064, 1006,  941,
+      884,  822,  770,  710,  649,  597,  548,  498,  462,  417,  387,  355,  340,  316,  306,  302,
+      298,  310,  315,  336,  363,  386,  418,  459,  503,  546,  603,  650,  704,  765,  828,  889,
+      946, 1005, 1065, 1122, 1174, 1225, 1273, 1316, 1358, 1392, 1426, 1456, 1476, 1489, 1500, 1500
+ };
+ 
+ /**
+  * @brief Reinicia los contadores del emulador y de los buses.
+  */
+ static void hostResetStats(void) {
+ 
+     SSD1306_Emu_ResetStats();
+     SSD1306_Port_ResetStats(&bus);
+ #if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+     SSD1306_Port_ResetStats(&bus32);
+ #endif
+ }
+ 
+ /**
+  * @brief Tiempo de bus estimado para los contadores de un bus, con el modelo de bits del transporte.
+  */
+ static uint32_t hostBusTimeUs(SSD1306_PortStats_t stats, uint32_t clockHz) {
+ 
+     uint64_t bits = (uint64_t)stats.transactions * SSD1306_PORT_FRAME_BITS + (uint64_t)stats.bytes * SSD1306_PORT_BYTE_BITS;
+     return (uint32_t)(bits * 1000000u / clockHz);
+ }
+ 
+ /**
+  * @brief Imprime el tráfico acumulado del paso, de todos los paneles.
+  */
+ static void hostPrintStats(const char* name) {
+ 
+     SSD1306_EmuStats_t emuStats = SSD1306_Emu_GetStats();
+     SSD1306_PortStats_t stats = SSD1306_Port_GetStats(&bus);
+ 
+ #if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+     SSD1306_PortStats_t stats32 = SSD1306_Port_GetStats(&bus32);
+     stats.transactions += stats32.transactions;
+     stats.bytes += stats32.bytes;
+ #endif
+ 
+     printf("%-22s %6lu tx %7lu bytes %8lu us @%lukHz %7lu us @%lukHz\n", name,
+            (unsigned long)stats.transactions, (unsigned long)stats.bytes,
+            (unsigned long)hostBusTimeUs(stats, busClocks[0]), (unsigned long)(busClocks[0] / 1000),
+            (unsigned long)hostBusTimeUs(stats, busClocks[1]), (unsigned long)(busClocks[1] / 1000));
+ 
+     if (emuStats.unknownCommands > 0 || emuStats.nacks > 0 || HAL_Stub_SpiErrors() > 0) {
+         printf("%-22s %lu comandos desconocidos, %lu NACK, %lu sin CS\n", "",
+                (unsigned long)emuStats.unknownCommands, (unsigned long)emuStats.nacks,
+                (unsigned long)HAL_Stub_SpiErrors());
+     }
+ }
+ 
+ /**
+  * @brief Guarda la imagen visible de un panel como <name>.pbm.
+  */
+ static void hostSave(const char* name, const SSD1306_t* dev) {
+ 
+     char path[256];
+ 
+     snprintf(path, sizeof(path), "%s/%s.pbm", outputDir, name);
+     if (!SSD1306_Emu_SavePBM(dev->address, path)) {
+         printf("No se pudo escribir %s\n", path);
+     }
+ }
+ 
+ /**
+  * @brief Reporta el tráfico acumulado del paso y guarda la imagen de un panel.
+  */
+ static void hostReport(const char* name, const SSD1306_t* dev) {
+ 
+     hostPrintStats(name);
+     hostSave(name, dev);
+     hostResetStats();
+ }
+ 
+ /**
+  * @brief Envía los cambios pendientes de un panel, reporta el tráfico del paso y guarda la imagen.
+  */
+ static void hostStep(const char* name, SSD1306_t* dev) {
+ 
+     SSD1306_Flush(dev);
+     hostReport(name, dev);
+ }
+ 
+ /**
+  * @brief Reproduce la traza de distancias en una pantalla y compara los bytes planificados con la referencia.
+  */
+ static void hostTrace(const char* name, SSD1306_View_t* view) {
+ 
+     uint16_t max = 0;
+     uint16_t min = 0xFFFF;
+ 
+     SSD1306_Flush(view->dev);
+     SSD1306_ResetFlushStats(view->dev);
+     hostResetStats();
+     fontCacheResetStats();
+ 
+     for (uint8_t i = 0; i < sizeof(distanceTrace) / sizeof(distanceTrace[0]); i++) {
+         uint16_t distance = distanceTrace[i];
+         if (distance > max) max = distance;
+         if (distance < min) min = distance;
+         SSD1306_PushSample(view, distance);
+         SSD1306_PrintMesurement(view, distance, max, min);
+         SSD1306_Flush(view->dev);
+     }
+ 
+     SSD1306_FlushStats_t stats = SSD1306_GetFlushStats(view->dev);
+     printf("%-22s %6lu tramas %4lu ventanas %6lu bytes planificados %6lu ingenuos (%lu%%)\n", name,
+            (unsigned long)stats.frames, (unsigned long)stats.segments,
+            (unsigned long)stats.plannedBytes, (unsigned long)stats.naiveBytes,
+            (unsigned long)(stats.naiveBytes ? stats.plannedBytes * 100u / stats.naiveBytes : 0));
+ 
+     fontCacheStats_t cache = fontCacheGetStats();
+     uint32_t lookups = cache.hits + cache.misses;
+     printf("%-22s %6lu aciertos %4lu fallos %3lu descartes (%lu%% aciertos)\n", name,
+            (unsigned long)cache.hits, (unsigned long)cache.misses, (unsigned long)cache.evictions,
+            (unsigned long)(lookups ? cache.hits * 100u / lookups : 0));
+     hostReport(name, view->dev);
+ }
+ 
+ /**
+  * @brief Compara el dibujo con una fuente comprimida (glifos en el caché) contra la misma fuente sin comprimir.
+  */
+ static void hostFontBenchmark(SSD1306_t* dev) {
+ 
+     static uint8_t rawGlyphs[('9' - '-' + 1) * 10 * 2];
+     font_t raw = FontDigits2x;
+     const uint32_t iterations = 200000;
+     const char* texts[] = {"123.4", "56.7", "890.1"};
+     clock_t start;
+     double packedUs;
+     double rawUs;
+ 
+     for (char c = raw.first; c <= raw.last; c++) {
+         memcpy(&rawGlyphs[(c - raw.first) * raw.width * raw.pages], fontGlyph(&FontDigits2x, c), raw.width * raw.pages);
+     }
+     raw.glyphs = rawGlyphs;
+     raw.packed = NULL;
+ 
+     start = clock();
+     for (uint32_t i = 0; i < iterations; i++) {
+         SSD1306_DrawTextFont(dev, 0, 0, 60, texts[i % 3], &FontDigits2x, SSD1306_ALIGN_RIGHT);
+     }
+     packedUs = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC;
+ 
+     start = clock();
+     for (uint32_t i = 0; i < iterations; i++) {
+         SSD1306_DrawTextFont(dev, 0, 0, 60, texts[i % 3], &raw, SSD1306_ALIGN_RIGHT);
+     }
+     rawUs = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC;
+ 
+     printf("%-22s %8.1f ns comprimida %8.1f ns sin comprimir por texto\n", "font_cache",
+            packedUs * 1000.0 / iterations, rawUs * 1000.0 / iterations);
+ }
+ 
+ /**
+  * @brief Dibuja un mapa de bits con XOR píxel por píxel: referencia del motor de blit.
+  */
+ static void hostBlitReference(uint8_t frame[][SSD1306_WIDTH], const SSD1306_t* dev, int16_t x, int16_t y, const SSD1306_Bitmap_t* bitmap) {
+ 
+     for (int16_t col = 0; col < bitmap->width; col++) {
+         for (int16_t r = 0; r < bitmap->height; r++) {
+             int16_t px = x + col;
+             int16_t py = y + r;
+             if (!(bitmap->data[(r / 8) * bitmap->width + col] & (1u << (r % 8)))) continue;
+             if (px < 0 || py < 0 || px >= dev->width || py >= dev->height) continue;
+             frame[py / 8][px] ^= (uint8_t)(1u << (py % 8));
+         }
+     }
+ }
+ 
+ /**
+  * @brief Mide los píxeles por microsegundo de SSD1306_GfxBlit() contra la referencia píxel por píxel.
+  *
+  * Dibuja los dígitos x3 (15x24 con sus bandas) en posiciones que recorren los 8
+  * desplazamientos verticales y los bordes del panel, con ambos métodos, y verifica
+  * que el framebuffer resultante sea el mismo.
+  */
+ static void hostGfxBenchmark(SSD1306_t* dev) {
+ 
+     static uint8_t reference[SSD1306_PAGES][SSD1306_WIDTH];
+     const font_t* font = &FontDigits3x;
+     const uint32_t iterations = 200000;
+     SSD1306_Bitmap_t glyph = { font->width, font->pages * 8, NULL };
+     double pixels = (double)iterations * glyph.width * glyph.height;
+     clock_t start;
+     double blitUs;
+     double referenceUs;
+ 
+     memcpy(reference, dev->framebuffer, sizeof(reference));
+ 
+     start = clock();
+     for (uint32_t i = 0; i < iterations; i++) {
+         glyph.data = fontGlyph(font, (char)('0' + i % 10));
+         SSD1306_GfxBlit(dev, (int16_t)((i * 7) % 136) - 8, (int16_t)((i * 5) % 80) - 8, &glyph, SSD1306_ROP_XOR);
+     }
+     blitUs = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC;
+ 
+     start = clock();
+     for (uint32_t i = 0; i < iterations; i++) {
+         glyph.data = fontGlyph(font, (char)('0' + i % 10));
+         hostBlitReference(reference, dev, (int16_t)((i * 7) % 136) - 8, (int16_t)((i * 5) % 80) - 8, &glyph);
+     }
+     referenceUs = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC;
+ 
+     printf("%-22s %8.1f px/us blit %8.1f px/us por pixel, framebuffer %s\n", "gfx_blit",
+            pixels / (blitUs > 0 ? blitUs : 1), pixels / (referenceUs > 0 ? referenceUs : 1),
+            memcmp(reference, dev->framebuffer, sizeof(reference)) == 0 ? "igual" : "DISTINTO");
+ }
+ 
+ int main(int argc, char* argv[]) {
+ 
+     if (argc > 1) outputDir = argv[1];
+ 
+     SSD1306_Emu_Reset();
+ 
+ #if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+     HAL_Stub_SpiAttach(&handle64, SSD1306_ADDRESS, GPIOB, GPIO_PIN_1, GPIOB, GPIO_PIN_12);
+     HAL_Stub_SpiAttach(&handle32, SSD1306_ADDRESS_ALT, GPIOB, GPIO_PIN_1, GPIOB, GPIO_PIN_2);
+     SSD1306_Port_BusInit(&bus, &handle64);
+     SSD1306_Port_SetPins(&bus, GPIOB, GPIO_PIN_1, GPIOB, GPIO_PIN_12);
+     SSD1306_Port_BusInit(&bus32, &handle32);
+     SSD1306_Port_SetPins(&bus32, GPIOB, GPIO_PIN_1, GPIOB, GPIO_PIN_2);
+ #else
+     SSD1306_Port_BusInit(&bus, &handle64);
+ #endif
+ 
+     //Panel de 128x64
+     SSD1306_Init(&oled64, &bus, SSD1306_ADDRESS, 128, 64);
+     hostStep("init", &oled64);
+ 
+     //Imagen de arranque con las etiquetas fijas, en lugar del borrado
+     SSD1306_ViewInit(&view64, &oled64);
+     hostStep("splash", &oled64);
+ 
+     SSD1306_PrintSetup(&view64, 0x41, 0x03);
+     SSD1306_PrintMuestreo(&view64, 50);
+     hostStep("setup", &oled64);
+ 
+     SSD1306_PrintMesurement(&view64, 1234, 1234, 1234);
+     hostStep("mesurement_first", &oled64);
+ 
+     SSD1306_PrintMesurement(&view64, 1236, 1236, 1234);
+     hostStep("mesurement_update", &oled64);
+ 
+     SSD1306_PrintMesurement(&view64, 1236, 1236, 1234);
+     hostStep("mesurement_unchanged", &oled64);
+ 
+     SSD1306_PrintMuestreo(&view64, 1000);
+     hostStep("muestreo", &oled64);
+ 
+     SSD1306_SetScreen(&view64, SSD1306_SCREEN_CHART);
+     SSD1306_PrintMuestreo(&view64, 50);
+     hostStep("chart_screen", &oled64);
+ 
+     for (uint16_t i = 0; i < oled64.width; i++) {
+         SSD1306_PushSample(&view64, 1000 + (i % 32) * 20);
+         SSD1306_PrintMesurement(&view64, 1000 + (i % 32) * 20, 0, 0);
+         SSD1306_Flush(&oled64);
+     }
+     hostStep("chart_128_samples", &oled64);
+ 
+     SSD1306_PushSample(&view64, 500);
+     SSD1306_PrintMesurement(&view64, 500, 0, 0);
+     hostStep("chart_sample", &oled64);
+ 
+     //Cinco mediciones entre dos cuadros: el cuadro dibuja las cinco columnas
+     for (uint16_t i = 0; i < 5; i++) {
+         SSD1306_PushSample(&view64, 600 + i * 150);
+     }
+     SSD1306_PrintMesurement(&view64, 1200, 0, 0);
+     hostStep("chart_coalesced", &oled64);
+ 
+     //Un ancho de panel de mediciones en un cuadro: sin scrolls, se envía la diferencia del framebuffer
+     for (uint16_t i = 0; i < oled64.width; i++) {
+         SSD1306_PushSample(&view64, 1000 + (i % 32) * 20);
+     }
+     SSD1306_PrintMesurement(&view64, 1000 + ((oled64.width - 1) % 32) * 20, 0, 0);
+     hostStep("chart_burst", &oled64);
+ 
+     //Cuadro completo: todas las columnas de todas las páginas cambian
+     for (uint8_t x = 0; x < oled64.width; x++) {
+         uint8_t column[SSD1306_PAGES];
+         for (uint8_t page = 0; page < oled64.pages; page++) column[page] = (uint8_t)(0x55 << (x & 1)) ^ page;
+         SSD1306_WriteColumn(&oled64, x, 0, oled64.pages - 1, column);
+     }
+     hostStep("full_frame", &oled64);
+ 
+     //Panel de 128x32 (en el mismo bus si es I2C)
+     SSD1306_Init(&oled32, &bus32, SSD1306_ADDRESS_ALT, 128, 32);
+     SSD1306_ViewInit(&view32, &oled32);
+     hostStep("p32_init_splash", &oled32);
+ 
+     SSD1306_PrintSetup(&view32, 0x41, 0x03);
+     SSD1306_PrintMuestreo(&view32, 50);
+     SSD1306_PrintMesurement(&view32, 1234, 1500, 900);
+     hostStep("p32_measure", &oled32);
+ 
+     //Tramas de ambos paneles en el bus a la vez: se intercalan por transferencia
+     SSD1306_SetScreen(&view64, SSD1306_SCREEN_MEASURE);
+     SSD1306_PrintSetup(&view64, 0x41, 0x03);
+     SSD1306_PrintMuestreo(&view64, 250);
+     SSD1306_Flush(&oled64);
+     hostResetStats();
+ 
+     HAL_Stub_SetDeferred(true);
+     SSD1306_PrintMesurement(&view64, 987, 1500, 900);
+     SSD1306_PrintMesurement(&view32, 987, 1500, 900);
+     SSD1306_Flush(&oled64);
+     SSD1306_Flush(&oled32);
+     HAL_Stub_Run();
+     HAL_Stub_SetDeferred(false);
+ 
+     //Los contadores no distinguen paneles: el tráfico se informa una vez, para ambos
+     hostPrintStats("dual_flush");
+     printf("%-22s %6lu cambios de panel entre transacciones\n", "",
+            (unsigned long)SSD1306_Emu_GetStats().panelSwitches);
+     hostSave("dual_p64", &oled64);
+     hostSave("dual_p32", &oled32);
+     hostResetStats();
+ 
+     //Sensor a 200 muestras/s durante 2 s con el display limitado a 20 cuadros/s
+     SSD1306_RefreshInit(&refresh, &oled64, SSD1306_REFRESH_DEFAULT_FPS, SSD1306_REFRESH_DEFAULT_BUDGET, busClocks[1]);
+     for (uint16_t i = 0; i < 400; i++) {
+         uint16_t distance = 800 + (i % 50) * 10;
+         SSD1306_RefreshRequest(&refresh);
+         if (SSD1306_RefreshDue(&refresh)) {
+             SSD1306_PrintMesurement(&view64, distance, 1300, 800);
+             SSD1306_RefreshFlush(&refresh);
+         }
+         HAL_Stub_Advance(5);
+     }
+     SSD1306_RefreshStats_t refreshStats = SSD1306_RefreshGetStats(&refresh);
+     printf("%-22s %6lu cuadros %5lu agrupadas %3lu postergados %3u%% bus @%lukHz\n", "refresh_200sps",
+            (unsigned long)refreshStats.framesDrawn, (unsigned long)refreshStats.updatesCoalesced,
+            (unsigned long)refreshStats.framesDeferred, refreshStats.busBusyPercent, (unsigned long)(busClocks[1] / 1000));
+     hostReport("refresh_200sps", &oled64);
+ 
+     //Traza de mediciones en cada pantalla: bytes del planificador contra una ventana por página
+     SSD1306_SetScreen(&view64, SSD1306_SCREEN_MEASURE);
+     SSD1306_PrintSetup(&view64, 0x41, 0x03);
+     SSD1306_PrintMuestreo(&view64, 50);
+     hostTrace("trace_measure", &view64);
+ 
+     SSD1306_SetScreen(&view64, SSD1306_SCREEN_CHART);
+     SSD1306_PrintMuestreo(&view64, 50);
+     hostTrace("trace_chart", &view64);
+ 
+     SSD1306_PrintSetup(&view32, 0x41, 0x03);
+     hostTrace("trace_p32", &view32);
+ 
+     //Costo de dibujo con la fuente comprimida cuando sus glifos están en el caché
+     hostFontBenchmark(&oled64);
+ 
+     //Blit en cualquier fila: rendimiento y pantalla de ejemplo con texto, líneas, rectángulos y barra
+     hostGfxBenchmark(&oled64);
+     SSD1306_Clear(&oled64);
+     hostResetStats();
+ 
+     SSD1306_GfxText(&oled64, 3, 3, "y=3 Font5x7", &FontSmall, SSD1306_ROP_COPY);
+     SSD1306_GfxText(&oled64, 2, 14, "12.3", &FontDigits2x, SSD1306_ROP_OR);
+     SSD1306_GfxRect(&oled64, 68, 13, 58, 19, SSD1306_ROP_OR);
+     SSD1306_GfxLine(&oled64, 69, 30, 124, 14, SSD1306_ROP_OR);
+     SSD1306_GfxBar(&oled64, 2, 35, 124, 9, 620, 1000);
+     SSD1306_GfxFillRect(&oled64, 36, 49, 40, 12, SSD1306_ROP_OR);
+     SSD1306_GfxText(&oled64, 40, 51, "XOR y=51", &FontProportional, SSD1306_ROP_XOR);
+     hostStep("gfx_demo", &oled64);
+ 
+     //Pantalla de diagnóstico con métricas sintéticas: al mostrarse, en una actualización
+     //donde solo cambian algunos valores y en la página de estadísticas de las mediciones
+     SSD1306_Hud_t hud;
+     SSD1306_HudMetrics_t metrics = {0};
+ 
+     SSD1306_HudInit(&hud, &oled64);
+     hostResetStats();
+     HAL_Stub_Advance(SSD1306_HUD_PERIOD_MS);
+     metrics = (SSD1306_HudMetrics_t){ 199, 1843, 30, 27, 48210, 2, 1, 5712, 128, 8127, 64, 796, 834, 812, 826, 7 };
+     SSD1306_HudUpdate(&hud, &metrics);
+     SSD1306_HudShow(&hud);
+     hostStep("hud_show", &oled64);
+ 
+     hostResetStats();
+     HAL_Stub_Advance(SSD1306_HUD_PERIOD_MS);
+     metrics = (SSD1306_HudMetrics_t){ 398, 1843, 60, 27, 96430, 2, 1, 5712, 128, 8131, 61, 796, 834, 813, 826, 9 };
+     SSD1306_HudUpdate(&hud, &metrics);
+     hostStep("hud_update", &oled64);
+ 
+     hostResetStats();
+     SSD1306_HudNextPage(&hud);
+     hostStep("hud_stats", &oled64);
+ 
+     return 0;
+ }
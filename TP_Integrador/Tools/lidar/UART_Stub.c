@@ -0,0 +1,215 @@
+/**
+ * @file UART_Stub.c
+ * @brief UART simulada: entrega al driver TF-LC02 los bytes de un sensor simulado.
+ *
+ * Reproduce el comportamiento de HAL en la recepción de UART4: con
+ * HAL_UART_Receive_IT() cada byte genera una interrupción y desarma la recepción
+ * hasta que el driver la vuelve a armar; con HAL_UARTEx_ReceiveToIdle_DMA() en modo
+ * circular los bytes se escriben en el buffer sin interrupciones y se avisa con
+ * HAL_UARTEx_RxEventCallback() al dar la vuelta el buffer, a la mitad (si la
+ * interrupción de medio buffer está habilitada) y al quedar inactiva la línea. Una
+ * transmisión con HAL_UART_Transmit_IT() queda en curso, y la UART ocupada, hasta
+ * que el sensor simulado la da por terminada con UART_Stub_TxDone().
+ *
+ */
+
+ #include "UART_Stub.h"
+ #include <stdbool.h>
+ #include <stdatomic.h>
+ #include <time.h>
+ 
+ GPIO_TypeDef HAL_Stub_GPIOA;
+ GPIO_TypeDef HAL_Stub_GPIOB;
+ GPIO_TypeDef HAL_Stub_GPIOC;
+ CoreDebug_Type HAL_Stub_CoreDebug;
+ USART_TypeDef HAL_Stub_UART4;
+ uint32_t SystemCoreClock = 16000000u;
+ 
+ static DMA_HandleTypeDef hdma_uart4_rx;
+ UART_HandleTypeDef huart4 = { .Instance = UART4, .RxState = HAL_UART_STATE_READY, .hdmarx = &hdma_uart4_rx };
+ 
+ /// @brief Recepción armada por el driver.
+ static uint8_t* rxData;
+ static uint16_t rxSize;
+ static uint16_t rxPos;
+ static bool rxDma;
+ 
+ static uint32_t interrupts;
+ static uint32_t lost;
+ static atomic_uint commands;
+ 
+ /// @brief Transmisión por interrupción en curso (la arma el driver y la termina el sensor).
+ static atomic_bool txBusy;
+ 
+ uint32_t HAL_GetTick(void) {
+ 
+     struct timespec now;
+     clock_gettime(CLOCK_MONOTONIC, &now);
+     return (uint32_t)(now.tv_sec * 1000u + now.tv_nsec / 1000000u);
+ }
+ 
+ /**
+  * @brief Contador de ciclos: el tiempo real en ciclos de SystemCoreClock.
+  *
+  * Cada hilo tiene su propio DWT, por lo que leerlo desde el hilo de la interrupción y
+  * desde el lazo principal no es una carrera.
+  */
+ DWT_Type* HAL_Stub_Dwt(void) {
+ 
+     static _Thread_local DWT_Type dwt;
+     struct timespec now;
+ 
+     clock_gettime(CLOCK_MONOTONIC, &now);
+     dwt.CYCCNT = (uint32_t)((uint64_t)now.tv_sec * SystemCoreClock + (uint64_t)now.tv_nsec * SystemCoreClock / 1000000000u);
+     return &dwt;
+ }
+ 
+ void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+ 
+     if (PinState == GPIO_PIN_SET) GPIOx->ODR |= GPIO_Pin;
+     else GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+ }
+ 
+ HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+ 
+     //Pedido de medición: 55 AA 81 00 FA
+     if (Size == 5 && pData[2] == 0x81) atomic_fetch_add(&commands, 1);
+     return HAL_OK;
+ }
+ 
+ HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+     return HAL_TIMEOUT;
+ }
+ 
+ HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size) {
+ 
+     if (atomic_load(&txBusy)) return HAL_BUSY;
+ 
+     if (Size == 5 && pData[2] == 0x81) atomic_fetch_add(&commands, 1);
+     atomic_store(&txBusy, true);
+     return HAL_OK;
+ }
+ 
+ HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+ 
+     if (huart->RxState != HAL_UART_STATE_READY) return HAL_BUSY;
+ 
+     rxData = pData;
+     rxSize = Size;
+     rxPos = 0;
+     rxDma = false;
+     huart->RxState = HAL_UART_STATE_BUSY_RX;
+     return HAL_OK;
+ }
+ 
+ HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+ 
+     if (huart->RxState != HAL_UART_STATE_READY) return HAL_BUSY;
+ 
+     rxData = pData;
+     rxSize = Size;
+     rxPos = 0;
+     rxDma = true;
+     huart->hdmarx->stubInterrupts = DMA_IT_HT;
+     huart->RxState = HAL_UART_STATE_BUSY_RX;
+     return HAL_OK;
+ }
+ 
+ /**
+  * @brief Recibe bytes por la línea y genera las interrupciones correspondientes.
+  */
+ void UART_Stub_Receive(const uint8_t* data, uint16_t size) {
+ 
+     for (uint16_t i = 0; i < size; i++) {
+ 
+         if (huart4.RxState != HAL_UART_STATE_BUSY_RX) {
+             lost++;
+             continue;
+         }
+ 
+         rxData[rxPos++] = data[i];
+ 
+         if (!rxDma) {
+             //Recepción por interrupción: el driver rearma desde el callback
+             if (rxPos == rxSize) {
+                 huart4.RxState = HAL_UART_STATE_READY;
+                 interrupts++;
+                 HAL_UART_RxCpltCallback(&huart4);
+             }
+         } else if (rxPos == rxSize) {
+             //DMA circular: al dar la vuelta se avisa con el buffer completo
+             rxPos = 0;
+             interrupts++;
+             HAL_UARTEx_RxEventCallback(&huart4, rxSize);
+         } else if (rxPos == rxSize / 2 && (huart4.hdmarx->stubInterrupts & DMA_IT_HT)) {
+             interrupts++;
+             HAL_UARTEx_RxEventCallback(&huart4, rxSize / 2);
+         }
+     }
+ 
+     //Línea inactiva: HAL avisa solo si hay datos desde la última vuelta del buffer
+     if (rxDma && huart4.RxState == HAL_UART_STATE_BUSY_RX && rxPos > 0) {
+         interrupts++;
+         HAL_UARTEx_RxEventCallback(&huart4, rxPos);
+     }
+ }
+ 
+ /**
+  * @brief Reinicia el periférico: no queda ninguna recepción armada.
+  */
+ void UART_Stub_Reset(void) {
+ 
+     atomic_store(&txBusy, false);
+     huart4.RxState = HAL_UART_STATE_READY;
+     rxData = NULL;
+     rxPos = 0;
+ }
+ 
+ /**
+  * @brief Simula un desborde del periférico: HAL aborta la recepción y avisa el error.
+  */
+ void UART_Stub_Overrun(void) {
+ 
+     huart4.RxState = HAL_UART_STATE_READY;
+     interrupts++;
+     HAL_UART_ErrorCallback(&huart4);
+ }
+ 
+ /**
+  * @brief Indica si hay una transmisión por interrupción en curso.
+  */
+ bool UART_Stub_TxPending(void) {
+     return atomic_load(&txBusy);
+ }
+ 
+ /**
+  * @brief Termina la transmisión en curso y llama al callback de fin de transmisión.
+  */
+ void UART_Stub_TxDone(void) {
+ 
+     if (!atomic_load(&txBusy)) return;
+ 
+     atomic_store(&txBusy, false);
+     HAL_UART_TxCpltCallback(&huart4);
+ }
+ 
+ /**
+  * @brief Devuelve los pedidos de medición transmitidos por el driver desde el arranque.
+  */
+ uint32_t UART_Stub_Commands(void) {
+     return atomic_load(&commands);
+ }
+ 
+ /**
+  * @brief Devuelve las interrupciones de recepción generadas (UART y DMA).
+  */
+ uint32_t UART_Stub_Interrupts(void) {
+     return interrupts;
+ }
+ 
+ /**
+  * @brief Devuelve los bytes que llegaron sin una recepción armada y se perdieron.
+  */
+ uint32_t UART_Stub_Lost(void) {
+     return lost;
+ }
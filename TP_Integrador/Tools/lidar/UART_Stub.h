@@ -0,0 +1,69 @@
+/**
+ * @file UART_Stub.h
+ * @brief UART simulada para ejecutar el driver TF-LC02 en una PC.
+ *
+ * Hace las veces de la línea serie y del hardware de recepción: los bytes que entrega
+ * UART_Stub_Receive() se escriben en el buffer armado por el driver (byte por byte
+ * por interrupción o en el buffer circular del DMA) y se llama a los mismos
+ * callbacks de HAL que en la placa, con la línea inactiva al final de cada llamada.
+ * Se llama desde el hilo que representa a la interrupción. HAL_GetTick() devuelve
+ * milisegundos reales desde el arranque, el contador de ciclos del DWT avanza con el
+ * tiempo real y los pedidos de medición transmitidos se cuentan, para que el sensor
+ * simulado pueda responderlos. Las transmisiones por interrupción terminan cuando el
+ * sensor llama a UART_Stub_TxDone().
+ *
+ */
+
+ #ifndef TOOLS_LIDAR_UART_STUB_H_
+ #define TOOLS_LIDAR_UART_STUB_H_
+ 
+ #include <stdint.h>
+ #include <stdbool.h>
+ #include "stm32f4xx_hal.h"
+ 
+ /**
+  * @brief Recibe bytes por la línea y genera las interrupciones correspondientes.
+  *
+  * @param data Bytes que envía el sensor.
+  * @param size Cantidad de bytes; al final la línea queda inactiva.
+  */
+ void UART_Stub_Receive(const uint8_t* data, uint16_t size);
+ 
+ /**
+  * @brief Reinicia el periférico: no queda ninguna recepción armada.
+  */
+ void UART_Stub_Reset(void);
+ 
+ /**
+  * @brief Simula un desborde del periférico: HAL aborta la recepción y avisa el error.
+  */
+ void UART_Stub_Overrun(void);
+ 
+ /**
+  * @brief Indica si hay una transmisión por interrupción en curso.
+  */
+ bool UART_Stub_TxPending(void);
+ 
+ /**
+  * @brief Termina la transmisión en curso y llama al callback de fin de transmisión.
+  *
+  * @note Se llama desde el hilo que representa a la interrupción.
+  */
+ void UART_Stub_TxDone(void);
+ 
+ /**
+  * @brief Devuelve los pedidos de medición transmitidos por el driver desde el arranque.
+  */
+ uint32_t UART_Stub_Commands(void);
+ 
+ /**
+  * @brief Devuelve las interrupciones de recepción generadas (UART y DMA).
+  */
+ uint32_t UART_Stub_Interrupts(void);
+ 
+ /**
+  * @brief Devuelve los bytes que llegaron sin una recepción armada y se perdieron.
+  */
+ uint32_t UART_Stub_Lost(void);
+ 
+ #endif /* TOOLS_LIDAR_UART_STUB_H_ */
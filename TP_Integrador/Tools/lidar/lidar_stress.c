@@ -0,0 +1,538 @@
+/**
+ * @file lidar_stress.c
+ * @brief Prueba de carga del paso de bytes entre la interrupción UART y el parser del TF-LC02.
+ *
+ * Se compila con TF-LC02.c, su capa de puerto y API_ring.c sobre la UART simulada de
+ * UART_Stub.c. Un hilo hace de sensor e interrupción: genera tramas de medición con
+ * distancias crecientes (que incluyen bytes iguales al fin de trama, 0xFA) y las
+ * entrega a la UART simulada, que llama a los callbacks del driver. El hilo principal
+ * hace de lazo principal: extrae tramas con TFLC02_FramePresent(), las procesa y
+ * verifica que cada distancia aceptada haya sido enviada y sea mayor que la anterior
+ * (sin tramas repetidas, reordenadas ni mezcladas).
+ *
+ * - ritmo: el sensor espera mientras haya TRAMAS_EN_VUELO tramas sin procesar. No debe
+ *   haber desbordes ni tramas perdidas, con varias tramas esperando a la vez.
+ * - rafaga: el lazo principal queda bloqueado (como durante un envío largo al display)
+ *   mientras el sensor envía RAFAGA tramas, el doble de las que entran en el buffer.
+ *   Debe haber desbordes, cada trama perdida debe explicarse por bytes descartados y
+ *   ninguna distancia aceptada puede ser incorrecta.
+ * - ruido: como ritmo, pero antes de algunas tramas llegan bytes de ruido (con
+ *   cabeceras y fines de trama sueltos) o el comienzo de la misma trama, y algunas
+ *   tramas se cortan. Se deben recuperar todas las tramas completas y perder solo las
+ *   cortadas.
+ * - continuo: el pedido de medición, que el driver envía por interrupción desde su cola
+ *   de transmisión, termina después del tiempo que ocupa en la UART a 115200 bps; el
+ *   sensor lo responde después del tiempo que ocupa la respuesta, no responde el 2%
+ *   de los pedidos y responde el 1% con un código de error, que no cuenta como medición. El driver en modo continuo (TFLC02_FreeRunStart()) pide cada
+ *   medición apenas llega la anterior; se informan las muestras por segundo logradas,
+ *   los timeouts, los reintentos y la ocupación de la cola de transmisión, y se
+ *   verifica que cada comando enviado se avise una vez al callback de transmisión.
+ *   Las mediciones se leen de a lotes con TFLC02_ReadSamples(): ninguna debe perderse
+ *   y la latencia de cada una debe cubrir al menos el tiempo de la respuesta.
+ * - sin pausa: SIN_PAUSA tramas llegan seguidas, sin que la línea quede inactiva, por lo
+ *   que con DMA el buffer de recepción se completa con la lectura en su comienzo. Deben
+ *   aceptarse todas.
+ *
+ * El modo de recepción se elige al compilar con TFLC02_USE_RX_DMA. Devuelve 0 si se
+ * cumplen todas las verificaciones.
+ *
+ * Uso: lidar_stress [tramas]
+ *
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdatomic.h>
+ #include <pthread.h>
+ #include <sched.h>
+ #include <time.h>
+ #include "../../Drivers/API/Inc/TF-LC02.h"
+ #include "UART_Stub.h"
+ 
+ /// @brief Tramas sin procesar como máximo en los escenarios con ritmo (64 bytes de 128).
+ #define TRAMAS_EN_VUELO     8
+ 
+ /// @brief Tramas sin procesar como máximo con ruido (el ruido también ocupa el buffer).
+ #define TRAMAS_EN_VUELO_RUIDO   4
+ 
+ /// @brief Tramas seguidas del escenario de ráfagas (256 bytes: el doble del buffer).
+ #define RAFAGA              32
+ 
+ /// @brief Bytes de ruido como máximo antes de una trama.
+ #define RUIDO_MAX           12
+ 
+ /// @brief Esperas del sensor como máximo antes de enviar aunque haya tramas sin procesar.
+ #define ESPERA_MAX          100000
+ 
+ /// @brief Cada cuántas tramas se simula un desborde del periférico.
+ #define PERIODO_DESBORDE    10007
+ 
+ /// @brief Pedido (5 bytes) en la UART a 115200 bps, 10 bits por byte (us).
+ #define PEDIDO_US           434
+ 
+ /// @brief Respuesta (8 bytes) en la UART a 115200 bps (us).
+ #define RESPUESTA_US        694
+ 
+ /// @brief Mediciones leídas como máximo en cada vuelta del escenario continuo.
+ #define LOTE                8
+ 
+ /// @brief Pedidos sin respuesta del sensor simulado en modo continuo (%).
+ #define SIN_RESPUESTA_PCT   2
+ 
+ /// @brief Respuestas con código de error del sensor simulado en modo continuo (%).
+ #define CON_ERROR_PCT       1
+ 
+ /// @brief Tramas seguidas sin línea inactiva (96 bytes: más que el buffer del DMA, de 64).
+ #define SIN_PAUSA           12
+ 
+ /// @brief Duración del escenario continuo (ms).
+ #define DURACION_MS         2000
+ 
+ /// @brief Distancias distintas antes de que la secuencia vuelva a empezar.
+ #define DISTANCIAS          65536
+ 
+ /**
+  * @brief Escenarios de la prueba.
+  */
+ typedef enum {
+     ESCENARIO_RITMO,
+     ESCENARIO_RAFAGA,
+     ESCENARIO_RUIDO
+ } escenario_t;
+ 
+ extern bool TFLC02_Parse_Packet(void);
+ 
+ static uint32_t tramas = 200000;
+ static escenario_t actual;
+ static uint8_t* marcas;             /**< Por trama: bit 0 con ruido antes, bit 1 cortada, bit 2 aceptada. */
+ static atomic_uint enviadas;
+ static atomic_uint procesadas;
+ static atomic_uint vaciados;
+ static atomic_bool bloqueado;
+ static atomic_bool terminado;
+ static atomic_uint conError;        /**< Respuestas del modo continuo enviadas con código de error. */
+ 
+ /**
+  * @brief Generador pseudoaleatorio (congruencial lineal) para que cada corrida sea igual.
+  */
+ static uint32_t aleatorio(void) {
+ 
+     static uint32_t estado = 12345u;
+ 
+     estado = estado * 1103515245u + 12345u;
+     return estado >> 8;
+ }
+ 
+ /**
+  * @brief Bytes de ruido: cabeceras, comando de medición y fines de trama sueltos, y otros
+  *        valores que no forman un largo ni un comando válidos, para que el ruido no pueda
+  *        formar por sí solo una trama.
+  */
+ static uint8_t ruido(uint8_t* buffer) {
+ 
+     static const uint8_t frecuentes[] = {0x55, 0x55, 0xAA, 0x81, 0xFA, 0x00};
+     uint8_t n = 1 + aleatorio() % RUIDO_MAX;
+ 
+     for (uint8_t i = 0; i < n; i++) {
+         uint32_t r = aleatorio();
+         buffer[i] = (r & 1) ? frecuentes[(r >> 1) % sizeof(frecuentes)] : (uint8_t)(0x08 + (r >> 1) % 0x78);
+     }
+     return n;
+ }
+ 
+ /**
+  * @brief Espera antes de enviar la trama i según el escenario.
+  */
+ static void esperar(uint32_t i) {
+ 
+     //Si se perdiera una trama no se esperaría para siempre su procesamiento
+     uint32_t limite = (actual == ESCENARIO_RUIDO) ? TRAMAS_EN_VUELO_RUIDO : TRAMAS_EN_VUELO;
+     for (uint32_t espera = 0; actual != ESCENARIO_RAFAGA && espera < ESPERA_MAX; espera++) {
+         if ((int32_t)(atomic_load(&enviadas) - atomic_load(&procesadas)) < (int32_t)limite) break;
+         sched_yield();
+     }
+ 
+     //Entre ráfagas se libera el lazo principal y se espera que encuentre el buffer vacío
+     if (actual == ESCENARIO_RAFAGA && i % RAFAGA == 0) {
+         uint32_t v = atomic_load(&vaciados);
+         atomic_store(&bloqueado, false);
+         for (uint32_t espera = 0; espera < ESPERA_MAX && atomic_load(&vaciados) == v; espera++) {
+             sched_yield();
+         }
+         atomic_store(&bloqueado, true);
+     }
+ }
+ 
+ /**
+  * @brief Hilo del sensor y de la interrupción: envía las tramas de medición.
+  */
+ static void* sensor(void* arg) {
+ 
+     uint8_t basura[RUIDO_MAX];
+     bool cortada = false;
+ 
+     for (uint32_t i = 0; i < tramas; i++) {
+ 
+         uint16_t d = (uint16_t)(i % DISTANCIAS);
+         uint8_t trama[8] = {0x55, 0xAA, 0x81, 0x03, (uint8_t)(d >> 8), (uint8_t)d, 0x00, 0xFA};
+         uint8_t largo = sizeof(trama);
+ 
+         esperar(i);
+ 
+         //El protocolo no tiene suma de verificación: una trama cortada seguida de ruido puede
+         //formar una trama válida con otra distancia, por lo que después de una cortada no hay ruido
+         if (actual == ESCENARIO_RUIDO) {
+             uint32_t r = aleatorio() % 100;
+             if (cortada) {
+                 cortada = false;
+             } else if (r < 20) {
+                 //Ruido antes de la trama
+                 marcas[i] |= 1;
+                 UART_Stub_Receive(basura, ruido(basura));
+             } else if (r < 28) {
+                 //Comienzo de la misma trama, cortado
+                 marcas[i] |= 1;
+                 UART_Stub_Receive(trama, 1 + aleatorio() % (sizeof(trama) - 1));
+             } else if (r < 33) {
+                 //Trama cortada: se pierde
+                 marcas[i] |= 2;
+                 largo = 1 + aleatorio() % (sizeof(trama) - 1);
+                 cortada = true;
+             }
+         }
+ 
+         if (largo == sizeof(trama)) atomic_fetch_add(&enviadas, 1);
+         UART_Stub_Receive(trama, largo);
+ 
+         if (i % PERIODO_DESBORDE == PERIODO_DESBORDE - 1) UART_Stub_Overrun();
+     }
+ 
+     atomic_store(&bloqueado, false);
+     atomic_store(&terminado, true);
+     return NULL;
+ }
+ 
+ /**
+  * @brief Hilo del sensor en modo continuo: responde los pedidos de medición.
+  */
+ static void* sensorContinuo(void* arg) {
+ 
+     uint32_t atendidos = UART_Stub_Commands();
+     uint16_t d = 0;
+     const struct timespec pedido = {0, PEDIDO_US * 1000L};
+     const struct timespec respuesta = {0, RESPUESTA_US * 1000L};
+ 
+     while (!atomic_load(&terminado)) {
+ 
+         if (!UART_Stub_TxPending()) {
+             sched_yield();
+             continue;
+         }
+ 
+         nanosleep(&pedido, NULL);
+         UART_Stub_TxDone();
+ 
+         //Los pedidos que llegan mientras el sensor mide se responden con una sola medición
+         if (UART_Stub_Commands() == atendidos) continue;
+         atendidos = UART_Stub_Commands();
+         nanosleep(&respuesta, NULL);
+ 
+         if (aleatorio() % 100 < SIN_RESPUESTA_PCT) continue;
+ 
+         d++;
+         uint8_t error = (aleatorio() % 100 < CON_ERROR_PCT) ? 0x01 : 0x00;
+         uint8_t trama[8] = {0x55, 0xAA, 0x81, 0x03, (uint8_t)(d >> 8), (uint8_t)d, error, 0xFA};
+         if (error != 0) atomic_fetch_add(&conError, 1);
+         UART_Stub_Receive(trama, sizeof(trama));
+     }
+ 
+     return NULL;
+ }
+ 
+ /// @brief Comandos avisados por el driver al terminar de enviarlos.
+ static atomic_uint enviados;
+ 
+ /**
+  * @brief Callback de fin de transmisión del driver (se llama desde el hilo del sensor).
+  */
+ static void comandoEnviado(uint8_t cmd) {
+     atomic_fetch_add(&enviados, 1);
+ }
+ 
+ /**
+  * @brief Ejecuta el escenario continuo y verifica sus resultados.
+  *
+  * @return true si se cumplieron las verificaciones.
+  */
+ static bool continuo(void) {
+ 
+     pthread_t hilo;
+     int32_t anterior = 0;
+     uint32_t incorrectas = 0;
+     uint32_t leidas = 0;
+     uint32_t cortas = 0;
+     TFLC02_Sample_t lote[LOTE];
+ 
+     atomic_store(&terminado, false);
+     atomic_store(&conError, 0);
+     UART_Stub_Reset();
+     TFLC02_Start();
+     TFLC02_Stats_t inicio = TFLC02_GetStats();
+     TFLC02_SetTxCallback(comandoEnviado);
+     pthread_create(&hilo, NULL, sensorContinuo, NULL);
+ 
+     uint32_t comienzo = HAL_GetTick();
+     TFLC02_FreeRunStart();
+ 
+     while (HAL_GetTick() - comienzo < DURACION_MS) {
+ 
+         if (TFLC02_FramePresent()) TFLC02_Parse_Packet();
+         TFLC02_FreeRunUpdate();
+ 
+         uint16_t n = TFLC02_ReadSamples(lote, LOTE);
+         for (uint16_t i = 0; i < n; i++) {
+             int32_t d = lote[i].distance;
+             if (d <= anterior) incorrectas++;
+             anterior = d;
+ 
+             //Las respuestas a pedidos ya abandonados no tienen latencia
+             uint32_t latencia = (lote[i].frameEndTime - lote[i].requestTime) / (SystemCoreClock / 1000000u);
+             if (latencia > 0 && latencia < RESPUESTA_US) cortas++;
+         }
+         leidas += n;
+         sched_yield();
+     }
+ 
+     TFLC02_FreeRunStop();
+     atomic_store(&terminado, true);
+     pthread_join(hilo, NULL);
+ 
+     TFLC02_Stats_t s = TFLC02_GetStats();
+     uint32_t mediciones = s.measurements - inicio.measurements;
+     uint32_t timeouts = s.timeouts - inicio.timeouts;
+     uint32_t reintentos = s.retries - inicio.retries;
+     uint32_t perdidos = s.droppedRequests - inicio.droppedRequests;
+     uint32_t comandos = s.txCommands - inicio.txCommands;
+     TFLC02_Timing_t t = TFLC02_GetTiming();
+ 
+     printf("continuo %u ms  pedidos %u  mediciones %u  timeouts %u  reintentos %u  perdidos %u  muestras/s %u (ultimo segundo %u; con 50 ms fijos, 20)\n",
+            DURACION_MS, s.requests - inicio.requests, mediciones, timeouts, reintentos, perdidos,
+            mediciones * 1000u / DURACION_MS, TFLC02_FreeRunRate());
+     printf("        comandos enviados %u  avisados %u  cola max %u  descartados %u\n",
+            comandos, atomic_load(&enviados), s.txQueueMax, s.txOverflows);
+     printf("        muestras leidas %u (con error %u)  latencia min/media/max %u/%u/%u us  intervalo min/max %u/%u us  jitter %u us\n",
+            leidas, atomic_load(&conError), t.latencyMinUs, t.latencyMeanUs, t.latencyMaxUs, t.intervalMinUs, t.intervalMaxUs, t.jitterUs);
+ 
+     bool ok = (incorrectas == 0);
+     if (incorrectas > 0) printf("        ERROR: %u distancias aceptadas repetidas o fuera de orden\n", incorrectas);
+     if (timeouts == 0 || reintentos == 0) {
+         printf("        ERROR: no se repitieron los pedidos sin respuesta\n");
+         ok = false;
+     }
+     //Cada timeout es un reintento o un abandono, y solo los abandonos son pedidos perdidos
+     if (perdidos != timeouts - reintentos) {
+         printf("        ERROR: %u pedidos perdidos para %u abandonos\n", perdidos, timeouts - reintentos);
+         ok = false;
+     }
+     if (comandos != atomic_load(&enviados) || s.txOverflows != 0) {
+         printf("        ERROR: comandos sin avisar o descartados por la cola de transmisión\n");
+         ok = false;
+     }
+     //Se leen también las respuestas con código de error, que no cuentan como mediciones
+     if (leidas + s.sampleOverflows - inicio.sampleOverflows != mediciones + atomic_load(&conError) || s.sampleOverflows != inicio.sampleOverflows) {
+         printf("        ERROR: se perdieron mediciones del buffer de muestras\n");
+         ok = false;
+     }
+     if (cortas > 0 || t.answered == 0 || t.latencyMinUs < RESPUESTA_US) {
+         printf("        ERROR: %u latencias menores que el tiempo de la respuesta\n", cortas);
+         ok = false;
+     }
+     //Una respuesta tardía que se tomara por la del reintento daría una latencia negativa (enorme sin signo)
+     if (t.latencyMaxUs > DURACION_MS * 1000u) {
+         printf("        ERROR: latencia maxima de %u us, mayor que la prueba\n", t.latencyMaxUs);
+         ok = false;
+     }
+     if (mediciones * 1000u / DURACION_MS < 200) {
+         printf("        ERROR: el modo continuo no supera 10 veces el muestreo de 50 ms\n");
+         ok = false;
+     }
+ 
+     return ok;
+ }
+ 
+ /**
+  * @brief Envía SIN_PAUSA tramas en una sola recepción y verifica que se acepten todas.
+  *
+  * @return true si se cumplieron las verificaciones.
+  */
+ static bool sinPausa(void) {
+ 
+     uint8_t bloque[SIN_PAUSA * 8];
+     uint32_t aceptadas = 0;
+     uint32_t incorrectas = 0;
+ 
+     for (uint16_t i = 0; i < SIN_PAUSA; i++) {
+         uint16_t d = i + 1;
+         uint8_t trama[8] = {0x55, 0xAA, 0x81, 0x03, (uint8_t)(d >> 8), (uint8_t)d, 0x00, 0xFA};
+         memcpy(&bloque[i * sizeof(trama)], trama, sizeof(trama));
+     }
+ 
+     UART_Stub_Reset();
+     TFLC02_Start();
+     TFLC02_Stats_t inicio = TFLC02_GetStats();
+     UART_Stub_Receive(bloque, sizeof(bloque));
+ 
+     while (TFLC02_FramePresent()) {
+         TFLC02_Parse_Packet();
+         if (!TFLC02_RspComplete()) continue;
+         if (TFLC02_GetDistance() != aceptadas + 1) incorrectas++;
+         aceptadas++;
+     }
+ 
+     TFLC02_Stats_t s = TFLC02_GetStats();
+     uint32_t desbordes = s.rxOverflows - inicio.rxOverflows;
+ 
+     printf("%-7s tramas %7u  aceptadas %7u  bytes desbordados %7u\n", "sin pausa", SIN_PAUSA, aceptadas, desbordes);
+ 
+     if (aceptadas != SIN_PAUSA || incorrectas != 0 || desbordes != 0) {
+         printf("        ERROR: se perdieron tramas recibidas sin linea inactiva\n");
+         return false;
+     }
+     return true;
+ }
+ 
+ /**
+  * @brief Ejecuta un escenario y verifica sus resultados.
+  *
+  * @return true si se cumplieron las verificaciones.
+  */
+ static bool escenario(const char* nombre, escenario_t e) {
+ 
+     pthread_t hilo;
+     uint32_t aceptadas = 0;
+     uint32_t incorrectas = 0;
+     uint32_t maxEnVuelo = 0;
+     int32_t anterior = -1;
+     uint32_t ciclo = 0;
+     int64_t ultimo = -1;
+     uint32_t interrupciones = UART_Stub_Interrupts();
+ 
+     actual = e;
+     memset(marcas, 0, tramas);
+     atomic_store(&enviadas, 0);
+     atomic_store(&procesadas, 0);
+     atomic_store(&vaciados, 0);
+     atomic_store(&bloqueado, e == ESCENARIO_RAFAGA);
+     atomic_store(&terminado, false);
+ 
+     UART_Stub_Reset();
+     TFLC02_Start();
+     TFLC02_Stats_t inicio = TFLC02_GetStats();
+     pthread_create(&hilo, NULL, sensor, NULL);
+ 
+     for (;;) {
+         bool fin = atomic_load(&terminado);
+ 
+         while (!atomic_load(&bloqueado) && TFLC02_FramePresent()) {
+             uint32_t enVuelo = atomic_load(&enviadas) - atomic_load(&procesadas);
+             if (enVuelo > maxEnVuelo) maxEnVuelo = enVuelo;
+ 
+             TFLC02_Parse_Packet();
+             atomic_fetch_add(&procesadas, 1);
+ 
+             if (!TFLC02_RspComplete()) continue;
+ 
+             //Las distancias reinician cada DISTANCIAS tramas: un salto grande hacia atrás es un ciclo nuevo
+             int32_t p = TFLC02_GetDistance();
+             if (p < anterior - DISTANCIAS / 2) ciclo++;
+             int64_t indice = (int64_t)ciclo * DISTANCIAS + p;
+             if (indice <= ultimo || indice >= tramas) {
+                 incorrectas++;
+             } else {
+                 marcas[indice] |= 4;
+             }
+             ultimo = indice;
+             anterior = p;
+             aceptadas++;
+         }
+ 
+         if (fin) break;
+         if (!atomic_load(&bloqueado)) atomic_fetch_add(&vaciados, 1);
+         sched_yield();
+     }
+ 
+     pthread_join(hilo, NULL);
+ 
+     TFLC02_Stats_t s = TFLC02_GetStats();
+     uint32_t desbordes = s.rxOverflows - inicio.rxOverflows;
+     uint32_t invalidas = s.invalidFrames - inicio.invalidFrames;
+     uint32_t errores = s.rxErrors - inicio.rxErrors;
+     uint32_t perdidas = tramas - aceptadas;
+     interrupciones = UART_Stub_Interrupts() - interrupciones;
+ 
+     printf("%-7s tramas %7u  aceptadas %7u  perdidas %6u  invalidas %6u  bytes desbordados %7u  errores UART %3u  interrupciones/trama %.2f\n",
+            nombre, tramas, aceptadas, perdidas, invalidas, desbordes, errores, (double)interrupciones / tramas);
+ 
+     bool ok = (incorrectas == 0);
+     if (incorrectas > 0) printf("        ERROR: %u distancias aceptadas incorrectas o fuera de orden\n", incorrectas);
+ 
+     if (e == ESCENARIO_RITMO) {
+         printf("        tramas en vuelo max %u\n", maxEnVuelo);
+ 
+         //Los desbordes simulados del periférico ocurren entre tramas: no cortan ninguna
+         if (desbordes != 0 || perdidas != 0) {
+             printf("        ERROR: se perdieron tramas sin desborde del buffer\n");
+             ok = false;
+         }
+         if (maxEnVuelo < 2) {
+             printf("        ERROR: nunca hubo mas de una trama esperando\n");
+             ok = false;
+         }
+     } else if (e == ESCENARIO_RAFAGA) {
+         //Cada trama perdida debe tener al menos un byte descartado
+         if (desbordes == 0) {
+             printf("        ERROR: el escenario no llego a desbordar el buffer\n");
+             ok = false;
+         }
+         if (perdidas > desbordes) {
+             printf("        ERROR: hay tramas perdidas sin bytes descartados\n");
+             ok = false;
+         }
+     } else {
+         uint32_t conRuido = 0, recuperadas = 0, cortadas = 0, completasPerdidas = 0;
+         for (uint32_t i = 0; i < tramas; i++) {
+             if (marcas[i] & 1) conRuido++;
+             if ((marcas[i] & 1) && (marcas[i] & 4)) recuperadas++;
+             if (marcas[i] & 2) cortadas++;
+             else if (!(marcas[i] & 4)) completasPerdidas++;
+         }
+ 
+         printf("        con ruido antes %u  recuperadas %u  cortadas %u  completas perdidas %u  bytes descartados al resincronizar %u\n",
+                conRuido, recuperadas, cortadas, completasPerdidas, s.discardedBytes - inicio.discardedBytes);
+ 
+         if (desbordes != 0 || completasPerdidas != 0) {
+             printf("        ERROR: se perdieron tramas completas\n");
+             ok = false;
+         }
+     }
+ 
+     return ok;
+ }
+ 
+ int main(int argc, char** argv) {
+ 
+     if (argc > 1) tramas = (uint32_t)strtoul(argv[1], NULL, 10);
+     marcas = malloc(tramas);
+ 
+     printf("Recepcion %s, buffer circular de 128 bytes\n", TFLC02_USE_RX_DMA ? "por DMA circular" : "por interrupcion");
+ 
+     bool ok = escenario("ritmo", ESCENARIO_RITMO);
+     ok = escenario("rafaga", ESCENARIO_RAFAGA) && ok;
+     ok = escenario("ruido", ESCENARIO_RUIDO) && ok;
+     ok = sinPausa() && ok;
+     ok = continuo() && ok;
+ 
+     free(marcas);
+     printf("%s\n", ok ? "OK" : "FALLA");
+     return ok ? 0 : 1;
+ }
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""
+@file splashgen.py
+@brief Genera las imágenes de arranque de la pantalla de medición del display SSD1306.
+
+Rasteriza con Font5x7 (celdas de 6 columnas, como SSD1306_DrawText) las
+etiquetas fijas de la pantalla de medición y escribe
+Drivers/API/Src/SSD1306_Splash.c con:
+
+  - SSD1306_SplashMeasure64: panel de 128x64 (1 KB).
+  - SSD1306_SplashMeasure32: panel de 128x32 (512 bytes).
+
+Las imágenes quedan en flash en orden de página, igual que la GDDRAM en
+modo de direccionamiento horizontal, de modo que SSD1306_LoadImage() las
+envía en una sola transacción de datos. Los campos dinámicos se dibujan
+encima en tiempo de ejecución.
+
+Las posiciones deben coincidir con SSD1306_Layout64 y SSD1306_Layout32 de
+Drivers/API/Src/SSD1306_View.c.
+
+Uso (paso previo a la compilación, desde la carpeta del proyecto):
+    python3 Tools/splashgen.py
+"""
+
+import os
+
+from fontgen import ASCII_OFFSET, FONT_SRC, ROOT, read_font5x7
+
+SPLASH_OUT = os.path.join(ROOT, "Drivers", "API", "Src", "SSD1306_Splash.c")
+
+WIDTH = 128
+CHAR_CELL_WIDTH = 6
+
+# Etiquetas fijas de cada distribución: (celda, página, texto).
+LAYOUTS = [
+    ("SSD1306_SplashMeasure64", 8, [
+        (0, 0, "Distancia:"),
+        (17, 2, "[cm]"),
+        (0, 3, "Maxima:"),
+        (0, 4, "Minima:"),
+        (0, 5, "Muestreo:"),
+    ]),
+    ("SSD1306_SplashMeasure32", 4, [
+        (17, 1, "[cm]"),
+        (0, 2, "Maxima:"),
+        (0, 3, "Minima:"),
+    ]),
+]
+
+
+def render(font, pages, labels):
+    """Devuelve la imagen en orden de página (pages * WIDTH bytes)."""
+    image = [0] * (pages * WIDTH)
+    for cell, page, text in labels:
+        column = cell * CHAR_CELL_WIDTH
+        for ch in text:
+            for i, bits in enumerate(font[ord(ch) - ASCII_OFFSET]):
+                if column + i < WIDTH:
+                    image[page * WIDTH + column + i] = bits
+            column += CHAR_CELL_WIDTH
+    return image
+
+
+def main():
+    font = read_font5x7(FONT_SRC)
+
+    lines = [
+        "/*",
+        " * @file SSD1306_Splash.c",
+        " *",
+        " * Archivo generado por Tools/splashgen.py a partir de Font5x7. No editar.",
+        " */",
+        '#include "../../Drivers/API/Inc/SSD1306_Splash.h"',
+        "",
+    ]
+
+    for name, pages, labels in LAYOUTS:
+        image = render(font, pages, labels)
+        lines.append("static const uint8_t %sData[%d] = {" % (name, len(image)))
+        for page in range(pages):
+            texts = [text for _, p, text in labels if p == page]
+            lines.append("    // Página %d%s" % (page, (": " + " ".join(texts)) if texts else ""))
+            for i in range(0, WIDTH, 16):
+                row = image[page * WIDTH + i:page * WIDTH + i + 16]
+                lines.append("    " + ",".join("0x%02X" % b for b in row) + ",")
+        lines += [
+            "};",
+            "",
+            "const SSD1306_Image_t %s = {" % name,
+            "    .width = %d," % WIDTH,
+            "    .pages = %d," % pages,
+            "    .data = %sData," % name,
+            "};",
+            "",
+        ]
+
+    with open(SPLASH_OUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,201 @@
+/**
+ * @file stats_check.c
+ * @brief Compara las estadísticas de API_stats contra un cálculo directo sobre la ventana, en una PC.
+ *
+ * Para varias ventanas y series de mediciones (un objetivo con ruido que se mueve, un
+ * valor constante, escalones y mediciones fuera del histograma) se agrega cada medición
+ * a stats_t y a una copia de la ventana, y después de cada una se verifica:
+ * - cantidad, mínimo y máximo exactos;
+ * - media y desvío estándar de la muestra con a lo sumo una décima de mm de diferencia
+ *   contra el cálculo en double;
+ * - cada PERCENTIL_CADA mediciones, mediana y percentil 95 a lo sumo a un intervalo del
+ *   histograma del valor exacto (interpolado entre las mediciones ordenadas), cuando
+ *   la ventana está dentro del histograma.
+ *
+ * Informa además el tiempo medio de statsUpdate() en la PC, medido en una segunda
+ * pasada sin verificaciones, que no debe depender de la ventana. Devuelve 0 si se
+ * cumplen todas las verificaciones.
+ *
+ * Uso: stats_check [mediciones por serie]
+ *
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include <math.h>
+ #include <time.h>
+ #include "../../Drivers/API/Inc/API_stats.h"
+ 
+ /// @brief Mediciones de cada serie por defecto.
+ #define SERIE_LARGO         100000
+ 
+ /// @brief Cada cuántas mediciones se verifican los percentiles (ordenar la ventana es caro).
+ #define PERCENTIL_CADA      7
+ 
+ /**
+  * @brief Series de mediciones.
+  */
+ typedef enum {
+     SERIE_RUIDO,            /**< Objetivo que se mueve con ruido de unos 7 mm y picos. */
+     SERIE_CONSTANTE,        /**< Siempre la misma distancia. */
+     SERIE_ESCALONES,        /**< Saltos de 400 mm cada 300 mediciones. */
+     SERIE_FUERA,            /**< Valores de 0 a 4000 mm, más allá del histograma, y cercanos a 65535 mm (el peor caso de M2). */
+     SERIE_CANTIDAD
+ } serie_t;
+ 
+ static const char* const NOMBRES[SERIE_CANTIDAD] = { "ruido", "constante", "escalones", "fuera de rango" };
+ 
+ /**
+  * @brief Generador pseudoaleatorio (congruencial lineal) para que cada corrida sea igual.
+  */
+ static uint32_t aleatorio(void) {
+ 
+     static uint32_t estado = 12345u;
+ 
+     estado = estado * 1103515245u + 12345u;
+     return estado >> 8;
+ }
+ 
+ /**
+  * @brief Medición i de una serie.
+  */
+ static uint16_t medicion(serie_t serie, uint32_t i) {
+ 
+     static int32_t real = 800;
+     int32_t ruido = 0;
+ 
+     switch (serie) {
+     case SERIE_RUIDO:
+         if (i % 500 < 200) real += (i % 1000 < 500) ? 2 : -2;
+         for (uint8_t j = 0; j < 4; j++) ruido += (int32_t)(aleatorio() % 25) - 12;
+         if (aleatorio() % 50 == 0) ruido += 300;
+         return (uint16_t)(real + ruido);
+     case SERIE_CONSTANTE:
+         return 1234;
+     case SERIE_ESCALONES:
+         return (uint16_t)(200 + ((i / 300) % 4) * 400);
+     default:
+         return (aleatorio() % 4 == 0) ? (uint16_t)(65535 - aleatorio() % 16) : (uint16_t)(aleatorio() % 4001);
+     }
+ }
+ 
+ static int comparar(const void* a, const void* b) {
+     return (int)*(const uint16_t*)a - (int)*(const uint16_t*)b;
+ }
+ 
+ /**
+  * @brief Percentil exacto: interpolación entre las mediciones ordenadas en percent * (n - 1) / 100.
+  */
+ static double percentil(const uint16_t* ordenadas, uint16_t n, uint8_t percent) {
+ 
+     double posicion = percent * (n - 1) / 100.0;
+     uint16_t i = (uint16_t)posicion;
+ 
+     if (i + 1 >= n) return ordenadas[n - 1];
+     return ordenadas[i] + (posicion - i) * (ordenadas[i + 1] - ordenadas[i]);
+ }
+ 
+ /**
+  * @brief Agrega una serie a las estadísticas y verifica cada resultado.
+  *
+  * @return Cantidad de verificaciones que fallaron.
+  */
+ static uint32_t probar(uint16_t ventana, serie_t serie, uint32_t largo) {
+ 
+     statsConfig_t config = STATS_CONFIG_DEFAULT;
+     stats_t stats;
+     uint16_t copia[STATS_WINDOW_MAX], ordenadas[STATS_WINDOW_MAX];
+     uint32_t fallas = 0;
+     double peorMedia = 0, peorDesvio = 0, peorPercentil = 0;
+     struct timespec inicio, fin;
+ 
+     config.window = ventana;
+     statsInit(&stats, &config);
+ 
+     for (uint32_t i = 0; i < largo; i++) {
+ 
+         uint16_t valor = medicion(serie, i);
+ 
+         statsUpdate(&stats, valor);
+ 
+         copia[i % ventana] = valor;
+         uint16_t n = (i + 1 < ventana) ? (uint16_t)(i + 1) : ventana;
+ 
+         //Cálculo directo sobre la ventana
+         double suma = 0, suma2 = 0;
+         uint16_t minimo = UINT16_MAX, maximo = 0;
+         for (uint16_t j = 0; j < n; j++) {
+             suma += copia[j];
+             if (copia[j] < minimo) minimo = copia[j];
+             if (copia[j] > maximo) maximo = copia[j];
+         }
+         double media = suma / n;
+         for (uint16_t j = 0; j < n; j++) suma2 += (copia[j] - media) * (copia[j] - media);
+         double desvio = (n > 1) ? sqrt(suma2 / (n - 1)) : 0;
+ 
+         statsSummary_t s = statsGetSummary(&stats);
+         double difMedia = fabs(s.meanTenths / 10.0 - media);
+         double difDesvio = fabs(s.stddevTenths / 10.0 - desvio);
+         if (difMedia > peorMedia) peorMedia = difMedia;
+         if (difDesvio > peorDesvio) peorDesvio = difDesvio;
+ 
+         if (s.count != n || s.min != minimo || s.max != maximo || difMedia > 0.1 || difDesvio > 0.1) {
+             if (fallas < 5) {
+                 printf("        ERROR en la medicion %u: n %u/%u min %u/%u max %u/%u media %.1f/%.2f desvio %.1f/%.2f\n",
+                        i, s.count, n, s.min, minimo, s.max, maximo, s.meanTenths / 10.0, media, s.stddevTenths / 10.0, desvio);
+             }
+             fallas++;
+         }
+ 
+         uint32_t finHistograma = config.binOrigin + (uint32_t)STATS_BINS * config.binWidth;
+         if (i % PERCENTIL_CADA != 0 || minimo < config.binOrigin || maximo >= finHistograma) continue;
+ 
+         for (uint16_t j = 0; j < n; j++) ordenadas[j] = copia[j];
+         qsort(ordenadas, n, sizeof(ordenadas[0]), comparar);
+         double difMediana = fabs(s.median - percentil(ordenadas, n, 50));
+         double difP95 = fabs(s.p95 - percentil(ordenadas, n, 95));
+         if (difMediana > peorPercentil) peorPercentil = difMediana;
+         if (difP95 > peorPercentil) peorPercentil = difP95;
+ 
+         if (difMediana > config.binWidth || difP95 > config.binWidth) {
+             if (fallas < 5) {
+                 printf("        ERROR en la medicion %u: mediana %u/%.1f p95 %u/%.1f\n",
+                        i, s.median, percentil(ordenadas, n, 50), s.p95, percentil(ordenadas, n, 95));
+             }
+             fallas++;
+         }
+     }
+ 
+     //Tiempo de statsUpdate() sin el cálculo directo
+     statsReset(&stats);
+     clock_gettime(CLOCK_MONOTONIC, &inicio);
+     for (uint32_t i = 0; i < largo; i++) statsUpdate(&stats, medicion(serie, i));
+     clock_gettime(CLOCK_MONOTONIC, &fin);
+     double ns = ((fin.tv_sec - inicio.tv_sec) * 1e9 + (fin.tv_nsec - inicio.tv_nsec)) / largo;
+ 
+     printf("ventana %3u  %-15s  dif. media %.2f mm  desvio %.2f mm  percentiles %5.1f mm  %2.0f ns/medicion en la PC\n",
+            ventana, NOMBRES[serie], peorMedia, peorDesvio, peorPercentil, ns);
+ 
+     return fallas;
+ }
+ 
+ int main(int argc, char** argv) {
+ 
+     const uint16_t ventanas[] = { 1, 2, 5, 64, STATS_WINDOW_MAX };
+     uint32_t largo = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : SERIE_LARGO;
+     uint32_t fallas = 0;
+ 
+     printf("stats_t: %u bytes (ventana de hasta %u mediciones, %u intervalos)\n",
+            (unsigned)sizeof(stats_t), STATS_WINDOW_MAX, STATS_BINS);
+ 
+     for (uint8_t v = 0; v < sizeof(ventanas) / sizeof(ventanas[0]); v++) {
+         for (serie_t serie = 0; serie < SERIE_CANTIDAD; serie++) {
+             fallas += probar(ventanas[v], serie, largo);
+         }
+     }
+ 
+     printf("%s\n", (fallas == 0) ? "OK" : "FALLO");
+ 
+     return (fallas == 0) ? 0 : 1;
+ }
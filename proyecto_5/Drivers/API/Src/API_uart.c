@@ -6,10 +6,10 @@
  */
 #include "main.h"
 #include "API_uart.h"
+#include "API_format.h"
 #include "stdlib.h"
 #include <string.h>
 #include <stdbool.h>
-#include <stdio.h>
 
 UART_HandleTypeDef huart2;
 
@@ -35,26 +35,32 @@ bool uartInit(void){
 	huart2.Init.HwFlowCtl = UART_HWCONTROL_NONE;
 	huart2.Init.OverSampling = UART_OVERSAMPLING_16;
 
-	sprintf(buffer,
-	        "BaudRate: %lu\n\r"
-	        "WordLength: %s\n\r"
-	        "StopBits: %s\n\r"
-	        "Parity: %s\n\r"
-	        "Mode: %s\n\r"
-	        "Flow Control: %s\n\r"
-	        "Oversampling: %lu\n\r",
-	        huart2.Init.BaudRate,
-	        (huart2.Init.WordLength == UART_WORDLENGTH_8B) ? "8 bits" : "9 bits",
-	        (huart2.Init.StopBits == UART_STOPBITS_1) ? "1 bit" : "2 bits",
+	size_t len = 0;
+
+	len += formatString(&buffer[len], sizeof(buffer) - len, "BaudRate: ");
+	len += formatUint(&buffer[len], sizeof(buffer) - len, huart2.Init.BaudRate);
+	len += formatString(&buffer[len], sizeof(buffer) - len, "\n\rWordLength: ");
+	len += formatString(&buffer[len], sizeof(buffer) - len,
+	        (huart2.Init.WordLength == UART_WORDLENGTH_8B) ? "8 bits" : "9 bits");
+	len += formatString(&buffer[len], sizeof(buffer) - len, "\n\rStopBits: ");
+	len += formatString(&buffer[len], sizeof(buffer) - len,
+	        (huart2.Init.StopBits == UART_STOPBITS_1) ? "1 bit" : "2 bits");
+	len += formatString(&buffer[len], sizeof(buffer) - len, "\n\rParity: ");
+	len += formatString(&buffer[len], sizeof(buffer) - len,
 	        (huart2.Init.Parity == UART_PARITY_NONE) ? "None" :
-	        (huart2.Init.Parity == UART_PARITY_EVEN) ? "Even" : "Odd",
+	        (huart2.Init.Parity == UART_PARITY_EVEN) ? "Even" : "Odd");
+	len += formatString(&buffer[len], sizeof(buffer) - len, "\n\rMode: ");
+	len += formatString(&buffer[len], sizeof(buffer) - len,
 	        (huart2.Init.Mode == UART_MODE_TX_RX) ? "TX/RX" :
-	        (huart2.Init.Mode == UART_MODE_TX) ? "TX only" : "RX only",
+	        (huart2.Init.Mode == UART_MODE_TX) ? "TX only" : "RX only");
+	len += formatString(&buffer[len], sizeof(buffer) - len, "\n\rFlow Control: ");
+	len += formatString(&buffer[len], sizeof(buffer) - len,
 	        (huart2.Init.HwFlowCtl == UART_HWCONTROL_NONE) ? "None" :
 	        (huart2.Init.HwFlowCtl == UART_HWCONTROL_RTS) ? "RTS" :
-	        (huart2.Init.HwFlowCtl == UART_HWCONTROL_CTS) ? "CTS" : "RTS/CTS",
-	        huart2.Init.OverSampling
-	    );
+	        (huart2.Init.HwFlowCtl == UART_HWCONTROL_CTS) ? "CTS" : "RTS/CTS");
+	len += formatString(&buffer[len], sizeof(buffer) - len, "\n\rOversampling: ");
+	len += formatUint(&buffer[len], sizeof(buffer) - len, huart2.Init.OverSampling);
+	len += formatString(&buffer[len], sizeof(buffer) - len, "\n\r");
 
 	  if (HAL_UART_Init(&huart2) != HAL_OK)
 	  {
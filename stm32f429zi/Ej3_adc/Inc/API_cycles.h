@@ -0,0 +1,31 @@
+/**
+ * @file API_cycles.h
+ * @brief Contador de ciclos de CPU basado en el DWT del Cortex-M4.
+ *
+ * Se usa para medir el costo de secciones de código. La resta de dos lecturas
+ * da la cantidad de ciclos transcurridos aunque el contador haya desbordado.
+ */
+
+ #ifndef API_INC_API_CYCLES_H_
+ #define API_INC_API_CYCLES_H_
+ 
+ #include <stdint.h>
+ #include "stm32f4xx.h"
+ 
+ /**
+  * @brief Habilita y pone en cero el contador de ciclos del DWT.
+  */
+ static inline void cyclesInit(void){
+     CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+     DWT->CYCCNT = 0;
+     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+ }
+ 
+ /**
+  * @brief Devuelve el valor actual del contador de ciclos.
+  */
+ static inline uint32_t cyclesNow(void){
+     return DWT->CYCCNT;
+ }
+ 
+ #endif /* API_INC_API_CYCLES_H_ */
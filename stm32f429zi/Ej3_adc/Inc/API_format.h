@@ -0,0 +1,50 @@
+/**
+ * @file API_format.h
+ * @brief Formateo de números sin sprintf ni memoria dinámica.
+ *
+ * Todas las funciones escriben sobre un buffer provisto por el llamador, siempre
+ * terminan el texto con '\0' y devuelven la cantidad de caracteres escritos (sin
+ * contar el terminador). Si el resultado no entra en el buffer no se escribe nada
+ * y se devuelve 0. No usan estado interno, por lo que pueden llamarse desde
+ * interrupciones o desde varios módulos a la vez.
+ *
+ * Para concatenar se avanza el puntero con el valor devuelto:
+ * @code
+ * len  = formatMmToCm(buffer, sizeof(buffer), mm);
+ * len += formatString(&buffer[len], sizeof(buffer) - len, "[cm]");
+ * @endcode
+ */
+
+ #ifndef API_INC_API_FORMAT_H_
+ #define API_INC_API_FORMAT_H_
+ 
+ #include <stdint.h>
+ #include <stddef.h>
+ 
+ /// @brief Cantidad máxima de dígitos decimales de un uint32_t.
+ #define FORMAT_UINT32_DIGITS     10
+ 
+ size_t formatString(char* buffer, size_t size, const char* str);
+ size_t formatUint(char* buffer, size_t size, uint32_t value);
+ size_t formatInt(char* buffer, size_t size, int32_t value);
+ size_t formatUintPad(char* buffer, size_t size, uint32_t value, uint8_t width, char pad);
+ size_t formatFixed(char* buffer, size_t size, int32_t value, uint8_t decimals);
+ size_t formatMmToCm(char* buffer, size_t size, uint16_t mm);
+ size_t formatHex(char* buffer, size_t size, uint32_t value, uint8_t digits);
+ 
+ #ifdef API_FORMAT_BENCHMARK
+ 
+ /**
+  * @brief Resultado de la comparación de ciclos contra sprintf.
+  */
+ typedef struct {
+     uint32_t iterations;            /**< Cantidad de conversiones medidas. */
+     uint32_t sprintfCycles;         /**< Ciclos totales usando sprintf("%2d.%d"). */
+     uint32_t formatCycles;          /**< Ciclos totales usando formatMmToCm(). */
+ } formatBenchmark_t;
+ 
+ void formatBenchmark(formatBenchmark_t* result, uint32_t iterations);
+ 
+ #endif /* API_FORMAT_BENCHMARK */
+ 
+ #endif /* API_INC_API_FORMAT_H_ */
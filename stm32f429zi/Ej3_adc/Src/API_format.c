@@ -0,0 +1,292 @@
+/**
+ * @file API_format.c
+ * @brief Formateo de números sin sprintf ni memoria dinámica.
+ *
+ * Las conversiones se hacen con divisiones enteras sobre un buffer local de la
+ * pila; no se usa punto flotante ni la libc de formateo.
+ */
+
+ #include "API_format.h"
+ 
+ #ifdef API_FORMAT_BENCHMARK
+ #include "API_cycles.h"
+ #include <stdio.h>
+ #endif
+ 
+ /**
+  * @brief Convierte un valor a dígitos decimales en orden inverso.
+  *
+  * @param digits Destino de al menos FORMAT_UINT32_DIGITS caracteres.
+  * @param value Valor a convertir.
+  * @return Cantidad de dígitos generados (al menos uno).
+  */
+ static uint8_t formatDigits(char* digits, uint32_t value){
+ 
+     uint8_t count = 0;
+ 
+     do {
+         digits[count++] = (char)('0' + value % 10);
+         value /= 10;
+     } while (value != 0);
+ 
+     return count;
+ }
+ 
+ /**
+  * @brief Copia un string al buffer.
+  *
+  * @param buffer Buffer de destino.
+  * @param size Tamaño del buffer, incluyendo el terminador.
+  * @param str String a copiar.
+  * @return Caracteres escritos, o 0 si no entra.
+  */
+ size_t formatString(char* buffer, size_t size, const char* str){
+ 
+     size_t len = 0;
+ 
+     if (buffer == NULL || size == 0 || str == NULL) return 0;
+ 
+     while (str[len] != '\0') {
+         if (len + 1 >= size) {
+             buffer[0] = '\0';
+             return 0;
+         }
+         buffer[len] = str[len];
+         len++;
+     }
+     buffer[len] = '\0';
+ 
+     return len;
+ }
+ 
+ /**
+  * @brief Escribe un entero sin signo en decimal (equivale a "%lu").
+  *
+  * @param buffer Buffer de destino.
+  * @param size Tamaño del buffer, incluyendo el terminador.
+  * @param value Valor a escribir.
+  * @return Caracteres escritos, o 0 si no entra.
+  */
+ size_t formatUint(char* buffer, size_t size, uint32_t value){
+ 
+     return formatUintPad(buffer, size, value, 0, ' ');
+ }
+ 
+ /**
+  * @brief Escribe un entero con signo en decimal (equivale a "%ld").
+  *
+  * @param buffer Buffer de destino.
+  * @param size Tamaño del buffer, incluyendo el terminador.
+  * @param value Valor a escribir.
+  * @return Caracteres escritos, o 0 si no entra.
+  */
+ size_t formatInt(char* buffer, size_t size, int32_t value){
+ 
+     size_t len;
+ 
+     if (value >= 0) return formatUint(buffer, size, (uint32_t)value);
+ 
+     if (buffer == NULL || size < 2) return 0;
+ 
+     buffer[0] = '-';
+     len = formatUint(&buffer[1], size - 1, 0u - (uint32_t)value);
+     if (len == 0) {
+         buffer[0] = '\0';
+         return 0;
+     }
+ 
+     return len + 1;
+ }
+ 
+ /**
+  * @brief Escribe un entero sin signo alineado a la derecha en un ancho mínimo.
+  *
+  * Con pad = ' ' equivale a "%*lu" y con pad = '0' a "%0*lu".
+  *
+  * @param buffer Buffer de destino.
+  * @param size Tamaño del buffer, incluyendo el terminador.
+  * @param value Valor a escribir.
+  * @param width Ancho mínimo del campo; 0 para no rellenar.
+  * @param pad Carácter de relleno.
+  * @return Caracteres escritos, o 0 si no entra.
+  */
+ size_t formatUintPad(char* buffer, size_t size, uint32_t value, uint8_t width, char pad){
+ 
+     char digits[FORMAT_UINT32_DIGITS];
+     uint8_t count;
+     size_t len = 0;
+ 
+     if (buffer == NULL || size == 0) return 0;
+ 
+     count = formatDigits(digits, value);
+     if ((size_t)(width > count ? width : count) >= size) {
+         buffer[0] = '\0';
+         return 0;
+     }
+ 
+     while (width > count) {
+         buffer[len++] = pad;
+         width--;
+     }
+     while (count > 0) {
+         buffer[len++] = digits[--count];
+     }
+     buffer[len] = '\0';
+ 
+     return len;
+ }
+ 
+ /**
+  * @brief Escribe un valor en punto fijo decimal.
+  *
+  * El valor está escalado por 10^decimals: formatFixed(buf, size, -1234, 2)
+  * escribe "-12.34". Reemplaza a "%.Nf" sin usar punto flotante.
+  *
+  * @param buffer Buffer de destino.
+  * @param size Tamaño del buffer, incluyendo el terminador.
+  * @param value Valor escalado.
+  * @param decimals Cantidad de decimales (0 a 9).
+  * @return Caracteres escritos, o 0 si no entra.
+  */
+ size_t formatFixed(char* buffer, size_t size, int32_t value, uint8_t decimals){
+ 
+     uint32_t magnitude;
+     uint32_t scale = 1;
+     size_t len = 0;
+     size_t part;
+ 
+     if (buffer == NULL || size == 0 || decimals > 9) return 0;
+ 
+     magnitude = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+     for (uint8_t i = 0; i < decimals; i++) scale *= 10;
+ 
+     if (value < 0) {
+         if (size < 2) return 0;
+         buffer[len++] = '-';
+     }
+ 
+     part = formatUint(&buffer[len], size - len, magnitude / scale);
+     if (part == 0) {
+         buffer[0] = '\0';
+         return 0;
+     }
+     len += part;
+ 
+     if (decimals > 0) {
+         if (len + 1 >= size) {
+             buffer[0] = '\0';
+             return 0;
+         }
+         buffer[len++] = '.';
+         part = formatUintPad(&buffer[len], size - len, magnitude % scale, decimals, '0');
+         if (part == 0) {
+             buffer[0] = '\0';
+             return 0;
+         }
+         len += part;
+     }
+ 
+     return len;
+ }
+ 
+ /**
+  * @brief Escribe una distancia en milímetros como centímetros con un decimal.
+  *
+  * Equivale a sprintf("%2d.%d", mm / 10, mm % 10): la parte entera ocupa al
+  * menos dos caracteres, rellenos con espacios.
+  *
+  * @param buffer Buffer de destino.
+  * @param size Tamaño del buffer, incluyendo el terminador.
+  * @param mm Distancia en milímetros.
+  * @return Caracteres escritos, o 0 si no entra.
+  */
+ size_t formatMmToCm(char* buffer, size_t size, uint16_t mm){
+ 
+     size_t len;
+ 
+     len = formatUintPad(buffer, size, mm / 10, 2, ' ');
+     if (len == 0 || len + 2 >= size) {
+         if (buffer != NULL && size > 0) buffer[0] = '\0';
+         return 0;
+     }
+ 
+     buffer[len++] = '.';
+     buffer[len++] = (char)('0' + mm % 10);
+     buffer[len] = '\0';
+ 
+     return len;
+ }
+ 
+ /**
+  * @brief Escribe un valor en hexadecimal con mayúsculas y ancho fijo.
+  *
+  * Equivale a "%0*lX". Si el valor necesita más dígitos que digits, se escriben
+  * los necesarios.
+  *
+  * @param buffer Buffer de destino.
+  * @param size Tamaño del buffer, incluyendo el terminador.
+  * @param value Valor a escribir.
+  * @param digits Cantidad mínima de dígitos (1 a 8).
+  * @return Caracteres escritos, o 0 si no entra.
+  */
+ size_t formatHex(char* buffer, size_t size, uint32_t value, uint8_t digits){
+ 
+     static const char hexDigits[] = "0123456789ABCDEF";
+     uint8_t count = 1;
+     size_t len;
+ 
+     if (buffer == NULL || size == 0) return 0;
+ 
+     while (count < 8 && (value >> (4 * count)) != 0) count++;
+     if (digits > 8) digits = 8;
+     if (count < digits) count = digits;
+ 
+     if (count >= size) {
+         buffer[0] = '\0';
+         return 0;
+     }
+ 
+     for (len = 0; len < count; len++) {
+         buffer[len] = hexDigits[(value >> (4 * (count - 1 - len))) & 0x0F];
+     }
+     buffer[len] = '\0';
+ 
+     return len;
+ }
+ 
+ #ifdef API_FORMAT_BENCHMARK
+ 
+ /**
+  * @brief Mide los ciclos de CPU de formatMmToCm() contra el sprintf equivalente.
+  *
+  * Convierte los mismos valores con ambos métodos y acumula los ciclos del DWT.
+  * Pensado para inspeccionar el resultado desde el depurador.
+  *
+  * @param result Resultado de la medición.
+  * @param iterations Cantidad de conversiones con cada método.
+  */
+ void formatBenchmark(formatBenchmark_t* result, uint32_t iterations){
+ 
+     char buffer[16];
+     uint32_t start;
+ 
+     if (result == NULL) return;
+ 
+     cyclesInit();
+     result->iterations = iterations;
+ 
+     start = cyclesNow();
+     for (uint32_t i = 0; i < iterations; i++) {
+         uint16_t mm = (uint16_t)(i % 2000);
+         sprintf(buffer, "%2d.%d", mm / 10, mm % 10);
+     }
+     result->sprintfCycles = cyclesNow() - start;
+ 
+     start = cyclesNow();
+     for (uint32_t i = 0; i < iterations; i++) {
+         formatMmToCm(buffer, sizeof(buffer), (uint16_t)(i % 2000));
+     }
+     result->formatCycles = cyclesNow() - start;
+ }
+ 
+ #endif /* API_FORMAT_BENCHMARK */
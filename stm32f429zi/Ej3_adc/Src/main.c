@@ -15,12 +15,12 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
-#include <string.h>
+#include "API_format.h"
 
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private define ------------------------------------------------------------*/
-#define INTERNAL_TEMPSENSOR_AVGSLOPE   ((float)    2.5)	       /* Internal temperature sensor, parameter Avg_Slope (unit: mV/DegCelsius). Refer to device datasheet for min/typ/max values. */
+#define INTERNAL_TEMPSENSOR_AVGSLOPE   ((int32_t)   25)        /* Internal temperature sensor, parameter Avg_Slope (unit: 0.1 mV/DegCelsius). Refer to device datasheet for min/typ/max values. */
 #define INTERNAL_TEMPSENSOR_V25        ((int32_t)  760)        /* Internal temperature sensor, parameter V25 (unit: mV). Refer to device datasheet for min/typ/max values. */
 #define INTERNAL_TEMPSENSOR_V25_TEMP   ((int32_t)   25)
 #define INTERNAL_TEMPSENSOR_V25_VREF   ((int32_t) 3300)
@@ -85,20 +85,27 @@ int main(void) {
 	while (1) {
 		char msg[50];
 		uint16_t rawValue;
-		float temp;
+		int32_t voltage;
+		int32_t temp;
+		size_t len;
 
 		HAL_ADC_PollForConversion(&adcHandler, HAL_MAX_DELAY);
 
+		// Tension en decenas de uV y temperatura en centesimas de grado, sin punto flotante
 		rawValue = HAL_ADC_GetValue(&adcHandler);
-		temp = ((float) rawValue) / 4095 * INTERNAL_TEMPSENSOR_V25_VREF;
-		temp = ((temp - INTERNAL_TEMPSENSOR_V25) / INTERNAL_TEMPSENSOR_AVGSLOPE) + INTERNAL_TEMPSENSOR_V25_TEMP;
+		voltage = ((int32_t) rawValue * INTERNAL_TEMPSENSOR_V25_VREF * 100) / 4095;
+		temp = ((voltage - INTERNAL_TEMPSENSOR_V25 * 100) * 10 / INTERNAL_TEMPSENSOR_AVGSLOPE) + INTERNAL_TEMPSENSOR_V25_TEMP * 100;
 
-		sprintf(msg, "rawValue: %hu\r\n", rawValue);
-		HAL_UART_Transmit(&uartHandle, (uint8_t*) msg, strlen(msg), HAL_MAX_DELAY);
+		len = formatString(msg, sizeof(msg), "rawValue: ");
+		len += formatUint(&msg[len], sizeof(msg) - len, rawValue);
+		len += formatString(&msg[len], sizeof(msg) - len, "\r\n");
+		HAL_UART_Transmit(&uartHandle, (uint8_t*) msg, len, HAL_MAX_DELAY);
 
 		// Limitar la precisión a 2 decimales
-		sprintf(msg, "Temperature (C): %.2f\r\n", temp);
-		HAL_UART_Transmit(&uartHandle, (uint8_t*) msg, strlen(msg), HAL_MAX_DELAY);
+		len = formatString(msg, sizeof(msg), "Temperature (C): ");
+		len += formatFixed(&msg[len], sizeof(msg) - len, temp, 2);
+		len += formatString(&msg[len], sizeof(msg) - len, "\r\n");
+		HAL_UART_Transmit(&uartHandle, (uint8_t*) msg, len, HAL_MAX_DELAY);
 
 		BSP_LED_Toggle(LED3);
 		HAL_Delay(100);